@@ -19,6 +19,7 @@
 #include "applaunchhelper.h"
 
 #include "antimicrosettings.h"
+#include "eventhandlerfactory.h"
 #include "globalvariables.h"
 #include "inputdevice.h"
 #include "joybuttontypes/joybutton.h"
@@ -47,6 +48,7 @@ void AppLaunchHelper::initRunMethods()
         changeMouseRefreshRate();
         changeSpringModeScreen();
         changeGamepadPollRate();
+        changeHiResScroll();
 #ifdef Q_OS_WIN
         checkPointerPrecision();
 #endif
@@ -103,6 +105,20 @@ void AppLaunchHelper::changeGamepadPollRate()
     }
 }
 
+void AppLaunchHelper::changeHiResScroll()
+{
+    bool hiResScroll = settings->value("Mouse/HiResScroll", false).toBool();
+
+    if (hiResScroll && !EventHandlerFactory::getInstance()->handler()->supportsHiResScroll())
+    {
+        qWarning() << "High resolution scrolling is not supported by"
+                   << EventHandlerFactory::getInstance()->handler()->getName() << "event generator";
+        hiResScroll = false;
+    }
+
+    JoyButton::setHiResScroll(hiResScroll, GlobalVariables::JoyButton::hiResScroll);
+}
+
 void AppLaunchHelper::printControllerList(QMap<SDL_JoystickID, InputDevice *> *joysticks)
 {
     PRINT_STDOUT() << QObject::tr("# of joysticks found: %1").arg(joysticks->size()) << "\n"
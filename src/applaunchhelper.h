@@ -44,6 +44,7 @@ class AppLaunchHelper : public QObject
     void changeMouseRefreshRate();
     void changeSpringModeScreen();
     void changeGamepadPollRate();
+    void changeHiResScroll();
 #ifdef Q_OS_WIN
     void checkPointerPrecision();
 #endif
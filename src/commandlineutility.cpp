@@ -41,6 +41,13 @@ CommandLineUtility::CommandLineUtility(QObject *parent)
     unloadProfile = false;
     startSetNumber = 0;
     listControllers = false;
+    perControllerOutput = false;
+    virtualGamepad = false;
+    keepAxisPeaks = false;
+    adaptivePolling = false;
+    startupTrace = false;
+    headless = false;
+    replaySpeed = 1.0;
     currentLogLevel = Logger::LOG_NONE;
 
     currentListsIndex = 0;
@@ -50,7 +57,7 @@ CommandLineUtility::CommandLineUtility(QObject *parent)
     eventGenerator = EventHandlerFactory::fallBackIdentifier();
 }
 
-void CommandLineUtility::parseArguments(const QApplication &parsed_app)
+void CommandLineUtility::parseArguments(const QCoreApplication &parsed_app)
 {
     QCommandLineParser parser;
     parser.setApplicationDescription(
@@ -93,7 +100,8 @@ void CommandLineUtility::parseArguments(const QApplication &parsed_app)
          QCoreApplication::translate("main", "Choose between using XTest support and uinput support "
                                              "for event generation. Use only if you have "
                                              "enabled xtest and uinput options on Linux or vmulti on "
-                                             "Windows. Default: xtest."),
+                                             "Windows. Use record to record generated events instead of "
+                                             "sending them. Default: xtest."),
          QCoreApplication::translate("main", "event-generation-type"), "xtest"}, // default
         {{"list", "l"},
          QCoreApplication::translate("main", "Print information about joysticks detected by SDL. Use "
@@ -102,6 +110,40 @@ void CommandLineUtility::parseArguments(const QApplication &parsed_app)
                                              "even GUID.")},
         {"next", QCoreApplication::translate("main", "Load multiple profiles for different controllers. This option is "
                                                      "meant to be used with profile-controller and profile options.")},
+        {"per-controller-output",
+         QCoreApplication::translate("main", "Create separate virtual keyboard and mouse devices for every controller. "
+                                             "Supported only by uinput event generator.")},
+        {"virtual-gamepad",
+         QCoreApplication::translate("main", "Create virtual gamepad for every game controller. Buttons and axes "
+                                             "without assigned slots are passed through to it. The physical "
+                                             "controller stays visible, so games see both of them. "
+                                             "Supported only by uinput event generator.")},
+        {"keep-axis-peaks",
+         QCoreApplication::translate("main", "When several events of one axis arrive in one poll, process its lowest and "
+                                             "highest value besides the latest one, so short movements still cross "
+                                             "thresholds.")},
+        {"adaptive-polling",
+         QCoreApplication::translate("main", "Poll controllers less often while all of them are idle and return to "
+                                             "the configured poll rate when input arrives.")},
+        {"startup-trace",
+         QCoreApplication::translate("main", "Print duration of startup phases, measured from program start.")},
+        {"headless",
+         QCoreApplication::translate("main", "Run as a service without any window or tray icon. Profiles are taken from "
+                                             "settings and command line, other instances can change them.")},
+        {"record-input", QCoreApplication::translate("main", "Record input events of all controllers into a trace file."),
+         QCoreApplication::translate("main", "filename")},
+        {"replay-input",
+         QCoreApplication::translate("main", "Replay input events recorded with --record-input through connected "
+                                             "controllers of the same layout or through virtual ones."),
+         QCoreApplication::translate("main", "filename")},
+        {"replay-speed",
+         QCoreApplication::translate("main", "Speed factor used by --replay-input. 0 replays without delays. "
+                                             "Default: 1."),
+         QCoreApplication::translate("main", "factor")},
+        {"record-output",
+         QCoreApplication::translate("main", "Write events generated by the record event generator into a text file "
+                                             "instead of keeping them in memory."),
+         QCoreApplication::translate("main", "filename")},
 
     });
 
@@ -167,7 +209,68 @@ void CommandLineUtility::parseArguments(const QApplication &parsed_app)
             listControllers = true;
         }
 
-#if (defined(WITH_UINPUT) && defined(WITH_XTEST))
+        if (parser.isSet("per-controller-output"))
+        {
+            perControllerOutput = true;
+        }
+
+        if (parser.isSet("virtual-gamepad"))
+        {
+            virtualGamepad = true;
+        }
+
+        if (parser.isSet("keep-axis-peaks"))
+        {
+            keepAxisPeaks = true;
+        }
+
+        if (parser.isSet("adaptive-polling"))
+        {
+            adaptivePolling = true;
+        }
+
+        if (parser.isSet("startup-trace"))
+        {
+            startupTrace = true;
+        }
+
+        if (parser.isSet("headless"))
+        {
+            headless = true;
+        }
+
+        if (parser.isSet("record-input"))
+        {
+            if (!parser.value("record-input").isEmpty())
+                inputRecordFile = parser.value("record-input");
+            else
+                throw std::runtime_error(QObject::tr("No input trace file specified.").toStdString());
+        }
+
+        if (parser.isSet("replay-input"))
+        {
+            if (!parser.value("replay-input").isEmpty())
+                inputReplayFile = parser.value("replay-input");
+            else
+                throw std::runtime_error(QObject::tr("No input trace file specified.").toStdString());
+        }
+
+        if (parser.isSet("replay-speed"))
+        {
+            bool validNumber = false;
+            replaySpeed = parser.value("replay-speed").toDouble(&validNumber);
+
+            if (!validNumber || (replaySpeed < 0.0))
+                throw std::runtime_error(QObject::tr("Replay speed is not a valid value.").toStdString());
+        }
+
+        if (parser.isSet("record-output"))
+        {
+            if (!parser.value("record-output").isEmpty())
+                outputRecordFile = parser.value("record-output");
+            else
+                throw std::runtime_error(QObject::tr("No output trace file specified.").toStdString());
+        }
 
         if (parser.isSet("eventgen"))
         {
@@ -185,7 +288,6 @@ void CommandLineUtility::parseArguments(const QApplication &parsed_app)
                 throw std::runtime_error(QObject::tr("No event generator string was specified.").toStdString());
             }
         }
-#endif
 
         if (parser.isSet("log-level"))
         {
@@ -395,14 +497,49 @@ int CommandLineUtility::getStartSetNumber() { return startSetNumber; }
 
 int CommandLineUtility::getJoyStartSetNumber() { return startSetNumber - 1; }
 
+double CommandLineUtility::getReplaySpeed() { return replaySpeed; }
+
 bool CommandLineUtility::shouldListControllers() { return listControllers; }
 
+bool CommandLineUtility::isPerControllerOutputRequested() { return perControllerOutput; }
+
+bool CommandLineUtility::isVirtualGamepadRequested() { return virtualGamepad; }
+
+bool CommandLineUtility::isKeepAxisPeaksRequested() { return keepAxisPeaks; }
+
+bool CommandLineUtility::isAdaptivePollingRequested() { return adaptivePolling; }
+
+bool CommandLineUtility::isStartupTraceRequested() { return startupTrace; }
+
+bool CommandLineUtility::isHeadlessRequested() { return headless; }
+
+/**
+ * @brief Check for --headless before application object is created, as it
+ *     decides which application class is used.
+ */
+bool CommandLineUtility::hasHeadlessArgument(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (qstrcmp(argv[i], "--headless") == 0)
+            return true;
+    }
+
+    return false;
+}
+
 QString CommandLineUtility::getEventGenerator() { return eventGenerator; }
 
 Logger::LogLevel CommandLineUtility::getCurrentLogLevel() { return currentLogLevel; }
 
 QString CommandLineUtility::getCurrentLogFile() { return currentLogFile; }
 
+QString CommandLineUtility::getInputRecordFile() { return inputRecordFile; }
+
+QString CommandLineUtility::getInputReplayFile() { return inputReplayFile; }
+
+QString CommandLineUtility::getOutputRecordFile() { return outputRecordFile; }
+
 QList<ControllerOptionsInfo> const &CommandLineUtility::getControllerOptionsList() { return controllerOptionsList; }
 
 bool CommandLineUtility::hasProfileInOptions()
@@ -91,7 +91,7 @@ class CommandLineUtility : public QObject
      * @param parsed_app
      * @exception std::runtime_error - in case of problems with parsing like unknown flag, wrong value etc
      */
-    void parseArguments(const QApplication &parsed_app);
+    void parseArguments(const QCoreApplication &parsed_app);
 
     bool isLaunchInTrayEnabled();
     bool isTrayHidden();
@@ -103,21 +103,33 @@ class CommandLineUtility : public QObject
     bool isUnloadRequested();
     bool shouldListControllers();
     bool hasProfileInOptions();
+    bool isPerControllerOutputRequested();
+    bool isVirtualGamepadRequested();
+    bool isKeepAxisPeaksRequested();
+    bool isAdaptivePollingRequested();
+    bool isStartupTraceRequested();
+    bool isHeadlessRequested();
 
     int getControllerNumber();
     int getStartSetNumber();
     int getJoyStartSetNumber();
+    double getReplaySpeed();
 
     QString getControllerID();
     QString getProfileLocation();
     QString getEventGenerator();
     QString getCurrentLogFile();
+    QString getInputRecordFile();
+    QString getInputReplayFile();
+    QString getOutputRecordFile();
 
     QList<int> *getJoyStartSetNumberList();
     QList<ControllerOptionsInfo> const &getControllerOptionsList();
 
     Logger::LogLevel getCurrentLogLevel();
 
+    static bool hasHeadlessArgument(int argc, char *argv[]);
+
   protected:
   private:
     bool launchInTray;
@@ -126,15 +138,25 @@ class CommandLineUtility : public QObject
     bool showRequest;
     bool unloadProfile;
     bool listControllers;
+    bool perControllerOutput;
+    bool virtualGamepad;
+    bool keepAxisPeaks;
+    bool adaptivePolling;
+    bool startupTrace;
+    bool headless;
 
     int startSetNumber;
     int controllerNumber;
     int currentListsIndex;
+    double replaySpeed;
 
     QString profileLocation;
     QString controllerIDString;
     QString eventGenerator;
     QString currentLogFile;
+    QString inputRecordFile;
+    QString inputReplayFile;
+    QString outputRecordFile;
 
     Logger::LogLevel currentLogLevel;
 
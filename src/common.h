@@ -126,6 +126,7 @@ const QString wikiPage = QString("%1/wiki").arg(githubProjectPage);
 const QString mouseDeviceName("antimicrox Mouse Emulation");
 const QString keyboardDeviceName("antimicrox Keyboard Emulation");
 const QString springMouseDeviceName("antimicrox Abs Mouse Emulation");
+const QString gamepadDeviceName("antimicrox Virtual Gamepad");
 
 const int ANTIMICROX_MAJOR_VERSION = PROJECT_MAJOR_VERSION;
 const int ANTIMICROX_MINOR_VERSION = PROJECT_MINOR_VERSION;
@@ -0,0 +1,86 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "elementcounters.h"
+
+thread_local int ElementCounters::Scope::depth = 0;
+
+ElementCounters::Values::Values()
+    : received(0)
+    , coalesced(0)
+    , output(0)
+    , processingNs(0)
+{
+}
+
+ElementCounters::Values &ElementCounters::Values::operator+=(const Values &other)
+{
+    received += other.received;
+    coalesced += other.coalesced;
+    output += other.output;
+    processingNs += other.processingNs;
+
+    return *this;
+}
+
+ElementCounters::Scope::Scope(ElementCounters &counters)
+    : m_counters(counters)
+    , m_outermost(depth == 0)
+{
+    depth++;
+
+    if (m_outermost)
+        m_start = std::chrono::steady_clock::now();
+}
+
+ElementCounters::Scope::~Scope()
+{
+    depth--;
+
+    if (m_outermost)
+    {
+        std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - m_start;
+        m_counters.addProcessingTime(elapsed.count());
+    }
+}
+
+ElementCounters::ElementCounters()
+    : received(0)
+    , coalesced(0)
+    , output(0)
+    , processingNs(0)
+{
+}
+
+ElementCounters::Values ElementCounters::values() const
+{
+    Values result;
+    result.received = received.load(std::memory_order_relaxed);
+    result.coalesced = coalesced.load(std::memory_order_relaxed);
+    result.output = output.load(std::memory_order_relaxed);
+    result.processingNs = processingNs.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+void ElementCounters::reset()
+{
+    received.store(0, std::memory_order_relaxed);
+    coalesced.store(0, std::memory_order_relaxed);
+    output.store(0, std::memory_order_relaxed);
+    processingNs.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,94 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ELEMENTCOUNTERS_H
+#define ELEMENTCOUNTERS_H
+
+#include <QString>
+
+#include <atomic>
+#include <chrono>
+
+/**
+ * @brief Always-on activity counters of one device or element: input
+ *     events received, events coalesced into a pending one, output events
+ *     produced and processing time. Every instance takes its own cache
+ *     line, so readers in other threads do not slow down updates of
+ *     neighbouring elements. Counters are updated with relaxed atomics, readers
+ *     get approximate but consistent enough values from any thread.
+ */
+class alignas(64) ElementCounters
+{
+  public:
+    struct Values
+    {
+        Values();
+        Values &operator+=(const Values &other);
+
+        quint64 received;
+        quint64 coalesced;
+        quint64 output;
+        quint64 processingNs;
+    };
+
+    /**
+     * @brief Adds time until destruction to processing time of counters.
+     *     Only the outermost scope of a thread measures, so time of nested
+     *     elements (e.g. buttons of a stick) is attributed to the element
+     *     which started the work and never counted twice.
+     */
+    class Scope
+    {
+      public:
+        explicit Scope(ElementCounters &counters);
+        ~Scope();
+
+      private:
+        ElementCounters &m_counters;
+        std::chrono::steady_clock::time_point m_start;
+        bool m_outermost;
+
+        static thread_local int depth;
+    };
+
+    ElementCounters();
+
+    inline void addReceived() { received.fetch_add(1, std::memory_order_relaxed); }
+    inline void addCoalesced() { coalesced.fetch_add(1, std::memory_order_relaxed); }
+    inline void addOutput() { output.fetch_add(1, std::memory_order_relaxed); }
+    inline void addProcessingTime(qint64 nsecs) { processingNs.fetch_add(nsecs, std::memory_order_relaxed); }
+
+    Values values() const;
+    void reset();
+
+  private:
+    std::atomic<quint64> received;
+    std::atomic<quint64> coalesced;
+    std::atomic<quint64> output;
+    std::atomic<quint64> processingNs;
+};
+
+/**
+ * @brief Counters of one element of a device summed over all sets.
+ */
+struct ElementCountersEntry
+{
+    QString element;
+    ElementCounters::Values values;
+};
+
+#endif // ELEMENTCOUNTERS_H
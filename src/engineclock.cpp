@@ -0,0 +1,235 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "engineclock.h"
+
+#include "enginetimer.h"
+
+#include <QElapsedTimer>
+#include <QMutexLocker>
+
+std::atomic<bool> EngineClock::virtualMode(false);
+std::atomic<qint64> EngineClock::virtualTime(0);
+QMutex EngineClock::mutex;
+QVector<EngineClock::VirtualTimer> EngineClock::virtualTimers;
+quint64 EngineClock::nextSequence = 0;
+
+static const QElapsedTimer &wallClock()
+{
+    static const QElapsedTimer timer = []() {
+        QElapsedTimer started;
+        started.start();
+        return started;
+    }();
+
+    return timer;
+}
+
+qint64 EngineClock::now()
+{
+    if (virtualMode.load(std::memory_order_acquire))
+        return virtualTime.load(std::memory_order_acquire);
+
+    return wallClock().elapsed();
+}
+
+bool EngineClock::isVirtual() { return virtualMode.load(std::memory_order_acquire); }
+
+/**
+ * @brief Switch between wall clock and virtual time. Virtual time starts
+ *     at the current wall clock time, so running measurements stay
+ *     consistent. Timers still pending in virtual time are stopped when
+ *     virtual mode is left.
+ */
+void EngineClock::setVirtual(bool enabled)
+{
+    QMutexLocker locker(&mutex);
+
+    if (enabled == virtualMode.load())
+        return;
+
+    if (enabled)
+        virtualTime.store(wallClock().elapsed());
+    else
+        virtualTimers.clear();
+
+    virtualMode.store(enabled, std::memory_order_release);
+}
+
+void EngineClock::advance(qint64 msecs) { advanceTo(now() + msecs); }
+
+/**
+ * @brief Move virtual time forward to time and fire timers due until
+ *     then, earliest first. Timers due at the same time fire in the order
+ *     they were started. Timer slots run in the calling thread, so this
+ *     has to be called from the thread that owns the engine objects.
+ */
+void EngineClock::advanceTo(qint64 time)
+{
+    if (!isVirtual())
+        return;
+
+    forever
+    {
+        EngineTimer *timer = nullptr;
+
+        {
+            QMutexLocker locker(&mutex);
+            int next = -1;
+
+            for (int i = 0; i < virtualTimers.size(); i++)
+            {
+                const VirtualTimer &entry = virtualTimers.at(i);
+
+                if ((entry.deadline <= time) &&
+                    ((next == -1) || (entry.deadline < virtualTimers.at(next).deadline) ||
+                     ((entry.deadline == virtualTimers.at(next).deadline) &&
+                      (entry.sequence < virtualTimers.at(next).sequence))))
+                {
+                    next = i;
+                }
+            }
+
+            if (next == -1)
+                break;
+
+            VirtualTimer &due = virtualTimers[next];
+            timer = due.timer;
+
+            if (due.deadline > virtualTime.load())
+                virtualTime.store(due.deadline, std::memory_order_release);
+
+            if (timer->isSingleShot())
+            {
+                virtualTimers.remove(next);
+            } else
+            {
+                // Zero interval would fire forever without time passing
+                due.deadline += qMax(1, timer->interval());
+                due.sequence = nextSequence++;
+            }
+        }
+
+        timer->fireVirtual();
+    }
+
+    if (time > virtualTime.load())
+        virtualTime.store(time, std::memory_order_release);
+}
+
+/**
+ * @brief Earliest deadline of pending virtual timers or -1 when none is
+ *     pending. Lets a driver jump straight to the next event.
+ */
+qint64 EngineClock::nextDeadline()
+{
+    QMutexLocker locker(&mutex);
+    qint64 result = -1;
+
+    for (const VirtualTimer &entry : virtualTimers)
+    {
+        if ((result == -1) || (entry.deadline < result))
+            result = entry.deadline;
+    }
+
+    return result;
+}
+
+void EngineClock::scheduleTimer(EngineTimer *timer, qint64 deadline)
+{
+    QMutexLocker locker(&mutex);
+
+    for (VirtualTimer &entry : virtualTimers)
+    {
+        if (entry.timer == timer)
+        {
+            entry.deadline = deadline;
+            entry.sequence = nextSequence++;
+            return;
+        }
+    }
+
+    virtualTimers.append({timer, deadline, nextSequence++});
+}
+
+bool EngineClock::cancelTimer(EngineTimer *timer)
+{
+    QMutexLocker locker(&mutex);
+
+    for (int i = 0; i < virtualTimers.size(); i++)
+    {
+        if (virtualTimers.at(i).timer == timer)
+        {
+            virtualTimers.remove(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool EngineClock::isScheduled(const EngineTimer *timer, qint64 *deadline)
+{
+    QMutexLocker locker(&mutex);
+
+    for (const VirtualTimer &entry : virtualTimers)
+    {
+        if (entry.timer == timer)
+        {
+            if (deadline != nullptr)
+                *deadline = entry.deadline;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+EngineElapsedTimer::EngineElapsedTimer()
+    : startTime(0)
+    , valid(false)
+{
+}
+
+void EngineElapsedTimer::start()
+{
+    startTime = EngineClock::now();
+    valid = true;
+}
+
+qint64 EngineElapsedTimer::restart()
+{
+    qint64 current = EngineClock::now();
+    qint64 result = current - startTime;
+    startTime = current;
+    valid = true;
+
+    return result;
+}
+
+qint64 EngineElapsedTimer::elapsed() const { return EngineClock::now() - startTime; }
+
+bool EngineElapsedTimer::hasExpired(qint64 timeout) const { return (timeout >= 0) && (elapsed() > timeout); }
+
+bool EngineElapsedTimer::isValid() const { return valid; }
+
+void EngineElapsedTimer::invalidate()
+{
+    startTime = 0;
+    valid = false;
+}
@@ -0,0 +1,87 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ENGINECLOCK_H
+#define ENGINECLOCK_H
+
+#include <QMutex>
+#include <QVector>
+
+#include <atomic>
+
+class EngineTimer;
+
+/**
+ * @brief Time source of the mapping engine in milliseconds. Follows a
+ *     monotonic wall clock by default. In virtual mode time stands still
+ *     until advance() or advanceTo() is called, which also fires every
+ *     EngineTimer that became due in deadline order. Used to run input
+ *     through the engine reproducibly and faster than real time.
+ */
+class EngineClock
+{
+  public:
+    static qint64 now();
+
+    static bool isVirtual();
+    static void setVirtual(bool enabled);
+    static void advance(qint64 msecs);
+    static void advanceTo(qint64 time);
+    static qint64 nextDeadline();
+
+  private:
+    friend class EngineTimer;
+
+    struct VirtualTimer
+    {
+        EngineTimer *timer;
+        qint64 deadline;
+        quint64 sequence;
+    };
+
+    static void scheduleTimer(EngineTimer *timer, qint64 deadline);
+    static bool cancelTimer(EngineTimer *timer);
+    static bool isScheduled(const EngineTimer *timer, qint64 *deadline = nullptr);
+
+    static std::atomic<bool> virtualMode;
+    static std::atomic<qint64> virtualTime;
+    static QMutex mutex;
+    static QVector<VirtualTimer> virtualTimers;
+    static quint64 nextSequence;
+};
+
+/**
+ * @brief Drop-in replacement of QElapsedTimer measuring EngineClock time.
+ */
+class EngineElapsedTimer
+{
+  public:
+    EngineElapsedTimer();
+
+    void start();
+    qint64 restart();
+    qint64 elapsed() const;
+    bool hasExpired(qint64 timeout) const;
+    bool isValid() const;
+    void invalidate();
+
+  private:
+    qint64 startTime;
+    bool valid;
+};
+
+#endif // ENGINECLOCK_H
@@ -0,0 +1,104 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "enginetimer.h"
+
+#include "engineclock.h"
+
+EngineTimer::EngineTimer(QObject *parent)
+    : QObject(parent)
+{
+    timer.setParent(this);
+    connect(&timer, &QTimer::timeout, this, &EngineTimer::timeout);
+}
+
+EngineTimer::~EngineTimer()
+{
+    // Virtual timers are dropped when virtual mode is left. Checking first
+    // also keeps static timers away from the clock during static destruction.
+    if (EngineClock::isVirtual())
+        EngineClock::cancelTimer(this);
+}
+
+/**
+ * @brief Virtual timers only exist while EngineClock is in virtual mode,
+ *     because leaving it drops them. Methods below check the atomic mode
+ *     flag first, so the clock mutex is not touched in real time mode.
+ */
+void EngineTimer::setInterval(int msec)
+{
+    timer.setInterval(msec);
+
+    if (EngineClock::isVirtual() && EngineClock::isScheduled(this))
+        EngineClock::scheduleTimer(this, EngineClock::now() + msec);
+}
+
+int EngineTimer::interval() const { return timer.interval(); }
+
+void EngineTimer::setSingleShot(bool singleShot) { timer.setSingleShot(singleShot); }
+
+bool EngineTimer::isSingleShot() const { return timer.isSingleShot(); }
+
+void EngineTimer::setTimerType(Qt::TimerType type) { timer.setTimerType(type); }
+
+Qt::TimerType EngineTimer::timerType() const { return timer.timerType(); }
+
+bool EngineTimer::isActive() const
+{
+    return timer.isActive() || (EngineClock::isVirtual() && EngineClock::isScheduled(this));
+}
+
+int EngineTimer::remainingTime() const
+{
+    qint64 deadline = 0;
+
+    if (EngineClock::isVirtual() && EngineClock::isScheduled(this, &deadline))
+        return static_cast<int>(qMax<qint64>(0, deadline - EngineClock::now()));
+
+    return timer.remainingTime();
+}
+
+void EngineTimer::start(int msec)
+{
+    timer.setInterval(msec);
+    start();
+}
+
+/**
+ * @brief (Re)start with current interval on the clock that is active now.
+ */
+void EngineTimer::start()
+{
+    if (EngineClock::isVirtual())
+    {
+        timer.stop();
+        EngineClock::scheduleTimer(this, EngineClock::now() + timer.interval());
+    } else
+    {
+        timer.start();
+    }
+}
+
+void EngineTimer::stop()
+{
+    timer.stop();
+
+    if (EngineClock::isVirtual())
+        EngineClock::cancelTimer(this);
+}
+
+void EngineTimer::fireVirtual() { emit timeout(); }
@@ -0,0 +1,63 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ENGINETIMER_H
+#define ENGINETIMER_H
+
+#include <QObject>
+#include <QTimer>
+
+/**
+ * @brief Timer with the interface of QTimer used by the mapping engine.
+ *     Runs on a QTimer normally. While EngineClock is in virtual mode it
+ *     is scheduled on the clock instead and fires from
+ *     EngineClock::advanceTo().
+ */
+class EngineTimer : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit EngineTimer(QObject *parent = nullptr);
+    ~EngineTimer();
+
+    void setInterval(int msec);
+    int interval() const;
+    void setSingleShot(bool singleShot);
+    bool isSingleShot() const;
+    void setTimerType(Qt::TimerType type);
+    Qt::TimerType timerType() const;
+    bool isActive() const;
+    int remainingTime() const;
+
+  signals:
+    void timeout();
+
+  public slots:
+    void start(int msec);
+    void start();
+    void stop();
+
+  private:
+    friend class EngineClock;
+
+    void fireVirtual();
+
+    QTimer timer;
+};
+
+#endif // ENGINETIMER_H
@@ -18,21 +18,22 @@
  */
 
 #include <QApplication>
-#include <QCursor>
 #include <QDebug>
 #include <QFileInfo>
 #include <QMessageBox>
 #include <QProcess>
-#include <QScreen>
 #include <QStringList>
 #include <QVariant>
 #include <cmath>
 
 #include "event.h"
 #include "eventhandlerfactory.h"
+#include "eventhandlers/outputsink.h"
 #include "globalvariables.h"
+#include "inputdevice.h"
 #include "joybuttontypes/joybutton.h"
 #include "logger.h"
+#include "setjoystick.h"
 
 #if defined(Q_OS_UNIX)
     #if defined(WITH_X11)
@@ -71,7 +72,7 @@ void fakeAbsMouseCoordinates(double springX, double springY, int width, int heig
     int destMidWidth = 0;
     int destMidHeight = 0;
 
-    QRect deskRect = QGuiApplication::screens().at(screen)->geometry();
+    QRect deskRect = PadderCommon::mouseHelperObj.getScreenGeometry(screen);
 
     screenWidth = deskRect.width();
     screenHeight = deskRect.height();
@@ -138,20 +139,38 @@ QString detectedScriptExt(QString file)
     return "";
 }
 
+/**
+ * @brief Find SDL instance ID of controller owning the slot, so output
+ *     can be routed to controller's own virtual devices. -1 when unknown.
+ */
+static int outputDeviceId(JoyButtonSlot *slot)
+{
+    JoyButton *button = qobject_cast<JoyButton *>(slot->parent());
+
+    if ((button != nullptr) && (button->getParentSet() != nullptr) &&
+        (button->getParentSet()->getInputDevice() != nullptr))
+    {
+        return button->getParentSet()->getInputDevice()->getSDLJoystickID();
+    }
+
+    return -1;
+}
+
 // Create the event used by the operating system.
 void sendevent(JoyButtonSlot *slot, bool pressed)
 {
     JoyButtonSlot::JoySlotInputAction device = slot->getSlotMode();
 
-    if (device == JoyButtonSlot::JoyKeyboard)
-    {
-        EventHandlerFactory::getInstance()->handler()->sendKeyboardEvent(slot, pressed);
-    } else if (device == JoyButtonSlot::JoyMouseButton)
-    {
-        EventHandlerFactory::getInstance()->handler()->sendMouseButtonEvent(slot, pressed);
-    } else if ((device == JoyButtonSlot::JoyTextEntry) && pressed && !slot->getTextData().isEmpty())
+    if (OutputSink::handlesSlotMode(device))
     {
-        EventHandlerFactory::getInstance()->handler()->sendTextEntryEvent(slot->getTextData());
+        JoyButton::countSlotOutput(slot);
+        bool perDeviceOutput = OutputSink::isPerDeviceOutput();
+        int deviceId = (perDeviceOutput || (device == JoyButtonSlot::JoyGamepadButton)) ? outputDeviceId(slot) : -1;
+
+        if (perDeviceOutput)
+            OutputSink::selectOutputDevice(deviceId);
+
+        OutputSink::sendSlotEvent(slot, pressed, deviceId);
     } else if ((device == JoyButtonSlot::JoyExecute) && pressed && !slot->getTextData().isEmpty())
     {
         QStringList argumentsTempList = {};
@@ -191,7 +210,25 @@ void sendevent(JoyButtonSlot *slot, bool pressed)
 }
 
 // Create the relative mouse event used by the operating system.
-void sendevent(int code1, int code2) { EventHandlerFactory::getInstance()->handler()->sendMouseEvent(code1, code2); }
+// Move the cursor. Output devices of controller deviceId are used
+// when output of every controller goes to its own devices.
+void sendevent(int code1, int code2, int deviceId)
+{
+    if (OutputSink::isPerDeviceOutput())
+        OutputSink::selectOutputDevice(deviceId);
+
+    OutputSink::sendMouseEvent(code1, code2);
+    PadderCommon::mouseHelperObj.moveCursorPos(code1, code2);
+}
+
+// Create the high resolution wheel event used by the operating system.
+void sendWheelEvent(int vertical, int horizontal, int deviceId)
+{
+    if (OutputSink::isPerDeviceOutput())
+        OutputSink::selectOutputDevice(deviceId);
+
+    OutputSink::sendMouseWheelEvent(vertical, horizontal);
+}
 
 // TODO: Re-implement spring event generation to simplify the process
 // and reduce overhead. Refactor old function to only be used when an absmouse
@@ -215,7 +252,7 @@ void sendSpringEventRefactor(PadderCommon::springModeInfo *fullSpring, PadderCom
         PadderCommon::mouseHelperObj.mouseTimer.stop();
         BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
 
-        if ((fullSpring->screen >= -1) && (fullSpring->screen >= QGuiApplication::screens().count()))
+        if ((fullSpring->screen >= -1) && (fullSpring->screen >= PadderCommon::mouseHelperObj.getScreenCount()))
         {
             fullSpring->screen = -1;
         }
@@ -280,6 +317,46 @@ void sendSpringEventRefactor(PadderCommon::springModeInfo *fullSpring, PadderCom
     }
 }
 
+/**
+ * @brief Move pointer to spring destination, either with an absolute event
+ *     or a relative one from current position. Tracked cursor position is
+ *     updated with the emitted move.
+ */
+static void sendSpringMove(int screen, int xmovecoor, int ymovecoor, int currentMouseX, int currentMouseY,
+                           const QRect &deskRect, int width, int height)
+{
+#if defined(Q_OS_UNIX)
+    BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+    if (screen <= -1)
+    {
+        if (handler->getIdentifier() == "xtest")
+        {
+            handler->sendMouseAbsEvent(xmovecoor, ymovecoor, -1);
+        } else if (handler->getIdentifier() == "uinput")
+        {
+            handler->sendMouseSpringEvent(xmovecoor, ymovecoor, width + deskRect.x(), height + deskRect.y());
+        }
+
+        PadderCommon::mouseHelperObj.setCursorPos(xmovecoor, ymovecoor);
+    } else
+    {
+        handler->sendMouseEvent(xmovecoor - currentMouseX, ymovecoor - currentMouseY);
+        PadderCommon::mouseHelperObj.moveCursorPos(xmovecoor - currentMouseX, ymovecoor - currentMouseY);
+    }
+
+#elif defined(Q_OS_WIN)
+    if (screen <= -1)
+    {
+        EventHandlerFactory::getInstance()->handler()->sendMouseSpringEvent(xmovecoor, ymovecoor, width + deskRect.x(),
+                                                                            height + deskRect.y());
+        PadderCommon::mouseHelperObj.setCursorPos(xmovecoor, ymovecoor);
+    } else
+    {
+        sendevent(xmovecoor - currentMouseX, ymovecoor - currentMouseY);
+    }
+#endif
+}
+
 // TODO: Change to only use this routine when using a relative mouse
 // pointer to fake absolute mouse moves. Otherwise, don't worry about
 // current position of the mouse and just send an absolute mouse pointer
@@ -310,29 +387,17 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::spr
         int currentMouseX = 0;
         int currentMouseY = 0;
 
-        if ((fullSpring->screen >= -1) && (fullSpring->screen >= QGuiApplication::screens().count()))
+        if ((fullSpring->screen >= -1) && (fullSpring->screen >= PadderCommon::mouseHelperObj.getScreenCount()))
         {
             fullSpring->screen = -1;
         }
 
-        QRect deskRect = fullSpring->screen == -1 ? QGuiApplication::primaryScreen()->geometry()
-                                                  : QGuiApplication::screens().at(fullSpring->screen)->geometry();
+        QRect deskRect = PadderCommon::mouseHelperObj.getScreenGeometry(fullSpring->screen);
 
         width = deskRect.width();
         height = deskRect.height();
 
-        QPoint currentPoint;
-        if (QApplication::platformName() == QStringLiteral("xcb"))
-        {
-#if defined(WITH_X11)
-            currentPoint = X11Extras::getInstance()->getPos();
-#else
-            qCritical() << "Platform name returned 'xcb', but X11 support is disabled";
-#endif
-        } else
-        {
-            currentPoint = QCursor::pos();
-        }
+        QPoint currentPoint = PadderCommon::mouseHelperObj.getCursorPos();
 
         currentMouseX = currentPoint.x();
         currentMouseY = currentPoint.y();
@@ -423,103 +488,23 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::spr
             // If either position is set to center, force update.
             if ((xmovecoor == (deskRect.x() + midwidth)) || (ymovecoor == (deskRect.y() + midheight)))
             {
-#if defined(Q_OS_UNIX)
-                BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
-                if (fullSpring->screen <= -1)
-                {
-                    if (handler->getIdentifier() == "xtest")
-                    {
-                        EventHandlerFactory::getInstance()->handler()->sendMouseAbsEvent(xmovecoor, ymovecoor, -1);
-                    } else if (handler->getIdentifier() == "uinput")
-                    {
-                        EventHandlerFactory::getInstance()->handler()->sendMouseSpringEvent(
-                            xmovecoor, ymovecoor, width + deskRect.x(), height + deskRect.y());
-                    }
-                } else
-                {
-                    EventHandlerFactory::getInstance()->handler()->sendMouseEvent(xmovecoor - currentMouseX,
-                                                                                  ymovecoor - currentMouseY);
-                }
-
-#elif defined(Q_OS_WIN)
-                if (fullSpring->screen <= -1)
-                {
-                    EventHandlerFactory::getInstance()->handler()->sendMouseSpringEvent(
-                        xmovecoor, ymovecoor, width + deskRect.x(), height + deskRect.y());
-                } else
-                {
-                    sendevent(xmovecoor - currentMouseX, ymovecoor - currentMouseY);
-                }
-#endif
-
+                sendSpringMove(fullSpring->screen, xmovecoor, ymovecoor, currentMouseX, currentMouseY, deskRect, width,
+                               height);
             } else if (!PadderCommon::mouseHelperObj.springMouseMoving && relativeSpring &&
                        ((relativeSpring->displacementX >= -1.0) || (relativeSpring->displacementY >= -1.0)) &&
                        ((diffx >= (destRelativeWidth * .013)) || (diffy >= (destRelativeHeight * .013))))
             {
                 PadderCommon::mouseHelperObj.springMouseMoving = true;
-#if defined(Q_OS_UNIX)
-                BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
-                if (fullSpring->screen <= -1)
-                {
-                    if (handler->getIdentifier() == "xtest")
-                    {
-                        EventHandlerFactory::getInstance()->handler()->sendMouseAbsEvent(xmovecoor, ymovecoor, -1);
-                    } else if (handler->getIdentifier() == "uinput")
-                    {
-                        EventHandlerFactory::getInstance()->handler()->sendMouseSpringEvent(
-                            xmovecoor, ymovecoor, width + deskRect.x(), height + deskRect.y());
-                    }
-                } else
-                {
-                    EventHandlerFactory::getInstance()->handler()->sendMouseEvent(xmovecoor - currentMouseX,
-                                                                                  ymovecoor - currentMouseY);
-                }
-
-#elif defined(Q_OS_WIN)
-                if (fullSpring->screen <= -1)
-                {
-                    EventHandlerFactory::getInstance()->handler()->sendMouseSpringEvent(
-                        xmovecoor, ymovecoor, width + deskRect.x(), height + deskRect.y());
-                } else
-                {
-                    sendevent(xmovecoor - currentMouseX, ymovecoor - currentMouseY);
-                }
-#endif
+                sendSpringMove(fullSpring->screen, xmovecoor, ymovecoor, currentMouseX, currentMouseY, deskRect, width,
+                               height);
                 PadderCommon::mouseHelperObj.mouseTimer.start(
                     qMax(GlobalVariables::JoyButton::mouseRefreshRate, GlobalVariables::JoyButton::gamepadRefreshRate) + 1);
             } else if (!PadderCommon::mouseHelperObj.springMouseMoving &&
                        ((diffx >= (destSpringWidth * .013)) || (diffy >= (destSpringHeight * .013))))
             {
                 PadderCommon::mouseHelperObj.springMouseMoving = true;
-#if defined(Q_OS_UNIX)
-
-                BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
-                if (fullSpring->screen <= -1)
-                {
-                    if (handler->getIdentifier() == "xtest")
-                    {
-                        EventHandlerFactory::getInstance()->handler()->sendMouseAbsEvent(xmovecoor, ymovecoor, -1);
-                    } else if (handler->getIdentifier() == "uinput")
-                    {
-                        EventHandlerFactory::getInstance()->handler()->sendMouseSpringEvent(
-                            xmovecoor, ymovecoor, width + deskRect.x(), height + deskRect.y());
-                    }
-                } else
-                {
-                    EventHandlerFactory::getInstance()->handler()->sendMouseEvent(xmovecoor - currentMouseX,
-                                                                                  ymovecoor - currentMouseY);
-                }
-
-#elif defined(Q_OS_WIN)
-                if (fullSpring->screen <= -1)
-                {
-                    EventHandlerFactory::getInstance()->handler()->sendMouseSpringEvent(
-                        xmovecoor, ymovecoor, width + deskRect.x(), height + deskRect.y());
-                } else
-                {
-                    sendevent(xmovecoor - currentMouseX, ymovecoor - currentMouseY);
-                }
-#endif
+                sendSpringMove(fullSpring->screen, xmovecoor, ymovecoor, currentMouseX, currentMouseY, deskRect, width,
+                               height);
 
                 PadderCommon::mouseHelperObj.mouseTimer.start(
                     qMax(GlobalVariables::JoyButton::mouseRefreshRate, GlobalVariables::JoyButton::gamepadRefreshRate) + 1);
@@ -532,34 +517,8 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::spr
 
             else if (PadderCommon::mouseHelperObj.springMouseMoving)
             {
-#if defined(Q_OS_UNIX)
-                BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
-                if (fullSpring->screen <= -1)
-                {
-                    if (handler->getIdentifier() == "xtest")
-                    {
-                        EventHandlerFactory::getInstance()->handler()->sendMouseAbsEvent(xmovecoor, ymovecoor, -1);
-                    } else if (handler->getIdentifier() == "uinput")
-                    {
-                        EventHandlerFactory::getInstance()->handler()->sendMouseSpringEvent(
-                            xmovecoor, ymovecoor, width + deskRect.x(), height + deskRect.y());
-                    }
-                } else
-                {
-                    EventHandlerFactory::getInstance()->handler()->sendMouseEvent(xmovecoor - currentMouseX,
-                                                                                  ymovecoor - currentMouseY);
-                }
-
-#elif defined(Q_OS_WIN)
-                if (fullSpring->screen <= -1)
-                {
-                    EventHandlerFactory::getInstance()->handler()->sendMouseSpringEvent(
-                        xmovecoor, ymovecoor, width + deskRect.x(), height + deskRect.y());
-                } else
-                {
-                    sendevent(xmovecoor - currentMouseX, ymovecoor - currentMouseY);
-                }
-#endif
+                sendSpringMove(fullSpring->screen, xmovecoor, ymovecoor, currentMouseX, currentMouseY, deskRect, width,
+                               height);
 
                 PadderCommon::mouseHelperObj.mouseTimer.start(
                     qMax(GlobalVariables::JoyButton::mouseRefreshRate, GlobalVariables::JoyButton::gamepadRefreshRate) + 1);
@@ -791,5 +750,25 @@ QString keysymToKeyString(int keysym, int alias)
 
 void sendKeybEvent(JoyButtonSlot *slot, bool pressed)
 {
-    EventHandlerFactory::getInstance()->handler()->sendKeyboardEvent(slot, pressed);
+    int deviceId = -1;
+
+    JoyButton::countSlotOutput(slot);
+
+    if (OutputSink::isPerDeviceOutput())
+    {
+        deviceId = outputDeviceId(slot);
+        OutputSink::selectOutputDevice(deviceId);
+    }
+
+    OutputSink::sendSlotEvent(slot, pressed, deviceId);
+}
+
+void sendKeyRepeatEvent(JoyButtonSlot *slot)
+{
+    JoyButton::countSlotOutput(slot);
+
+    if (OutputSink::isPerDeviceOutput())
+        OutputSink::selectOutputDevice(outputDeviceId(slot));
+
+    OutputSink::sendKeyboardRepeatEvent(slot);
 }
@@ -24,8 +24,10 @@
 #include "springmousemoveinfo.h"
 
 void sendevent(JoyButtonSlot *slot, bool pressed = true);
-void sendevent(int code1, int code2);
+void sendevent(int code1, int code2, int deviceId = -1);
+void sendWheelEvent(int vertical, int horizontal, int deviceId = -1);
 void sendKeybEvent(JoyButtonSlot *slot, bool pressed = true);
+void sendKeyRepeatEvent(JoyButtonSlot *slot);
 
 void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::springModeInfo *relativeSpring = 0,
                      int *const mousePosX = 0, int *const mousePos = 0);
@@ -20,6 +20,7 @@
 #include "logger.h"
 
 #include "eventhandlers/baseeventhandler.h"
+#include "eventhandlers/outputsink.h"
 
 #include <QDebug>
 #include <QHash>
@@ -36,6 +37,7 @@ static QHash<QString, QString> buildDisplayNames()
     temp.insert("xtest", "Xtest");
     temp.insert("uinput", "uinput");
 #endif
+    temp.insert("record", "Record");
     return temp;
 }
 
@@ -49,23 +51,40 @@ EventHandlerFactory::EventHandlerFactory(QString handler, QObject *parent)
 #ifdef WITH_UINPUT
 
     if (handler == "uinput")
-        eventHandler = new UInputEventHandler(this);
+    {
+        UInputEventHandler *uinputHandler = new UInputEventHandler(this);
+        OutputSink::bind(uinputHandler);
+        eventHandler = uinputHandler;
+    }
 
 #endif
 
 #ifdef WITH_XTEST
 
     if (handler == "xtest")
-        eventHandler = new XTestEventHandler(this);
+    {
+        XTestEventHandler *xtestHandler = new XTestEventHandler(this);
+        OutputSink::bind(xtestHandler);
+        eventHandler = xtestHandler;
+    }
 
 #endif
 
 #if defined(Q_OS_WIN)
     if (handler == "sendinput")
     {
-        eventHandler = new WinSendInputEventHandler(this);
+        WinSendInputEventHandler *sendInputHandler = new WinSendInputEventHandler(this);
+        OutputSink::bind(sendInputHandler);
+        eventHandler = sendInputHandler;
     }
 #endif
+
+    if (handler == "record")
+    {
+        RecordEventHandler *recordHandler = new RecordEventHandler(this);
+        OutputSink::bind(recordHandler);
+        eventHandler = recordHandler;
+    }
 }
 
 EventHandlerFactory *EventHandlerFactory::getInstance(QString handler)
@@ -87,6 +106,7 @@ void EventHandlerFactory::deleteInstance()
 {
     if (instance != nullptr)
     {
+        OutputSink::unbind();
         delete instance;
         instance = nullptr;
     }
@@ -141,9 +161,14 @@ QStringList EventHandlerFactory::buildEventGeneratorList()
 #ifdef Q_OS_WIN
     temp.append("sendinput");
 #else
+    #ifdef WITH_XTEST
     temp.append("xtest");
+    #endif
+    #ifdef WITH_UINPUT
     temp.append("uinput");
+    #endif
 #endif
+    temp.append("record");
     return temp;
 }
 
@@ -22,6 +22,8 @@
 #include <QObject>
 #include <QStringList>
 
+#include "eventhandlers/recordeventhandler.h"
+
 #ifdef WITH_UINPUT
     #include "eventhandlers/uinputeventhandler.h"
 #endif
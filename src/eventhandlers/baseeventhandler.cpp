@@ -22,9 +22,13 @@
 
 #include <QDebug>
 
+std::atomic<int> BaseEventHandler::resolveGeneration{0};
+
 BaseEventHandler::BaseEventHandler(QObject *parent)
     : QObject(parent)
 {
+    // Codes resolved by previously used handler are not valid anymore.
+    invalidateResolvedSlots();
 }
 
 BaseEventHandler::~BaseEventHandler() {}
@@ -66,3 +70,94 @@ void BaseEventHandler::sendMouseSpringEvent(int xDis, int yDis, int width, int h
 }
 
 void BaseEventHandler::sendTextEntryEvent(QString maintext) { Q_UNUSED(maintext); }
+
+/**
+ * @brief Do nothing by default. Backends supporting high resolution
+ *     scrolling should also override supportsHiResScroll.
+ * @param Vertical wheel movement in high resolution units
+ * @param Horizontal wheel movement in high resolution units
+ */
+void BaseEventHandler::sendMouseWheelEvent(int vertical, int horizontal)
+{
+    Q_UNUSED(vertical);
+    Q_UNUSED(horizontal);
+}
+
+bool BaseEventHandler::supportsHiResScroll() { return false; }
+
+/**
+ * @brief Press held key again by default.
+ */
+void BaseEventHandler::sendKeyboardRepeatEvent(JoyButtonSlot *slot) { sendKeyboardEvent(slot, true); }
+
+bool BaseEventHandler::emulatesKeyRepeat() const { return true; }
+
+/**
+ * @brief Use text of slot directly by default.
+ */
+void BaseEventHandler::sendTextEntrySlotEvent(JoyButtonSlot *slot) { sendTextEntryEvent(slot->getTextData()); }
+
+/**
+ * @brief Keyboard slots keep their code by default.
+ */
+void BaseEventHandler::resolveSlot(JoyButtonSlot *slot)
+{
+    slot->setResolvedCode(slot->getSlotCode(), getResolveGeneration());
+}
+
+int BaseEventHandler::getResolveGeneration() { return resolveGeneration.load(std::memory_order_relaxed); }
+
+void BaseEventHandler::invalidateResolvedSlots() { resolveGeneration.fetch_add(1, std::memory_order_relaxed); }
+
+/**
+ * @brief Per controller output devices are not supported by default.
+ */
+bool BaseEventHandler::setPerDeviceOutput(bool enabled) { return !enabled; }
+
+bool BaseEventHandler::isPerDeviceOutput() const { return false; }
+
+void BaseEventHandler::addOutputDevice(int deviceId, QString deviceName)
+{
+    Q_UNUSED(deviceId);
+    Q_UNUSED(deviceName);
+}
+
+void BaseEventHandler::removeOutputDevice(int deviceId) { Q_UNUSED(deviceId); }
+
+void BaseEventHandler::selectOutputDevice(int deviceId) { Q_UNUSED(deviceId); }
+
+/**
+ * @brief Do nothing by default. Events are written as soon as they are generated.
+ */
+void BaseEventHandler::beginOutputBatch() {}
+
+void BaseEventHandler::flushOutputBatch() {}
+
+/**
+ * @brief Virtual gamepads are not supported by default.
+ */
+bool BaseEventHandler::setVirtualGamepadOutput(bool enabled) { return !enabled; }
+
+bool BaseEventHandler::isVirtualGamepadOutput() const { return false; }
+
+void BaseEventHandler::addGamepadDevice(int deviceId, QString deviceName)
+{
+    Q_UNUSED(deviceId);
+    Q_UNUSED(deviceName);
+}
+
+void BaseEventHandler::removeGamepadDevice(int deviceId) { Q_UNUSED(deviceId); }
+
+void BaseEventHandler::sendGamepadButtonEvent(int deviceId, int button, bool pressed)
+{
+    Q_UNUSED(deviceId);
+    Q_UNUSED(button);
+    Q_UNUSED(pressed);
+}
+
+void BaseEventHandler::sendGamepadAxisEvent(int deviceId, int axis, int value)
+{
+    Q_UNUSED(deviceId);
+    Q_UNUSED(axis);
+    Q_UNUSED(value);
+}
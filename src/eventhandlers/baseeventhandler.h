@@ -21,6 +21,8 @@
 
 #include <QObject>
 
+#include <atomic>
+
 class JoyButtonSlot;
 
 /**
@@ -41,6 +43,15 @@ class BaseEventHandler : public QObject
     virtual bool cleanup() = 0;
 
     virtual void sendKeyboardEvent(JoyButtonSlot *slot, bool pressed) = 0;
+    /**
+     * @brief Repeat key of keyboard slot that is held down
+     */
+    virtual void sendKeyboardRepeatEvent(JoyButtonSlot *slot);
+    /**
+     * @brief Whether keys held down have to be repeated by antimicrox.
+     *     False when the host repeats keys of generated devices itself.
+     */
+    virtual bool emulatesKeyRepeat() const;
     virtual void sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed) = 0;
     /**
      * @brief Move cursor to selected relative location (deltax delaty)
@@ -53,7 +64,74 @@ class BaseEventHandler : public QObject
 
     virtual void sendMouseSpringEvent(int xDis, int yDis, int width, int height);
 
+    /**
+     * @brief Scroll by high resolution wheel units (120 units per wheel click)
+     */
+    virtual void sendMouseWheelEvent(int vertical, int horizontal);
+    virtual bool supportsHiResScroll();
+
     virtual void sendTextEntryEvent(QString maintext);
+    /**
+     * @brief Type text of text entry slot using event sequence stored
+     *     in slot by resolveSlot.
+     */
+    virtual void sendTextEntrySlotEvent(JoyButtonSlot *slot);
+
+    /**
+     * @brief Convert key code or text of slot to native key codes of backend
+     *     and store them in slot, so no key lookups are needed when slot
+     *     is activated.
+     */
+    virtual void resolveSlot(JoyButtonSlot *slot);
+    static int getResolveGeneration();
+    /**
+     * @brief Mark key codes stored in slots as outdated. Used after
+     *     keyboard layout change.
+     */
+    static void invalidateResolvedSlots();
+
+    /**
+     * @brief Enable creation of separate virtual output devices for every
+     *     physical controller. Returns false when backend does not support it.
+     */
+    virtual bool setPerDeviceOutput(bool enabled);
+    virtual bool isPerDeviceOutput() const;
+
+    virtual void addOutputDevice(int deviceId, QString deviceName);
+    virtual void removeOutputDevice(int deviceId);
+    /**
+     * @brief Select the output device used by subsequent events.
+     *     -1 selects shared output devices.
+     */
+    virtual void selectOutputDevice(int deviceId);
+
+    /**
+     * @brief Events generated between beginOutputBatch and flushOutputBatch
+     *     are collected per output device and written together.
+     */
+    virtual void beginOutputBatch();
+    virtual void flushOutputBatch();
+
+    /**
+     * @brief Enable creation of virtual gamepad for every game controller
+     *     added later with addGamepadDevice. Returns false when backend
+     *     does not support it.
+     */
+    virtual bool setVirtualGamepadOutput(bool enabled);
+    virtual bool isVirtualGamepadOutput() const;
+
+    virtual void addGamepadDevice(int deviceId, QString deviceName);
+    virtual void removeGamepadDevice(int deviceId);
+    /**
+     * @brief Press or release button of virtual gamepad. Button uses
+     *     SDL_GameControllerButton numbering.
+     */
+    virtual void sendGamepadButtonEvent(int deviceId, int button, bool pressed);
+    /**
+     * @brief Move axis of virtual gamepad. Axis uses SDL_GameControllerAxis
+     *     numbering, sticks use range -32767..32767 and triggers 0..32767.
+     */
+    virtual void sendGamepadAxisEvent(int deviceId, int axis, int value);
 
     virtual QString getName() = 0;
     virtual QString getIdentifier() = 0;
@@ -62,6 +140,11 @@ class BaseEventHandler : public QObject
 
   protected:
     QString lastErrorString;
+
+  private:
+    // Bumped in GUI thread on layout change, read by the input thread. Only
+    // the value matters, stale reads just resolve slots again.
+    static std::atomic<int> resolveGeneration;
 };
 
 #endif // BASEEVENTHANDLER_H
@@ -0,0 +1,176 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "outputsink.h"
+
+#include "recordeventhandler.h"
+
+#ifdef WITH_UINPUT
+    #include "uinputeventhandler.h"
+#endif
+
+#ifdef WITH_XTEST
+    #include "xtesteventhandler.h"
+#endif
+
+#ifdef Q_OS_WIN
+    #include "winsendinputeventhandler.h"
+#endif
+
+BaseEventHandler *OutputSink::m_handler = nullptr;
+OutputSink::Backend OutputSink::backend = OutputSink::NoBackend;
+bool OutputSink::perDeviceOutput = false;
+bool OutputSink::keyRepeatEmulated = false;
+
+void OutputSink::bind(RecordEventHandler *handler) { bindHandler(handler, RecordBackend); }
+
+#ifdef WITH_UINPUT
+void OutputSink::bind(UInputEventHandler *handler) { bindHandler(handler, UInputBackend); }
+#endif
+
+#ifdef WITH_XTEST
+void OutputSink::bind(XTestEventHandler *handler) { bindHandler(handler, XTestBackend); }
+#endif
+
+#ifdef Q_OS_WIN
+void OutputSink::bind(WinSendInputEventHandler *handler) { bindHandler(handler, SendInputBackend); }
+#endif
+
+void OutputSink::bindHandler(BaseEventHandler *handler, Backend type)
+{
+    m_handler = handler;
+    backend = type;
+    perDeviceOutput = handler->isPerDeviceOutput();
+    keyRepeatEmulated = handler->emulatesKeyRepeat();
+}
+
+/**
+ * @brief Detach event handler. Called before handler is deleted.
+ */
+void OutputSink::unbind()
+{
+    m_handler = nullptr;
+    backend = NoBackend;
+    perDeviceOutput = false;
+    keyRepeatEmulated = false;
+}
+
+/**
+ * @brief Call func with handler cast to its concrete type.
+ */
+template <typename Func> void OutputSink::dispatch(Func func)
+{
+    switch (backend)
+    {
+    case RecordBackend:
+        func(static_cast<RecordEventHandler *>(m_handler));
+        break;
+#ifdef WITH_UINPUT
+    case UInputBackend:
+        func(static_cast<UInputEventHandler *>(m_handler));
+        break;
+#endif
+#ifdef WITH_XTEST
+    case XTestBackend:
+        func(static_cast<XTestEventHandler *>(m_handler));
+        break;
+#endif
+#ifdef Q_OS_WIN
+    case SendInputBackend:
+        func(static_cast<WinSendInputEventHandler *>(m_handler));
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Check if slot mode is emitted through the sink. Other modes
+ *     (like JoyExecute) are not related to event handler.
+ */
+bool OutputSink::handlesSlotMode(JoyButtonSlot::JoySlotInputAction mode)
+{
+    if (m_handler == nullptr)
+        return false;
+
+    switch (mode)
+    {
+    case JoyButtonSlot::JoyKeyboard:
+    case JoyButtonSlot::JoyMouseButton:
+    case JoyButtonSlot::JoyTextEntry:
+    case JoyButtonSlot::JoyGamepadButton:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool OutputSink::setPerDeviceOutput(bool enabled)
+{
+    if (m_handler == nullptr)
+        return false;
+
+    bool result = m_handler->setPerDeviceOutput(enabled);
+    perDeviceOutput = m_handler->isPerDeviceOutput();
+
+    return result;
+}
+
+void OutputSink::selectOutputDevice(int deviceId)
+{
+    dispatch([deviceId](auto *handler) { handler->selectOutputDevice(deviceId); });
+}
+
+void OutputSink::sendSlotEvent(JoyButtonSlot *slot, bool pressed, int deviceId)
+{
+    dispatch([slot, pressed, deviceId](auto *handler) {
+        switch (slot->getSlotMode())
+        {
+        case JoyButtonSlot::JoyKeyboard:
+            handler->sendKeyboardEvent(slot, pressed);
+            break;
+        case JoyButtonSlot::JoyMouseButton:
+            handler->sendMouseButtonEvent(slot, pressed);
+            break;
+        case JoyButtonSlot::JoyTextEntry:
+            if (pressed && !slot->getTextData().isEmpty())
+                handler->sendTextEntrySlotEvent(slot);
+            break;
+        case JoyButtonSlot::JoyGamepadButton:
+            handler->sendGamepadButtonEvent(deviceId, slot->getSlotCode(), pressed);
+            break;
+        default:
+            break;
+        }
+    });
+}
+
+void OutputSink::sendKeyboardRepeatEvent(JoyButtonSlot *slot)
+{
+    dispatch([slot](auto *handler) { handler->sendKeyboardRepeatEvent(slot); });
+}
+
+void OutputSink::sendMouseEvent(int xDis, int yDis)
+{
+    dispatch([xDis, yDis](auto *handler) { handler->sendMouseEvent(xDis, yDis); });
+}
+
+void OutputSink::sendMouseWheelEvent(int vertical, int horizontal)
+{
+    dispatch([vertical, horizontal](auto *handler) { handler->sendMouseWheelEvent(vertical, horizontal); });
+}
@@ -0,0 +1,85 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OUTPUTSINK_H
+#define OUTPUTSINK_H
+
+#include "baseeventhandler.h"
+#include "joybuttonslot.h"
+
+class RecordEventHandler;
+class UInputEventHandler;
+class XTestEventHandler;
+class WinSendInputEventHandler;
+
+/**
+ * @brief Output path used by event.cpp. The event handler chosen at startup
+ *     is bound once together with its concrete type. Backend classes are
+ *     final, so switching over the bound type calls their methods directly
+ *     instead of through the virtual table. Per device output state is
+ *     cached here, so events do not have to query the handler.
+ */
+class OutputSink
+{
+  public:
+    static void bind(RecordEventHandler *handler);
+#ifdef WITH_UINPUT
+    static void bind(UInputEventHandler *handler);
+#endif
+#ifdef WITH_XTEST
+    static void bind(XTestEventHandler *handler);
+#endif
+#ifdef Q_OS_WIN
+    static void bind(WinSendInputEventHandler *handler);
+#endif
+    static void unbind();
+
+    static BaseEventHandler *handler() { return m_handler; }
+
+    static bool handlesSlotMode(JoyButtonSlot::JoySlotInputAction mode);
+
+    static bool emulatesKeyRepeat() { return keyRepeatEmulated; }
+
+    static bool setPerDeviceOutput(bool enabled);
+    static bool isPerDeviceOutput() { return perDeviceOutput; }
+    static void selectOutputDevice(int deviceId);
+
+    static void sendSlotEvent(JoyButtonSlot *slot, bool pressed, int deviceId);
+    static void sendKeyboardRepeatEvent(JoyButtonSlot *slot);
+    static void sendMouseEvent(int xDis, int yDis);
+    static void sendMouseWheelEvent(int vertical, int horizontal);
+
+  private:
+    enum Backend
+    {
+        NoBackend,
+        RecordBackend,
+        UInputBackend,
+        XTestBackend,
+        SendInputBackend
+    };
+
+    static void bindHandler(BaseEventHandler *handler, Backend type);
+    template <typename Func> static void dispatch(Func func);
+
+    static BaseEventHandler *m_handler;
+    static Backend backend;
+    static bool perDeviceOutput;
+    static bool keyRepeatEmulated;
+};
+
+#endif // OUTPUTSINK_H
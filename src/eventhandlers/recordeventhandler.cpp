@@ -0,0 +1,299 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "recordeventhandler.h"
+
+#include "engineclock.h"
+#include "joybuttonslot.h"
+#include "logger.h"
+
+#include <QDebug>
+#include <QMutexLocker>
+
+QString RecordEventHandler::outputFileName = QString();
+
+RecordEventHandler::RecordEventHandler(QObject *parent)
+    : BaseEventHandler(parent)
+    , recordedCount(0)
+    , droppedCount(0)
+    , currentDevice(-1)
+    , perDeviceOutput(false)
+    , virtualGamepadOutput(false)
+{
+}
+
+RecordEventHandler::~RecordEventHandler() { cleanup(); }
+
+/**
+ * @brief Set file receiving recorded events of handlers initialized
+ *     afterwards. Events are kept in memory when no file is set.
+ */
+void RecordEventHandler::setOutputFileName(const QString &fileName) { outputFileName = fileName; }
+
+bool RecordEventHandler::init()
+{
+    QMutexLocker locker(&mutex);
+
+    if (outputFileName.isEmpty() || outputFile.isOpen())
+        return true;
+
+    outputFile.setFileName(outputFileName);
+
+    if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        lastErrorString = tr("Could not open output trace file %1: %2").arg(outputFileName, outputFile.errorString());
+        qWarning() << lastErrorString;
+        return false;
+    }
+
+    return true;
+}
+
+bool RecordEventHandler::cleanup()
+{
+    QMutexLocker locker(&mutex);
+
+    if (outputFile.isOpen())
+    {
+        outputFile.close();
+        qInfo() << QString("Recorded %1 output events into %2").arg(recordedCount).arg(outputFileName);
+    }
+
+    if (droppedCount > 0)
+    {
+        qWarning() << QString("Output event buffer was full, %1 events were not recorded").arg(droppedCount);
+        droppedCount = 0;
+    }
+
+    return true;
+}
+
+void RecordEventHandler::sendKeyboardEvent(JoyButtonSlot *slot, bool pressed)
+{
+    record(currentDevice, KeyEvent, slot->getSlotCode(), slot->getSlotCodeAlias(), pressed ? 1 : 0);
+}
+
+void RecordEventHandler::sendKeyboardRepeatEvent(JoyButtonSlot *slot)
+{
+    record(currentDevice, KeyRepeatEvent, slot->getSlotCode(), slot->getSlotCodeAlias());
+}
+
+void RecordEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
+{
+    record(currentDevice, MouseButtonEvent, slot->getSlotCode(), pressed ? 1 : 0);
+}
+
+void RecordEventHandler::sendMouseEvent(int xDis, int yDis) { record(currentDevice, MouseMoveEvent, xDis, yDis); }
+
+void RecordEventHandler::sendMouseAbsEvent(int xDis, int yDis, int screen)
+{
+    record(currentDevice, MouseAbsEvent, xDis, yDis, screen);
+}
+
+void RecordEventHandler::sendMouseSpringEvent(int xDis, int yDis, int width, int height)
+{
+    record(currentDevice, MouseSpringEvent, xDis, yDis, width, height);
+}
+
+void RecordEventHandler::sendMouseWheelEvent(int vertical, int horizontal)
+{
+    record(currentDevice, MouseWheelEvent, vertical, horizontal);
+}
+
+bool RecordEventHandler::supportsHiResScroll() { return true; }
+
+void RecordEventHandler::sendTextEntryEvent(QString maintext)
+{
+    record(currentDevice, TextEvent, 0, 0, 0, 0, maintext);
+}
+
+/**
+ * @brief Output device is only recorded as number of the controller,
+ *     so separate output can always be enabled.
+ */
+bool RecordEventHandler::setPerDeviceOutput(bool enabled)
+{
+    perDeviceOutput = enabled;
+
+    if (!enabled)
+        currentDevice = -1;
+
+    return true;
+}
+
+bool RecordEventHandler::isPerDeviceOutput() const { return perDeviceOutput; }
+
+void RecordEventHandler::selectOutputDevice(int deviceId)
+{
+    if (perDeviceOutput)
+        currentDevice = deviceId;
+}
+
+bool RecordEventHandler::setVirtualGamepadOutput(bool enabled)
+{
+    virtualGamepadOutput = enabled;
+    return true;
+}
+
+bool RecordEventHandler::isVirtualGamepadOutput() const { return virtualGamepadOutput; }
+
+void RecordEventHandler::sendGamepadButtonEvent(int deviceId, int button, bool pressed)
+{
+    record(deviceId, GamepadButtonEvent, button, pressed ? 1 : 0);
+}
+
+void RecordEventHandler::sendGamepadAxisEvent(int deviceId, int axis, int value)
+{
+    record(deviceId, GamepadAxisEvent, axis, value);
+}
+
+QString RecordEventHandler::getName() { return QString("Record"); }
+
+/**
+ * @brief Identifier of the native backend whose key codes are recorded.
+ */
+QString RecordEventHandler::getIdentifier()
+{
+#if defined(Q_OS_WIN)
+    return QString("sendinput");
+#elif defined(WITH_UINPUT)
+    return QString("uinput");
+#else
+    return QString("xtest");
+#endif
+}
+
+void RecordEventHandler::printPostMessages()
+{
+    if (!lastErrorString.isEmpty())
+        qWarning() << lastErrorString;
+    else if (outputFileName.isEmpty())
+        qInfo() << QString("Output events are recorded in memory only");
+    else
+        qInfo() << QString("Output events are recorded into %1").arg(outputFileName);
+}
+
+/**
+ * @brief Remove events buffered in memory and return them.
+ */
+QVector<RecordEventHandler::RecordedEvent> RecordEventHandler::takeEvents()
+{
+    QMutexLocker locker(&mutex);
+    QVector<RecordedEvent> result;
+    result.swap(events);
+
+    return result;
+}
+
+quint64 RecordEventHandler::getRecordedCount()
+{
+    QMutexLocker locker(&mutex);
+    return recordedCount;
+}
+
+quint64 RecordEventHandler::getDroppedCount()
+{
+    QMutexLocker locker(&mutex);
+    return droppedCount;
+}
+
+/**
+ * @brief One line per event: time in ms, output device, event name and
+ *     its values. Key events carry native code, Qt key alias in hex and
+ *     press state.
+ */
+QString RecordEventHandler::formatEvent(const RecordedEvent &event)
+{
+    QString line = QString("%1 %2 ").arg(event.time).arg(event.deviceId);
+
+    switch (event.kind)
+    {
+    case KeyEvent:
+        line.append(QString("key %1 0x%2 %3").arg(event.values[0]).arg(event.values[1], 0, 16).arg(event.values[2]));
+        break;
+    case KeyRepeatEvent:
+        line.append(QString("keyrepeat %1 0x%2").arg(event.values[0]).arg(event.values[1], 0, 16));
+        break;
+    case MouseButtonEvent:
+        line.append(QString("mousebutton %1 %2").arg(event.values[0]).arg(event.values[1]));
+        break;
+    case MouseMoveEvent:
+        line.append(QString("move %1 %2").arg(event.values[0]).arg(event.values[1]));
+        break;
+    case MouseAbsEvent:
+        line.append(QString("abs %1 %2 %3").arg(event.values[0]).arg(event.values[1]).arg(event.values[2]));
+        break;
+    case MouseSpringEvent:
+        line.append(QString("spring %1 %2 %3 %4")
+                        .arg(event.values[0])
+                        .arg(event.values[1])
+                        .arg(event.values[2])
+                        .arg(event.values[3]));
+        break;
+    case MouseWheelEvent:
+        line.append(QString("wheel %1 %2").arg(event.values[0]).arg(event.values[1]));
+        break;
+    case TextEvent: {
+        QString text = event.text;
+        text.replace('\\', "\\\\").replace('\n', "\\n").replace('\r', "\\r");
+        line.append(QString("text %1").arg(text));
+        break;
+    }
+    case GamepadButtonEvent:
+        line.append(QString("gamepadbutton %1 %2").arg(event.values[0]).arg(event.values[1]));
+        break;
+    case GamepadAxisEvent:
+        line.append(QString("gamepadaxis %1 %2").arg(event.values[0]).arg(event.values[1]));
+        break;
+    }
+
+    return line;
+}
+
+/**
+ * @brief Events are recorded in input thread and taken from other
+ *     threads, so buffer and file are guarded by mutex.
+ */
+void RecordEventHandler::record(int deviceId, EventKind kind, int first, int second, int third, int fourth,
+                                const QString &text)
+{
+    RecordedEvent event;
+    event.time = EngineClock::now();
+    event.deviceId = deviceId;
+    event.kind = kind;
+    event.values[0] = first;
+    event.values[1] = second;
+    event.values[2] = third;
+    event.values[3] = fourth;
+    event.text = text;
+
+    QMutexLocker locker(&mutex);
+
+    if (outputFile.isOpen())
+    {
+        outputFile.write(formatEvent(event).append('\n').toUtf8());
+    } else if (events.size() < MAX_BUFFERED_EVENTS)
+    {
+        events.append(event);
+    } else
+    {
+        droppedCount++;
+        return;
+    }
+
+    recordedCount++;
+}
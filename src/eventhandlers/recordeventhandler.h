@@ -0,0 +1,119 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RECORDEVENTHANDLER_H
+#define RECORDEVENTHANDLER_H
+
+#include "baseeventhandler.h"
+
+#include <QFile>
+#include <QMutex>
+#include <QVector>
+
+/**
+ * @brief Event handler that records generated events with EngineClock
+ *     timestamps instead of sending them to the system. Events are written
+ *     to the file set with setOutputFileName or kept in memory until they
+ *     are taken with takeEvents. Used to benchmark the mapping engine and
+ *     to compare output of profiles without touching real devices.
+ *
+ * Key codes are recorded the way the native backend of the platform
+ * stores them, so identifier of that backend is reported and key mapping
+ * works unchanged.
+ */
+class RecordEventHandler final : public BaseEventHandler
+{
+    Q_OBJECT
+
+  public:
+    enum EventKind
+    {
+        KeyEvent,
+        KeyRepeatEvent,
+        MouseButtonEvent,
+        MouseMoveEvent,
+        MouseAbsEvent,
+        MouseSpringEvent,
+        MouseWheelEvent,
+        TextEvent,
+        GamepadButtonEvent,
+        GamepadAxisEvent
+    };
+
+    struct RecordedEvent
+    {
+        qint64 time;
+        int deviceId;
+        EventKind kind;
+        int values[4];
+        QString text;
+    };
+
+    static const int MAX_BUFFERED_EVENTS = 1000000;
+
+    explicit RecordEventHandler(QObject *parent = nullptr);
+    ~RecordEventHandler();
+
+    static void setOutputFileName(const QString &fileName);
+    static QString formatEvent(const RecordedEvent &event);
+
+    virtual bool init() override;
+    virtual bool cleanup() override;
+    virtual void sendKeyboardEvent(JoyButtonSlot *slot, bool pressed) override;
+    virtual void sendKeyboardRepeatEvent(JoyButtonSlot *slot) override;
+    virtual void sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed) override;
+    virtual void sendMouseEvent(int xDis, int yDis) override;
+    virtual void sendMouseAbsEvent(int xDis, int yDis, int screen) override;
+    virtual void sendMouseSpringEvent(int xDis, int yDis, int width, int height) override;
+    virtual void sendMouseWheelEvent(int vertical, int horizontal) override;
+    virtual bool supportsHiResScroll() override;
+    virtual void sendTextEntryEvent(QString maintext) override;
+
+    virtual bool setPerDeviceOutput(bool enabled) override;
+    virtual bool isPerDeviceOutput() const override;
+    virtual void selectOutputDevice(int deviceId) override;
+
+    virtual bool setVirtualGamepadOutput(bool enabled) override;
+    virtual bool isVirtualGamepadOutput() const override;
+    virtual void sendGamepadButtonEvent(int deviceId, int button, bool pressed) override;
+    virtual void sendGamepadAxisEvent(int deviceId, int axis, int value) override;
+
+    virtual QString getName() override;
+    virtual QString getIdentifier() override;
+    virtual void printPostMessages() override;
+
+    QVector<RecordedEvent> takeEvents();
+    quint64 getRecordedCount();
+    quint64 getDroppedCount();
+
+  private:
+    void record(int deviceId, EventKind kind, int first = 0, int second = 0, int third = 0, int fourth = 0,
+                const QString &text = QString());
+
+    static QString outputFileName;
+
+    QMutex mutex;
+    QFile outputFile;
+    QVector<RecordedEvent> events;
+    quint64 recordedCount;
+    quint64 droppedCount;
+    int currentDevice;
+    bool perDeviceOutput;
+    bool virtualGamepadOutput;
+};
+
+#endif // RECORDEVENTHANDLER_H
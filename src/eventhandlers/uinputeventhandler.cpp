@@ -28,14 +28,27 @@
 #include <QStringList>
 #include <QTimer>
 
+#include <SDL2/SDL_gamecontroller.h>
+
 #include <antkeymapper.h>
 #include <common.h>
+#include <globalvariables.h>
 #include <joybuttonslot.h>
 #include <logger.h>
 
 static const QString mouseDeviceName = PadderCommon::mouseDeviceName;
 static const QString keyboardDeviceName = PadderCommon::keyboardDeviceName;
 static const QString springMouseDeviceName = PadderCommon::springMouseDeviceName;
+static const QString gamepadDeviceName = PadderCommon::gamepadDeviceName;
+
+// Available since Linux 5.0
+#ifndef REL_WHEEL_HI_RES
+    #define REL_WHEEL_HI_RES 0x0b
+#endif
+
+#ifndef REL_HWHEEL_HI_RES
+    #define REL_HWHEEL_HI_RES 0x0c
+#endif
 
 #ifdef WITH_X11
     #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
@@ -49,13 +62,14 @@ static const QString springMouseDeviceName = PadderCommon::springMouseDeviceName
 
 UInputEventHandler::UInputEventHandler(QObject *parent)
     : BaseEventHandler(parent)
+    , currentOutput(&sharedOutput)
+    , perDeviceOutput(false)
+    , virtualGamepadOutput(false)
+    , batchActive(false)
 #if defined(Q_OS_UNIX)
     , is_problem_with_opening_uinput_present(false)
 #endif
 {
-    keyboardFileHandler = 0;
-    mouseFileHandler = 0;
-    springMouseFileHandler = 0;
 }
 
 UInputEventHandler::~UInputEventHandler() { cleanupUinputEvHand(); }
@@ -71,20 +85,20 @@ bool UInputEventHandler::init()
     bool result = true;
 
     // Open file handle for keyboard emulation.
-    initDevice(keyboardFileHandler, "keyboardFileHandler", result);
+    initDevice(sharedOutput.keyboard.filehandle, "keyboardFileHandler", result);
 
     // two separate statements for "result" are needed anyway because of possible changing its
     // statement in "initDevice" method
     if (result)
     {
         // Open mouse file handle to use for relative mouse emulation.
-        initDevice(mouseFileHandler, "mouseFileHandler", result);
+        initDevice(sharedOutput.mouse.filehandle, "mouseFileHandler", result);
     }
 
     if (result)
     {
         // Open mouse file handle to use for absolute mouse emulation.
-        initDevice(springMouseFileHandler, "springMouseFileHandler", result);
+        initDevice(springMouse.filehandle, "springMouseFileHandler", result);
     }
 
 #ifdef WITH_X11
@@ -130,12 +144,12 @@ void UInputEventHandler::initDevice(int &device, QString name, bool &result)
         } else if (name == "mouseFileHandler")
         {
             setRelMouseEvents(device);
-            createUInputMouseDevice(device);
+            createUInputMouseDevice(device, mouseDeviceName);
         } else if (name == "keyboardFileHandler")
         {
             setKeyboardEvents(device);
             populateKeyCodes(device);
-            createUInputKeyboardDevice(device);
+            createUInputKeyboardDevice(device, keyboardDeviceName);
         }
     } else
     {
@@ -157,27 +171,349 @@ bool UInputEventHandler::cleanup() { return cleanupUinputEvHand(); }
 
 bool UInputEventHandler::cleanupUinputEvHand()
 {
-    if (keyboardFileHandler > 0)
+    batchActive = false;
+    currentOutput = &sharedOutput;
+
+    for (auto iter = deviceOutputs.begin(); iter != deviceOutputs.end(); ++iter)
     {
-        closeUInputDevice(keyboardFileHandler);
-        keyboardFileHandler = 0;
+        closeOutputDevice(iter.value());
+        delete iter.value();
     }
 
-    if (mouseFileHandler > 0)
+    deviceOutputs.clear();
+    closeOutputDevice(&sharedOutput);
+
+    for (auto iter = gamepadOutputs.begin(); iter != gamepadOutputs.end(); ++iter)
     {
-        closeUInputDevice(mouseFileHandler);
-        mouseFileHandler = 0;
+        closeGamepadDevice(iter.value());
+        delete iter.value();
     }
 
-    if (springMouseFileHandler > 0)
+    gamepadOutputs.clear();
+
+    if (springMouse.filehandle > 0)
     {
-        closeUInputDevice(springMouseFileHandler);
-        springMouseFileHandler = 0;
+        closeUInputDevice(springMouse.filehandle);
+        springMouse.filehandle = 0;
     }
 
+    springMouse.pending.clear();
+
     return true;
 }
 
+void UInputEventHandler::closeOutputDevice(UInputOutputDevice *output)
+{
+    if (output->keyboard.filehandle > 0)
+    {
+        flushChannel(output->keyboard);
+        closeUInputDevice(output->keyboard.filehandle);
+        output->keyboard.filehandle = 0;
+    }
+
+    if (output->mouse.filehandle > 0)
+    {
+        flushChannel(output->mouse);
+        closeUInputDevice(output->mouse.filehandle);
+        output->mouse.filehandle = 0;
+    }
+}
+
+/**
+ * @brief Enable or disable creation of keyboard and mouse devices for every
+ *     controller added later with addOutputDevice. Disabling removes already
+ *     created per controller devices.
+ */
+bool UInputEventHandler::setPerDeviceOutput(bool enabled)
+{
+    if (!enabled && perDeviceOutput)
+    {
+        for (auto iter = deviceOutputs.begin(); iter != deviceOutputs.end(); ++iter)
+        {
+            closeOutputDevice(iter.value());
+            delete iter.value();
+        }
+
+        deviceOutputs.clear();
+        currentOutput = &sharedOutput;
+    }
+
+    perDeviceOutput = enabled;
+    return true;
+}
+
+bool UInputEventHandler::isPerDeviceOutput() const { return perDeviceOutput; }
+
+/**
+ * @brief Create virtual keyboard and mouse named after the controller.
+ *     When devices cannot be created, the controller keeps using shared devices.
+ */
+void UInputEventHandler::addOutputDevice(int deviceId, QString deviceName)
+{
+    if (!perDeviceOutput || deviceOutputs.contains(deviceId))
+        return;
+
+    UInputOutputDevice *output = new UInputOutputDevice();
+    output->keyboard.filehandle = openUInputHandle();
+    output->mouse.filehandle = openUInputHandle();
+
+    if ((output->keyboard.filehandle <= 0) || (output->mouse.filehandle <= 0))
+    {
+        if (output->keyboard.filehandle > 0)
+            close(output->keyboard.filehandle);
+
+        if (output->mouse.filehandle > 0)
+            close(output->mouse.filehandle);
+
+        delete output;
+        qWarning() << "Could not create uinput output devices for" << deviceName << ". Using shared devices.";
+        return;
+    }
+
+    QString mouseName = QString("%1 (%2)").arg(mouseDeviceName, deviceName);
+
+    setKeyboardEvents(output->keyboard.filehandle);
+    populateKeyCodes(output->keyboard.filehandle);
+    createUInputKeyboardDevice(output->keyboard.filehandle, QString("%1 (%2)").arg(keyboardDeviceName, deviceName));
+
+    setRelMouseEvents(output->mouse.filehandle);
+    createUInputMouseDevice(output->mouse.filehandle, mouseName);
+
+    deviceOutputs.insert(deviceId, output);
+    DEBUG() << "Created uinput output devices for" << deviceName;
+
+#ifdef WITH_X11
+    if (QApplication::platformName() == QStringLiteral("xcb"))
+    {
+        QTimer::singleShot(2000, this, [mouseName]() {
+            if (X11Extras::getInstance())
+                X11Extras::getInstance()->x11ResetMouseAccelerationChange(mouseName);
+        });
+    }
+#endif
+}
+
+void UInputEventHandler::removeOutputDevice(int deviceId)
+{
+    UInputOutputDevice *output = deviceOutputs.take(deviceId);
+
+    if (output != nullptr)
+    {
+        if (currentOutput == output)
+            currentOutput = &sharedOutput;
+
+        closeOutputDevice(output);
+        delete output;
+    }
+}
+
+void UInputEventHandler::selectOutputDevice(int deviceId)
+{
+    currentOutput = (perDeviceOutput && (deviceId != -1)) ? deviceOutputs.value(deviceId, &sharedOutput) : &sharedOutput;
+}
+
+void UInputEventHandler::beginOutputBatch() { batchActive = true; }
+
+/**
+ * @brief Write events queued since beginOutputBatch. Every channel is written
+ *     with a single call so output of one controller is not interleaved
+ *     with output of another one.
+ */
+void UInputEventHandler::flushOutputBatch()
+{
+    batchActive = false;
+
+    flushChannel(sharedOutput.keyboard);
+    flushChannel(sharedOutput.mouse);
+    flushChannel(springMouse);
+
+    for (auto iter = deviceOutputs.begin(); iter != deviceOutputs.end(); ++iter)
+    {
+        flushChannel(iter.value()->keyboard);
+        flushChannel(iter.value()->mouse);
+    }
+
+    for (auto iter = gamepadOutputs.begin(); iter != gamepadOutputs.end(); ++iter)
+        flushChannel(iter.value()->channel);
+}
+
+/**
+ * @brief Enable or disable creation of virtual gamepad for every game
+ *     controller added later with addGamepadDevice. Disabling removes already
+ *     created gamepads.
+ */
+bool UInputEventHandler::setVirtualGamepadOutput(bool enabled)
+{
+    if (!enabled && virtualGamepadOutput)
+    {
+        for (auto iter = gamepadOutputs.begin(); iter != gamepadOutputs.end(); ++iter)
+        {
+            closeGamepadDevice(iter.value());
+            delete iter.value();
+        }
+
+        gamepadOutputs.clear();
+    }
+
+    virtualGamepadOutput = enabled;
+    return true;
+}
+
+bool UInputEventHandler::isVirtualGamepadOutput() const { return virtualGamepadOutput; }
+
+void UInputEventHandler::addGamepadDevice(int deviceId, QString deviceName)
+{
+    if (!virtualGamepadOutput || gamepadOutputs.contains(deviceId))
+        return;
+
+    UInputGamepad *gamepad = new UInputGamepad();
+    gamepad->channel.filehandle = openUInputHandle();
+
+    if (gamepad->channel.filehandle <= 0)
+    {
+        delete gamepad;
+        qWarning() << "Could not create uinput virtual gamepad for" << deviceName;
+        return;
+    }
+
+    setGamepadEvents(gamepad->channel.filehandle);
+    createUInputGamepadDevice(gamepad->channel.filehandle, QString("%1 (%2)").arg(gamepadDeviceName, deviceName));
+
+    gamepadOutputs.insert(deviceId, gamepad);
+    DEBUG() << "Created uinput virtual gamepad for" << deviceName;
+}
+
+void UInputEventHandler::removeGamepadDevice(int deviceId)
+{
+    UInputGamepad *gamepad = gamepadOutputs.take(deviceId);
+
+    if (gamepad != nullptr)
+    {
+        closeGamepadDevice(gamepad);
+        delete gamepad;
+    }
+}
+
+void UInputEventHandler::closeGamepadDevice(UInputGamepad *gamepad)
+{
+    if (gamepad->channel.filehandle > 0)
+    {
+        flushChannel(gamepad->channel);
+        closeUInputDevice(gamepad->channel.filehandle);
+        gamepad->channel.filehandle = 0;
+    }
+}
+
+/**
+ * @brief Convert SDL_GameControllerButton to evdev key code.
+ *     D-pad buttons are reported as hat axes and return 0.
+ */
+static int gamepadButtonCode(int button)
+{
+    switch (button)
+    {
+    case SDL_CONTROLLER_BUTTON_A:
+        return BTN_SOUTH;
+    case SDL_CONTROLLER_BUTTON_B:
+        return BTN_EAST;
+    case SDL_CONTROLLER_BUTTON_X:
+        return BTN_WEST;
+    case SDL_CONTROLLER_BUTTON_Y:
+        return BTN_NORTH;
+    case SDL_CONTROLLER_BUTTON_BACK:
+        return BTN_SELECT;
+    case SDL_CONTROLLER_BUTTON_GUIDE:
+        return BTN_MODE;
+    case SDL_CONTROLLER_BUTTON_START:
+        return BTN_START;
+    case SDL_CONTROLLER_BUTTON_LEFTSTICK:
+        return BTN_THUMBL;
+    case SDL_CONTROLLER_BUTTON_RIGHTSTICK:
+        return BTN_THUMBR;
+    case SDL_CONTROLLER_BUTTON_LEFTSHOULDER:
+        return BTN_TL;
+    case SDL_CONTROLLER_BUTTON_RIGHTSHOULDER:
+        return BTN_TR;
+    default:
+        return 0;
+    }
+}
+
+static int gamepadAxisCode(int axis)
+{
+    switch (axis)
+    {
+    case SDL_CONTROLLER_AXIS_LEFTX:
+        return ABS_X;
+    case SDL_CONTROLLER_AXIS_LEFTY:
+        return ABS_Y;
+    case SDL_CONTROLLER_AXIS_RIGHTX:
+        return ABS_RX;
+    case SDL_CONTROLLER_AXIS_RIGHTY:
+        return ABS_RY;
+    case SDL_CONTROLLER_AXIS_TRIGGERLEFT:
+        return ABS_Z;
+    case SDL_CONTROLLER_AXIS_TRIGGERRIGHT:
+        return ABS_RZ;
+    default:
+        return -1;
+    }
+}
+
+void UInputEventHandler::sendGamepadButtonEvent(int deviceId, int button, bool pressed)
+{
+    UInputGamepad *gamepad = gamepadOutputs.value(deviceId, nullptr);
+
+    if (gamepad == nullptr)
+        return;
+
+    int references = gamepad->buttonRefs.value(button, 0) + (pressed ? 1 : -1);
+
+    if (references > 0)
+        gamepad->buttonRefs.insert(button, references);
+    else
+        gamepad->buttonRefs.remove(button);
+
+    // Only first press and last release change state of virtual button.
+    if ((pressed && (references != 1)) || (!pressed && (references > 0)))
+        return;
+
+    if ((button >= SDL_CONTROLLER_BUTTON_DPAD_UP) && (button <= SDL_CONTROLLER_BUTTON_DPAD_RIGHT))
+    {
+        updateGamepadHat(gamepad, button);
+    } else
+    {
+        int code = gamepadButtonCode(button);
+
+        if (code > 0)
+            write_uinput_event(gamepad->channel, EV_KEY, code, pressed ? 1 : 0);
+    }
+}
+
+void UInputEventHandler::updateGamepadHat(UInputGamepad *gamepad, int button)
+{
+    if ((button == SDL_CONTROLLER_BUTTON_DPAD_LEFT) || (button == SDL_CONTROLLER_BUTTON_DPAD_RIGHT))
+    {
+        int value = (gamepad->buttonRefs.contains(SDL_CONTROLLER_BUTTON_DPAD_RIGHT) ? 1 : 0) -
+                    (gamepad->buttonRefs.contains(SDL_CONTROLLER_BUTTON_DPAD_LEFT) ? 1 : 0);
+        write_uinput_event(gamepad->channel, EV_ABS, ABS_HAT0X, value);
+    } else
+    {
+        int value = (gamepad->buttonRefs.contains(SDL_CONTROLLER_BUTTON_DPAD_DOWN) ? 1 : 0) -
+                    (gamepad->buttonRefs.contains(SDL_CONTROLLER_BUTTON_DPAD_UP) ? 1 : 0);
+        write_uinput_event(gamepad->channel, EV_ABS, ABS_HAT0Y, value);
+    }
+}
+
+void UInputEventHandler::sendGamepadAxisEvent(int deviceId, int axis, int value)
+{
+    UInputGamepad *gamepad = gamepadOutputs.value(deviceId, nullptr);
+    int code = gamepadAxisCode(axis);
+
+    if ((gamepad != nullptr) && (code >= 0))
+        write_uinput_event(gamepad->channel, EV_ABS, code, value);
+}
+
 void UInputEventHandler::sendKeyboardEvent(JoyButtonSlot *slot, bool pressed)
 {
     JoyButtonSlot::JoySlotInputAction device = slot->getSlotMode();
@@ -185,10 +521,17 @@ void UInputEventHandler::sendKeyboardEvent(JoyButtonSlot *slot, bool pressed)
 
     if (device == JoyButtonSlot::JoyKeyboard)
     {
-        write_uinput_event(keyboardFileHandler, EV_KEY, code, pressed ? 1 : 0);
+        write_uinput_event(currentOutput->keyboard, EV_KEY, code, pressed ? 1 : 0);
     }
 }
 
+/**
+ * @brief libinput drops autorepeat events of devices and X server or
+ *     Wayland clients repeat held keys themselves. Emulated repeat would
+ *     only add to that.
+ */
+bool UInputEventHandler::emulatesKeyRepeat() const { return false; }
+
 void UInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
 {
     JoyButtonSlot::JoySlotInputAction device = slot->getSlotMode();
@@ -215,54 +558,54 @@ void UInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
             }
             }
 
-            write_uinput_event(mouseFileHandler, EV_KEY, tempcode, pressed ? 1 : 0);
+            write_uinput_event(currentOutput->mouse, EV_KEY, tempcode, pressed ? 1 : 0);
         } else if (code == 4)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_WHEEL, 1);
+                write_uinput_event(currentOutput->mouse, EV_REL, REL_WHEEL, 1);
             }
 
         } else if (code == 5)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_WHEEL, -1);
+                write_uinput_event(currentOutput->mouse, EV_REL, REL_WHEEL, -1);
             }
         } else if (code == 6)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_HWHEEL, -1);
+                write_uinput_event(currentOutput->mouse, EV_REL, REL_HWHEEL, -1);
             }
         } else if (code == 7)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_HWHEEL, 1);
+                write_uinput_event(currentOutput->mouse, EV_REL, REL_HWHEEL, 1);
             }
         } else if (code == 8)
         {
-            write_uinput_event(mouseFileHandler, EV_KEY, BTN_SIDE, pressed ? 1 : 0);
+            write_uinput_event(currentOutput->mouse, EV_KEY, BTN_SIDE, pressed ? 1 : 0);
         } else if (code == 9)
         {
-            write_uinput_event(mouseFileHandler, EV_KEY, BTN_EXTRA, pressed ? 1 : 0);
+            write_uinput_event(currentOutput->mouse, EV_KEY, BTN_EXTRA, pressed ? 1 : 0);
         }
     }
 }
 
 void UInputEventHandler::sendMouseEvent(int xDis, int yDis)
 {
-    write_uinput_event(mouseFileHandler, EV_REL, REL_X, xDis, false);
-    write_uinput_event(mouseFileHandler, EV_REL, REL_Y, yDis);
+    write_uinput_event(currentOutput->mouse, EV_REL, REL_X, xDis, false);
+    write_uinput_event(currentOutput->mouse, EV_REL, REL_Y, yDis);
 }
 
 void UInputEventHandler::sendMouseAbsEvent(int xDis, int yDis, int screen)
 {
     Q_UNUSED(screen);
 
-    write_uinput_event(springMouseFileHandler, EV_ABS, ABS_X, xDis, false);
-    write_uinput_event(springMouseFileHandler, EV_ABS, ABS_Y, yDis);
+    write_uinput_event(springMouse, EV_ABS, ABS_X, xDis, false);
+    write_uinput_event(springMouse, EV_ABS, ABS_Y, yDis);
 }
 
 void UInputEventHandler::sendMouseSpringEvent(int xDis, int yDis, int width, int height)
@@ -278,6 +621,40 @@ void UInputEventHandler::sendMouseSpringEvent(int xDis, int yDis, int width, int
     }
 }
 
+/**
+ * @brief Write high resolution wheel movement together with legacy wheel
+ *     clicks for every full 120 units, so clients not supporting high
+ *     resolution scrolling still receive events.
+ */
+void UInputEventHandler::sendMouseWheelEvent(int vertical, int horizontal)
+{
+    currentOutput->wheelUnitsY += vertical;
+    currentOutput->wheelUnitsX += horizontal;
+
+    int clicksY = currentOutput->wheelUnitsY / GlobalVariables::JoyButton::HIRESWHEELUNITS;
+    int clicksX = currentOutput->wheelUnitsX / GlobalVariables::JoyButton::HIRESWHEELUNITS;
+    currentOutput->wheelUnitsY -= clicksY * GlobalVariables::JoyButton::HIRESWHEELUNITS;
+    currentOutput->wheelUnitsX -= clicksX * GlobalVariables::JoyButton::HIRESWHEELUNITS;
+
+    const int codes[] = {REL_WHEEL_HI_RES, REL_HWHEEL_HI_RES, REL_WHEEL, REL_HWHEEL};
+    const int values[] = {vertical, horizontal, clicksY, clicksX};
+    int last = -1;
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (values[i] != 0)
+            last = i;
+    }
+
+    for (int i = 0; i <= last; i++)
+    {
+        if (values[i] != 0)
+            write_uinput_event(currentOutput->mouse, EV_REL, codes[i], values[i], i == last);
+    }
+}
+
+bool UInputEventHandler::supportsHiResScroll() { return true; }
+
 int UInputEventHandler::openUInputHandle()
 {
     int filehandle = -1;
@@ -342,6 +719,8 @@ void UInputEventHandler::setRelMouseEvents(int filehandle)
     ioctl(filehandle, UI_SET_RELBIT, REL_Y);
     ioctl(filehandle, UI_SET_RELBIT, REL_WHEEL);
     ioctl(filehandle, UI_SET_RELBIT, REL_HWHEEL);
+    ioctl(filehandle, UI_SET_RELBIT, REL_WHEEL_HI_RES);
+    ioctl(filehandle, UI_SET_RELBIT, REL_HWHEEL_HI_RES);
 
     ioctl(filehandle, UI_SET_KEYBIT, BTN_LEFT);
     ioctl(filehandle, UI_SET_KEYBIT, BTN_RIGHT);
@@ -375,13 +754,13 @@ void UInputEventHandler::populateKeyCodes(int filehandle)
     }
 }
 
-void UInputEventHandler::createUInputKeyboardDevice(int filehandle)
+void UInputEventHandler::createUInputKeyboardDevice(int filehandle, const QString &name)
 {
     struct uinput_user_dev uidev;
 
     memset(&uidev, 0, sizeof(uidev));
-    QByteArray temp = keyboardDeviceName.toUtf8();
-    strncpy(uidev.name, temp.constData(), UINPUT_MAX_NAME_SIZE);
+    QByteArray temp = name.toUtf8();
+    strncpy(uidev.name, temp.constData(), UINPUT_MAX_NAME_SIZE - 1);
     uidev.id.bustype = BUS_USB;
     uidev.id.vendor = 0x0;
     uidev.id.product = 0x0;
@@ -391,13 +770,13 @@ void UInputEventHandler::createUInputKeyboardDevice(int filehandle)
     ioctl(filehandle, UI_DEV_CREATE);
 }
 
-void UInputEventHandler::createUInputMouseDevice(int filehandle)
+void UInputEventHandler::createUInputMouseDevice(int filehandle, const QString &name)
 {
     struct uinput_user_dev uidev;
 
     memset(&uidev, 0, sizeof(uidev));
-    QByteArray temp = mouseDeviceName.toUtf8();
-    strncpy(uidev.name, temp.constData(), UINPUT_MAX_NAME_SIZE);
+    QByteArray temp = name.toUtf8();
+    strncpy(uidev.name, temp.constData(), UINPUT_MAX_NAME_SIZE - 1);
     uidev.id.bustype = BUS_USB;
     uidev.id.vendor = 0x0;
     uidev.id.product = 0x0;
@@ -431,13 +810,65 @@ void UInputEventHandler::createUInputSpringMouseDevice(int filehandle)
     ioctl(filehandle, UI_DEV_CREATE);
 }
 
+void UInputEventHandler::setGamepadEvents(int filehandle)
+{
+    ioctl(filehandle, UI_SET_EVBIT, EV_KEY);
+    ioctl(filehandle, UI_SET_EVBIT, EV_SYN);
+    ioctl(filehandle, UI_SET_EVBIT, EV_ABS);
+
+    const int buttons[] = {BTN_SOUTH, BTN_EAST,  BTN_WEST,   BTN_NORTH, BTN_SELECT, BTN_MODE,
+                           BTN_START, BTN_THUMBL, BTN_THUMBR, BTN_TL,    BTN_TR};
+
+    for (int button : buttons)
+        ioctl(filehandle, UI_SET_KEYBIT, button);
+
+    const int axes[] = {ABS_X, ABS_Y, ABS_RX, ABS_RY, ABS_Z, ABS_RZ, ABS_HAT0X, ABS_HAT0Y};
+
+    for (int axis : axes)
+        ioctl(filehandle, UI_SET_ABSBIT, axis);
+}
+
+void UInputEventHandler::createUInputGamepadDevice(int filehandle, const QString &name)
+{
+    struct uinput_user_dev uidev;
+
+    memset(&uidev, 0, sizeof(uidev));
+    QByteArray temp = name.toUtf8();
+    strncpy(uidev.name, temp.constData(), UINPUT_MAX_NAME_SIZE - 1);
+    uidev.id.bustype = BUS_VIRTUAL;
+    uidev.id.vendor = 0x0;
+    uidev.id.product = 0x0;
+    uidev.id.version = 1;
+
+    const int sticks[] = {ABS_X, ABS_Y, ABS_RX, ABS_RY};
+
+    for (int axis : sticks)
+    {
+        uidev.absmin[axis] = -32767;
+        uidev.absmax[axis] = 32767;
+    }
+
+    uidev.absmin[ABS_Z] = 0;
+    uidev.absmax[ABS_Z] = 32767;
+    uidev.absmin[ABS_RZ] = 0;
+    uidev.absmax[ABS_RZ] = 32767;
+
+    uidev.absmin[ABS_HAT0X] = -1;
+    uidev.absmax[ABS_HAT0X] = 1;
+    uidev.absmin[ABS_HAT0Y] = -1;
+    uidev.absmax[ABS_HAT0Y] = 1;
+
+    write(filehandle, &uidev, sizeof(uidev));
+    ioctl(filehandle, UI_DEV_CREATE);
+}
+
 void UInputEventHandler::closeUInputDevice(int filehandle)
 {
     ioctl(filehandle, UI_DEV_DESTROY);
     close(filehandle);
 }
 
-void UInputEventHandler::write_uinput_event(int filehandle, int type, int code, int value, bool syn)
+void UInputEventHandler::write_uinput_event(UInputChannel &channel, int type, int code, int value, bool syn)
 {
     struct input_event ev;
     struct input_event ev2;
@@ -448,18 +879,32 @@ void UInputEventHandler::write_uinput_event(int filehandle, int type, int code,
     ev.code = code;
     ev.value = value;
 
-    write(filehandle, &ev, sizeof(struct input_event));
+    channel.pending.append(ev);
 
     if (syn)
     {
         memset(&ev2, 0, sizeof(struct input_event));
-        gettimeofday(&ev2.time, nullptr);
+        ev2.time = ev.time;
         ev2.type = EV_SYN;
         ev2.code = SYN_REPORT;
         ev2.value = 0;
 
-        write(filehandle, &ev2, sizeof(struct input_event));
+        channel.pending.append(ev2);
     }
+
+    if (!batchActive && syn)
+        flushChannel(channel);
+}
+
+void UInputEventHandler::flushChannel(UInputChannel &channel)
+{
+    if (channel.pending.isEmpty())
+        return;
+
+    if (channel.filehandle > 0)
+        write(channel.filehandle, channel.pending.constData(), sizeof(struct input_event) * channel.pending.size());
+
+    channel.pending.clear();
 }
 
 QString UInputEventHandler::getName() { return QString("uinput"); }
@@ -496,8 +941,41 @@ void UInputEventHandler::printPostMessages()
     }
 }
 
-void UInputEventHandler::sendTextEntryEvent(QString maintext)
+void UInputEventHandler::sendTextEntryEvent(QString maintext) { writeKeySequence(compileTextEntry(maintext)); }
+
+void UInputEventHandler::sendTextEntrySlotEvent(JoyButtonSlot *slot)
+{
+    if (!slot->isResolved(getResolveGeneration()))
+        resolveSlot(slot);
+
+    writeKeySequence(slot->getResolvedSequence());
+}
+
+/**
+ * @brief Keyboard slot codes are already native for uinput. Text entry
+ *     slots get their complete key event sequence.
+ */
+void UInputEventHandler::resolveSlot(JoyButtonSlot *slot)
+{
+    if (slot->getSlotMode() == JoyButtonSlot::JoyTextEntry)
+        slot->setResolvedSequence(compileTextEntry(slot->getTextData()), getResolveGeneration());
+    else
+        slot->setResolvedCode(slot->getSlotCode(), getResolveGeneration());
+}
+
+void UInputEventHandler::writeKeySequence(const QVector<JoyButtonSlot::ResolvedKeyEvent> &sequence)
 {
+    for (const JoyButtonSlot::ResolvedKeyEvent &event : sequence)
+        write_uinput_event(currentOutput->keyboard, EV_KEY, event.code, event.pressed ? 1 : 0, event.flush);
+}
+
+/**
+ * @brief Convert text to key events typing it. Every character is typed
+ *     by pressing needed modifiers and key, then releasing them in reverse order.
+ */
+QVector<JoyButtonSlot::ResolvedKeyEvent> UInputEventHandler::compileTextEntry(const QString &maintext)
+{
+    QVector<JoyButtonSlot::ResolvedKeyEvent> sequence;
     AntKeyMapper *mapper = AntKeyMapper::getInstance();
 
     if ((mapper != nullptr) && mapper->getKeyMapper())
@@ -549,14 +1027,14 @@ void UInputEventHandler::sendTextEntryEvent(QString maintext)
             {
                 if (temp.modifiers != Qt::NoModifier)
                 {
-                    testAndAppend(temp.modifiers.testFlag(Qt::ShiftModifier), tempList, KEY_LEFTSHIFT);
-                    testAndAppend(temp.modifiers.testFlag(Qt::ControlModifier), tempList, KEY_LEFTCTRL);
-                    testAndAppend(temp.modifiers.testFlag(Qt::AltModifier), tempList, KEY_LEFTALT);
-                    testAndAppend(temp.modifiers.testFlag(Qt::MetaModifier), tempList, KEY_LEFTMETA);
+                    testAndAppend(temp.modifiers.testFlag(Qt::ShiftModifier), tempList, KEY_LEFTSHIFT, sequence);
+                    testAndAppend(temp.modifiers.testFlag(Qt::ControlModifier), tempList, KEY_LEFTCTRL, sequence);
+                    testAndAppend(temp.modifiers.testFlag(Qt::AltModifier), tempList, KEY_LEFTALT, sequence);
+                    testAndAppend(temp.modifiers.testFlag(Qt::MetaModifier), tempList, KEY_LEFTMETA, sequence);
                 }
 
                 tempList.append(temp.virtualkey);
-                write_uinput_event(keyboardFileHandler, EV_KEY, temp.virtualkey, 1, true);
+                sequence.append({static_cast<int>(temp.virtualkey), true, true});
             }
 
             if (tempList.size() > 0)
@@ -565,26 +1043,29 @@ void UInputEventHandler::sendTextEntryEvent(QString maintext)
                 {
                     unsigned int currentcode = *iter;
                     bool sync = std::next(iter) == tempList.crend();
-                    write_uinput_event(keyboardFileHandler, EV_KEY, currentcode, 0, sync);
+                    sequence.append({static_cast<int>(currentcode), false, sync});
                 }
             }
         }
     }
+
+    return sequence;
 }
 
-void UInputEventHandler::testAndAppend(bool tested, QList<unsigned int> &tempList, unsigned int key)
+void UInputEventHandler::testAndAppend(bool tested, QList<unsigned int> &tempList, unsigned int key,
+                                       QVector<JoyButtonSlot::ResolvedKeyEvent> &sequence)
 {
     if (tested)
     {
         tempList.append(key);
-        write_uinput_event(keyboardFileHandler, EV_KEY, key, 1, false);
+        sequence.append({static_cast<int>(key), true, false});
     }
 }
 
-int UInputEventHandler::getKeyboardFileHandler() { return keyboardFileHandler; }
+int UInputEventHandler::getKeyboardFileHandler() { return sharedOutput.keyboard.filehandle; }
 
-int UInputEventHandler::getMouseFileHandler() { return mouseFileHandler; }
+int UInputEventHandler::getMouseFileHandler() { return sharedOutput.mouse.filehandle; }
 
-int UInputEventHandler::getSpringMouseFileHandler() { return springMouseFileHandler; }
+int UInputEventHandler::getSpringMouseFileHandler() { return springMouse.filehandle; }
 
 const QString UInputEventHandler::getUinputDeviceLocation() { return uinputDeviceLocation; }
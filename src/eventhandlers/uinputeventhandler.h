@@ -20,6 +20,12 @@
 #define UINPUTEVENTHANDLER_H
 
 #include "baseeventhandler.h"
+#include "joybuttonslot.h"
+
+#include <QHash>
+#include <QVector>
+
+#include <linux/input.h>
 
 /**
  * @brief Input event handler class using uinput files
@@ -31,7 +37,7 @@
  * https://www.kernel.org/doc/html/v5.15/input/event-codes.html
  *
  */
-class UInputEventHandler : public BaseEventHandler
+class UInputEventHandler final : public BaseEventHandler
 {
     Q_OBJECT
 
@@ -47,12 +53,32 @@ class UInputEventHandler : public BaseEventHandler
     virtual void sendMouseAbsEvent(int xDis, int yDis, int screen) override;
 
     virtual void sendMouseSpringEvent(int xDis, int yDis, int width, int height) override;
+    virtual void sendMouseWheelEvent(int vertical, int horizontal) override;
+    virtual bool supportsHiResScroll() override;
 
     virtual QString getName() override;
     virtual QString getIdentifier() override;
     virtual void printPostMessages() override;
 
+    virtual bool emulatesKeyRepeat() const override;
     virtual void sendTextEntryEvent(QString maintext) override;
+    virtual void sendTextEntrySlotEvent(JoyButtonSlot *slot) override;
+    virtual void resolveSlot(JoyButtonSlot *slot) override;
+
+    virtual bool setPerDeviceOutput(bool enabled) override;
+    virtual bool isPerDeviceOutput() const override;
+    virtual void addOutputDevice(int deviceId, QString deviceName) override;
+    virtual void removeOutputDevice(int deviceId) override;
+    virtual void selectOutputDevice(int deviceId) override;
+    virtual void beginOutputBatch() override;
+    virtual void flushOutputBatch() override;
+
+    virtual bool setVirtualGamepadOutput(bool enabled) override;
+    virtual bool isVirtualGamepadOutput() const override;
+    virtual void addGamepadDevice(int deviceId, QString deviceName) override;
+    virtual void removeGamepadDevice(int deviceId) override;
+    virtual void sendGamepadButtonEvent(int deviceId, int button, bool pressed) override;
+    virtual void sendGamepadAxisEvent(int deviceId, int axis, int value) override;
 
     int getKeyboardFileHandler();
     int getMouseFileHandler();
@@ -60,25 +86,62 @@ class UInputEventHandler : public BaseEventHandler
     const QString getUinputDeviceLocation();
 
   protected:
+    /**
+     * @brief uinput file handle together with events waiting to be written to it
+     */
+    struct UInputChannel
+    {
+        int filehandle = 0;
+        QVector<struct input_event> pending;
+    };
+
+    /**
+     * @brief Keyboard and relative mouse pair used as output of one controller.
+     *     High resolution wheel units not yet sent as legacy wheel clicks are
+     *     kept per mouse.
+     */
+    struct UInputOutputDevice
+    {
+        UInputChannel keyboard;
+        UInputChannel mouse;
+        int wheelUnitsX = 0;
+        int wheelUnitsY = 0;
+    };
+
+    /**
+     * @brief Virtual gamepad created for one game controller. Number of
+     *     presses is tracked per button, so several inputs can be combined
+     *     into one virtual button.
+     */
+    struct UInputGamepad
+    {
+        UInputChannel channel;
+        QHash<int, int> buttonRefs;
+    };
+
     int openUInputHandle();
     void setKeyboardEvents(int filehandle);
     void setRelMouseEvents(int filehandle);
     void setSpringMouseEvents(int filehandle);
     void populateKeyCodes(int filehandle);
-    void createUInputKeyboardDevice(int filehandle);
-    void createUInputMouseDevice(int filehandle);
+    void createUInputKeyboardDevice(int filehandle, const QString &name);
+    void createUInputMouseDevice(int filehandle, const QString &name);
     void createUInputSpringMouseDevice(int filehandle);
+    void setGamepadEvents(int filehandle);
+    void createUInputGamepadDevice(int filehandle, const QString &name);
     void closeUInputDevice(int filehandle);
     /**
-     * @brief Write uinput event to selected file uinput file
+     * @brief Write uinput event to selected channel. While an output batch is open
+     *     event is only queued and written during flushOutputBatch.
      *
-     * @param filehandle - C-style linux file handle obtained by open()
+     * @param channel - channel holding C-style linux file handle obtained by open()
      * @param type type of event described in input-event-codes.h (for example EV_ABS )
      * @param code Additional code like ABS_X for type EV_ABS
      * @param value
      * @param syn synchronize after event (emit additional event used for separation of events EV_SYN)
      */
-    void write_uinput_event(int filehandle, int type, int code, int value, bool syn = true);
+    void write_uinput_event(UInputChannel &channel, int type, int code, int value, bool syn = true);
+    void flushChannel(UInputChannel &channel);
 
   private slots:
 #ifdef WITH_X11
@@ -86,17 +149,28 @@ class UInputEventHandler : public BaseEventHandler
 #endif
 
   private:
-    int keyboardFileHandler;
-    int mouseFileHandler;
-    int springMouseFileHandler;
+    UInputOutputDevice sharedOutput;
+    UInputChannel springMouse;
+    QHash<int, UInputOutputDevice *> deviceOutputs;
+    QHash<int, UInputGamepad *> gamepadOutputs;
+    UInputOutputDevice *currentOutput;
+    bool perDeviceOutput;
+    bool virtualGamepadOutput;
+    bool batchActive;
     QString uinputDeviceLocation;
 #if defined(Q_OS_UNIX)
     bool is_problem_with_opening_uinput_present;
 #endif
 
     bool cleanupUinputEvHand();
-    void testAndAppend(bool tested, QList<unsigned int> &tempList, unsigned int key);
+    void testAndAppend(bool tested, QList<unsigned int> &tempList, unsigned int key,
+                       QVector<JoyButtonSlot::ResolvedKeyEvent> &sequence);
+    QVector<JoyButtonSlot::ResolvedKeyEvent> compileTextEntry(const QString &maintext);
+    void writeKeySequence(const QVector<JoyButtonSlot::ResolvedKeyEvent> &sequence);
     void initDevice(int &device, QString name, bool &result);
+    void closeOutputDevice(UInputOutputDevice *output);
+    void closeGamepadDevice(UInputGamepad *gamepad);
+    void updateGamepadHat(UInputGamepad *gamepad, int button);
 };
 
 #endif // UINPUTEVENTHANDLER_H
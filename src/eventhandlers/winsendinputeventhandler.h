@@ -30,7 +30,7 @@
  * It utilizes SendInput functions
  *
  */
-class WinSendInputEventHandler : public BaseEventHandler
+class WinSendInputEventHandler final : public BaseEventHandler
 {
     Q_OBJECT
   public:
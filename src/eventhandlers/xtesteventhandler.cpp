@@ -55,11 +55,12 @@ void XTestEventHandler::sendKeyboardEvent(JoyButtonSlot *slot, bool pressed)
 
     JoyButtonSlot::JoySlotInputAction device = slot->getSlotMode();
 
-    int code = slot->getSlotCode();
-
     if (device == JoyButtonSlot::JoyKeyboard)
     {
-        int tempcode = XKeysymToKeycode(display, static_cast<KeySym>(code));
+        if (!slot->isResolved(getResolveGeneration()))
+            resolveSlot(slot);
+
+        int tempcode = slot->getResolvedCode();
 
         if (tempcode > 0)
         {
@@ -97,12 +98,65 @@ void XTestEventHandler::sendMouseAbsEvent(int xDis, int yDis, int screen)
     XFlush(display);
 }
 
+/**
+ * @brief X server repeats keys pressed through XTest like keys of real
+ *     keyboards.
+ */
+bool XTestEventHandler::emulatesKeyRepeat() const { return false; }
+
 QString XTestEventHandler::getName() { return QString("XTest"); }
 
 QString XTestEventHandler::getIdentifier() { return QString("xtest"); }
 
-void XTestEventHandler::sendTextEntryEvent(QString maintext)
+void XTestEventHandler::sendTextEntryEvent(QString maintext) { writeKeySequence(compileTextEntry(maintext)); }
+
+void XTestEventHandler::sendTextEntrySlotEvent(JoyButtonSlot *slot)
+{
+    if (!slot->isResolved(getResolveGeneration()))
+        resolveSlot(slot);
+
+    writeKeySequence(slot->getResolvedSequence());
+}
+
+/**
+ * @brief Convert keysym of keyboard slot to X11 keycode or text of text
+ *     entry slot to complete key event sequence.
+ */
+void XTestEventHandler::resolveSlot(JoyButtonSlot *slot)
+{
+    if (slot->getSlotMode() == JoyButtonSlot::JoyTextEntry)
+    {
+        slot->setResolvedSequence(compileTextEntry(slot->getTextData()), getResolveGeneration());
+    } else if (slot->getSlotMode() == JoyButtonSlot::JoyKeyboard)
+    {
+        Display *display = X11Extras::getInstance()->display();
+        slot->setResolvedCode(XKeysymToKeycode(display, static_cast<KeySym>(slot->getSlotCode())), getResolveGeneration());
+    } else
+    {
+        slot->setResolvedCode(slot->getSlotCode(), getResolveGeneration());
+    }
+}
+
+void XTestEventHandler::writeKeySequence(const QVector<JoyButtonSlot::ResolvedKeyEvent> &sequence)
+{
+    Display *display = X11Extras::getInstance()->display();
+
+    for (const JoyButtonSlot::ResolvedKeyEvent &event : sequence)
+    {
+        XTestFakeKeyEvent(display, event.code, event.pressed, 0);
+
+        if (event.flush)
+            XFlush(display);
+    }
+}
+
+/**
+ * @brief Convert text to key events typing it. Every character is typed
+ *     by pressing needed modifiers and key, then releasing them in reverse order.
+ */
+QVector<JoyButtonSlot::ResolvedKeyEvent> XTestEventHandler::compileTextEntry(const QString &maintext)
 {
+    QVector<JoyButtonSlot::ResolvedKeyEvent> sequence;
     AntKeyMapper *mapper = AntKeyMapper::getInstance();
 
     if ((mapper != nullptr) && mapper->getKeyMapper())
@@ -120,55 +174,29 @@ void XTestEventHandler::sendTextEntryEvent(QString maintext)
                 QList<int> tempList;
 
                 if ((temp.modifiers != Qt::NoModifier) && temp.modifiers.testFlag(Qt::ShiftModifier))
-                {
-                    int shiftcode = XKeysymToKeycode(display, XK_Shift_L);
-                    int modifiercode = shiftcode;
-                    XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                    tempList.append(modifiercode);
-                }
+                    tempList.append(XKeysymToKeycode(display, XK_Shift_L));
 
                 if ((temp.modifiers != Qt::NoModifier) && temp.modifiers.testFlag(Qt::ControlModifier))
-                {
-                    int controlcode = XKeysymToKeycode(display, XK_Control_L);
-                    int modifiercode = controlcode;
-                    XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                    tempList.append(modifiercode);
-                }
+                    tempList.append(XKeysymToKeycode(display, XK_Control_L));
 
                 if ((temp.modifiers != Qt::NoModifier) && temp.modifiers.testFlag(Qt::AltModifier))
-                {
-                    int altcode = XKeysymToKeycode(display, XK_Alt_L);
-                    int modifiercode = altcode;
-                    XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                    tempList.append(modifiercode);
-                }
+                    tempList.append(XKeysymToKeycode(display, XK_Alt_L));
 
                 if ((temp.modifiers != Qt::NoModifier) && temp.modifiers.testFlag(Qt::MetaModifier))
-                {
-                    int metacode = XKeysymToKeycode(display, XK_Meta_L);
-                    int modifiercode = metacode;
-                    XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                    tempList.append(modifiercode);
-                }
-
-                XTestFakeKeyEvent(display, tempcode, 1, 0);
-                tempList.append(tempcode);
+                    tempList.append(XKeysymToKeycode(display, XK_Meta_L));
 
-                XFlush(display);
+                tempList.append(tempcode);
 
-                if (tempList.size() > 0)
-                {
-                    for (auto iter = tempList.crbegin(); iter != tempList.crend(); ++iter)
-                    {
-                        int currentcode = *iter;
-                        XTestFakeKeyEvent(display, currentcode, 0, 0);
-                    }
+                for (auto iter = tempList.cbegin(); iter != tempList.cend(); ++iter)
+                    sequence.append({*iter, true, std::next(iter) == tempList.cend()});
 
-                    XFlush(display);
-                }
+                for (auto iter = tempList.crbegin(); iter != tempList.crend(); ++iter)
+                    sequence.append({*iter, false, std::next(iter) == tempList.crend()});
             }
         }
     }
+
+    return sequence;
 }
 
 void XTestEventHandler::sendMouseSpringEvent(int xDis, int yDis, int width, int height)
@@ -20,10 +20,9 @@
 #define XTESTEVENTHANDLER_H
 
 #include "baseeventhandler.h"
+#include "joybuttonslot.h"
 
-class JoyButtonSlot;
-
-class XTestEventHandler : public BaseEventHandler
+class XTestEventHandler final : public BaseEventHandler
 {
     Q_OBJECT
 
@@ -42,10 +41,17 @@ class XTestEventHandler : public BaseEventHandler
     void sendMouseSpringEvent(int xDis, int yDis, int width, int height) override;
 
     void sendTextEntryEvent(QString maintext) override;
+    void sendTextEntrySlotEvent(JoyButtonSlot *slot) override;
+    void resolveSlot(JoyButtonSlot *slot) override;
+    bool emulatesKeyRepeat() const override;
 
     QString getName() override;
     QString getIdentifier() override;
     void printPostMessages() override;
+
+  private:
+    QVector<JoyButtonSlot::ResolvedKeyEvent> compileTextEntry(const QString &maintext);
+    void writeKeySequence(const QVector<JoyButtonSlot::ResolvedKeyEvent> &sequence);
 };
 
 #endif // XTESTEVENTHANDLER_H
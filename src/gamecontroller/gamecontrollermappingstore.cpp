@@ -0,0 +1,298 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamecontrollermappingstore.h"
+
+#include "antimicrosettings.h"
+#include "common.h"
+#include "logger.h"
+
+#include <SDL2/SDL_gamecontroller.h>
+#include <SDL2/SDL_joystick.h>
+#include <SDL2/SDL_platform.h>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+// Length of GUID string used as the first field of a mapping
+static const int GUID_STRING_LENGTH = 32;
+
+// Bump when layout of the cache file changes
+static const quint32 CACHE_MAGIC = 0x414d5843;
+static const quint32 CACHE_VERSION = 2;
+static const QDataStream::Version CACHE_STREAM_VERSION = QDataStream::Qt_5_10;
+
+QMutex GameControllerMappingStore::mutex;
+QHash<QString, QByteArray> GameControllerMappingStore::databaseMappings;
+QHash<QString, QByteArray> GameControllerMappingStore::databaseVersionlessMappings;
+QHash<QString, QList<QByteArray>> GameControllerMappingStore::savedMappings;
+QSet<QString> GameControllerMappingStore::registeredGuids;
+
+/**
+ * @brief Rebuild index after SDL was (re)initialized. SDL forgets added
+ *     mappings on quit, so nothing is considered registered afterwards.
+ */
+void GameControllerMappingStore::load(const QString &databaseFile, AntiMicroSettings *settings)
+{
+    QMutexLocker locker(&mutex);
+
+    registeredGuids.clear();
+    loadDatabase(databaseFile);
+    loadSavedMappings(settings);
+}
+
+/**
+ * @brief Pass mappings known for device at SDL device index to SDL. Has to
+ *     be called before the device is checked with SDL_IsGameController.
+ *     Saved mappings are added last, so they override database entries.
+ *     GUID of a mapping found through normalized GUID is replaced with GUID
+ *     of the device, so SDL applies it without matching GUIDs again.
+ */
+void GameControllerMappingStore::registerDevice(int index)
+{
+    char buffer[GUID_STRING_LENGTH + 1] = {'\0'};
+    SDL_JoystickGetGUIDString(SDL_JoystickGetDeviceGUID(index), buffer, sizeof(buffer));
+    QString guidText(buffer);
+
+    QMutexLocker locker(&mutex);
+
+    if (registeredGuids.contains(guidText))
+        return;
+
+    registeredGuids.insert(guidText);
+
+    const QString guidKey = normalizedGuid(guidText, false);
+    const QString versionlessKey = normalizedGuid(guidText, true);
+    const QByteArray deviceGuid = guidText.toLatin1();
+
+    auto addMapping = [&deviceGuid](const QByteArray &mapping) {
+        int guidEnd = mapping.indexOf(',');
+
+        // Let SDL take care of validation
+        if (guidEnd > 0)
+            SDL_GameControllerAddMapping(QByteArray(deviceGuid).append(mapping.mid(guidEnd)).constData());
+    };
+
+    auto databaseIter = databaseMappings.constFind(guidKey);
+
+    if (databaseIter != databaseMappings.constEnd())
+    {
+        addMapping(databaseIter.value());
+    } else
+    {
+        auto versionlessIter = databaseVersionlessMappings.constFind(versionlessKey);
+
+        if (versionlessIter != databaseVersionlessMappings.constEnd())
+            addMapping(versionlessIter.value());
+    }
+
+    auto savedIter = savedMappings.constFind(guidKey);
+
+    if ((savedIter == savedMappings.constEnd()) && (versionlessKey != guidKey))
+        savedIter = savedMappings.constFind(versionlessKey);
+
+    if (savedIter != savedMappings.constEnd())
+    {
+        for (const QByteArray &mapping : savedIter.value())
+            addMapping(mapping);
+    }
+}
+
+void GameControllerMappingStore::registerPresentDevices()
+{
+    for (int i = 0; i < SDL_NumJoysticks(); i++)
+        registerDevice(i);
+}
+
+/**
+ * @brief Key of GUID in mapping hashes. CRC of the device name in bytes 2-3
+ *     is cleared like SDL does when it matches mappings. Version in bytes
+ *     12-13 is cleared as well when ignoreVersion is set and the GUID
+ *     carries vendor and product ids.
+ */
+QString GameControllerMappingStore::normalizedGuid(const QString &guid, bool ignoreVersion)
+{
+    QString result = guid.toLower();
+
+    if (result.size() != GUID_STRING_LENGTH)
+        return result;
+
+    static const QString zeroWord = QStringLiteral("0000");
+    result.replace(4, 4, zeroWord);
+
+    // Layout is bus, crc, vendor, 0, product, 0, version, driver
+    bool usesVersion = (result.mid(12, 4) == zeroWord) && (result.mid(20, 4) == zeroWord) &&
+                       (result.mid(8, 4) != zeroWord) && (result.mid(16, 4) != zeroWord);
+
+    if (ignoreVersion && usesVersion)
+        result.replace(24, 4, zeroWord);
+
+    return result;
+}
+
+/**
+ * @brief Fill database index from cache file or parse database when
+ *     cache is missing or outdated. Only mappings for current platform
+ *     are kept, later lines override earlier ones like in SDL.
+ */
+void GameControllerMappingStore::loadDatabase(const QString &databaseFile)
+{
+    databaseMappings.clear();
+    databaseVersionlessMappings.clear();
+
+    QFileInfo source(databaseFile);
+
+    if (!source.exists())
+        return;
+
+    QString cacheFile = QString(PadderCommon::configPath()).append("/gamecontrollerdb.cache");
+
+    if (readCache(cacheFile, source))
+    {
+        DEBUG() << "Loaded " << databaseMappings.size() << " game controller mappings from cache";
+        return;
+    }
+
+    QFile file(databaseFile);
+
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        qWarning() << "Loading game controller mappings from database: " << databaseFile << " failed";
+        return;
+    }
+
+    const QByteArray platformField = QByteArray("platform:").append(SDL_GetPlatform()).append(',');
+
+    while (!file.atEnd())
+    {
+        QByteArray line = file.readLine().trimmed();
+
+        if (line.isEmpty() || line.startsWith('#'))
+            continue;
+
+        int platformIndex = line.indexOf("platform:");
+
+        if ((platformIndex != -1) && (line.indexOf(platformField, platformIndex) != platformIndex))
+            continue;
+
+        int guidEnd = line.indexOf(',');
+
+        if (guidEnd > 0)
+        {
+            QString guid = QString::fromLatin1(line.left(guidEnd));
+            databaseMappings.insert(normalizedGuid(guid, false), line);
+            databaseVersionlessMappings.insert(normalizedGuid(guid, true), line);
+        }
+    }
+
+    DEBUG() << "Loaded " << databaseMappings.size() << " game controller mappings from database";
+
+    writeCache(cacheFile, source);
+}
+
+/**
+ * @brief Index mappings saved in "Mappings" group. Keys are GUID or
+ *     GUID extended with vendor and product, both start with the GUID.
+ */
+void GameControllerMappingStore::loadSavedMappings(AntiMicroSettings *settings)
+{
+    savedMappings.clear();
+
+    settings->getLock()->lock();
+    settings->beginGroup("Mappings");
+
+    for (const QString &key : settings->allKeys())
+    {
+        if (key.endsWith("Disable"))
+            continue;
+
+        QString mappingSetting = settings->value(key, QString()).toString();
+
+        if (!mappingSetting.isEmpty())
+            savedMappings[normalizedGuid(key.left(GUID_STRING_LENGTH), false)].append(mappingSetting.toUtf8());
+    }
+
+    settings->endGroup();
+    settings->getLock()->unlock();
+}
+
+bool GameControllerMappingStore::readCache(const QString &cacheFile, const QFileInfo &source)
+{
+    QFile file(cacheFile);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(CACHE_STREAM_VERSION);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString sourcePath;
+    qint64 sourceSize = 0;
+    qint64 sourceModified = 0;
+    QString platform;
+
+    stream >> magic >> version;
+
+    if ((magic != CACHE_MAGIC) || (version != CACHE_VERSION))
+        return false;
+
+    stream >> sourcePath >> sourceSize >> sourceModified >> platform;
+
+    if ((sourcePath != source.absoluteFilePath()) || (sourceSize != source.size()) ||
+        (sourceModified != source.lastModified().toMSecsSinceEpoch()) || (platform != QString(SDL_GetPlatform())))
+        return false;
+
+    stream >> databaseMappings >> databaseVersionlessMappings;
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        databaseMappings.clear();
+        databaseVersionlessMappings.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void GameControllerMappingStore::writeCache(const QString &cacheFile, const QFileInfo &source)
+{
+    QDir().mkpath(PadderCommon::configPath());
+    QSaveFile file(cacheFile);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "Could not write game controller mapping cache " << cacheFile;
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(CACHE_STREAM_VERSION);
+    stream << CACHE_MAGIC << CACHE_VERSION;
+    stream << source.absoluteFilePath() << source.size() << source.lastModified().toMSecsSinceEpoch()
+           << QString(SDL_GetPlatform());
+    stream << databaseMappings << databaseVersionlessMappings;
+
+    if (!file.commit())
+        qWarning() << "Could not write game controller mapping cache " << cacheFile;
+}
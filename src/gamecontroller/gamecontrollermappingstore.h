@@ -0,0 +1,62 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GAMECONTROLLERMAPPINGSTORE_H
+#define GAMECONTROLLERMAPPINGSTORE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+
+class AntiMicroSettings;
+class QFileInfo;
+
+/**
+ * @brief Index of game controller mappings from gamecontrollerdb and from
+ *     mappings saved in settings, hashed by GUID. Mappings are handed to
+ *     SDL only for devices which are present instead of loading the whole
+ *     database. Parsed database is cached on disk.
+ *
+ * GUIDs are matched the way SDL matches them. CRC of the device name is
+ * ignored and mappings for any version of a device are used when none
+ * exists for the exact version.
+ */
+class GameControllerMappingStore
+{
+  public:
+    static void load(const QString &databaseFile, AntiMicroSettings *settings);
+    static void registerDevice(int index);
+    static void registerPresentDevices();
+
+  private:
+    static QString normalizedGuid(const QString &guid, bool ignoreVersion);
+    static void loadDatabase(const QString &databaseFile);
+    static void loadSavedMappings(AntiMicroSettings *settings);
+    static bool readCache(const QString &cacheFile, const QFileInfo &source);
+    static void writeCache(const QString &cacheFile, const QFileInfo &source);
+
+    static QMutex mutex;
+    static QHash<QString, QByteArray> databaseMappings;
+    static QHash<QString, QByteArray> databaseVersionlessMappings;
+    static QHash<QString, QList<QByteArray>> savedMappings;
+    static QSet<QString> registeredGuids;
+};
+
+#endif // GAMECONTROLLERMAPPINGSTORE_H
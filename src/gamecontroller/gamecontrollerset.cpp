@@ -240,13 +240,13 @@ void GameControllerSet::refreshAxes()
             (i == static_cast<int>(SDL_CONTROLLER_AXIS_TRIGGERRIGHT)))
         {
             GameControllerTrigger *trigger = new GameControllerTrigger(i, getIndex(), this, this);
-            getAxes()->insert(i, trigger);
+            insertAxis(i, trigger);
             enableAxisConnections(trigger);
             connect(trigger, &JoyAxis::hapticTriggerChanged, this, &GameControllerSet::applyHapticTrigger);
         } else
         {
             JoyAxis *axis = new JoyAxis(i, getIndex(), this, this);
-            getAxes()->insert(i, axis);
+            insertAxis(i, axis);
             enableAxisConnections(axis);
         }
     }
@@ -0,0 +1,41 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "virtualgamecontroller.h"
+
+/**
+ * @brief GameController accepts null SDL handle, SDL calls made with it
+ *     return empty values.
+ */
+VirtualGameController::VirtualGameController(SDL_JoystickID instanceID, int deviceIndex, const QString &name,
+                                             const QString &guid, const QString &uniqueID, AntiMicroSettings *settings,
+                                             QObject *parent)
+    : GameController(nullptr, deviceIndex, settings, 0, parent)
+    , m_instanceID(instanceID)
+    , m_name(name)
+    , m_guid(guid)
+    , m_uniqueID(uniqueID)
+{
+}
+
+QString VirtualGameController::getSDLName() { return m_name; }
+
+QString VirtualGameController::getRawGUIDString() const { return m_guid; }
+
+QString VirtualGameController::getRawUniqueIDString() const { return m_uniqueID; }
+
+SDL_JoystickID VirtualGameController::getSDLJoystickID() { return m_instanceID; }
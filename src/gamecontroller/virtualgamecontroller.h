@@ -0,0 +1,48 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VIRTUALGAMECONTROLLER_H
+#define VIRTUALGAMECONTROLLER_H
+
+#include "gamecontroller.h"
+
+/**
+ * @brief Game controller without SDL device behind it. Counterpart of
+ *     VirtualJoystick for SDL_CONTROLLER... events. Sensors are not
+ *     available, because their presence is read from SDL.
+ */
+class VirtualGameController : public GameController
+{
+    Q_OBJECT
+
+  public:
+    explicit VirtualGameController(SDL_JoystickID instanceID, int deviceIndex, const QString &name, const QString &guid,
+                                   const QString &uniqueID, AntiMicroSettings *settings, QObject *parent);
+
+    virtual QString getSDLName() override;
+    virtual QString getRawGUIDString() const override;
+    virtual QString getRawUniqueIDString() const override;
+    virtual SDL_JoystickID getSDLJoystickID() override;
+
+  private:
+    SDL_JoystickID m_instanceID;
+    QString m_name;
+    QString m_guid;
+    QString m_uniqueID;
+};
+
+#endif // VIRTUALGAMECONTROLLER_H
@@ -65,6 +65,8 @@ const double GlobalVariables::JoyButton::DEFAULTMAXACCELTHRESHOLD = 100.0;
 const double GlobalVariables::JoyButton::DEFAULTSTARTACCELMULTIPLIER = 0.0;
 const double GlobalVariables::JoyButton::DEFAULTACCELEASINGDURATION = 0.1;
 const int GlobalVariables::JoyButton::DEFAULTSPRINGRELEASERADIUS = 0;
+// Number of high resolution wheel units in one wheel click
+const int GlobalVariables::JoyButton::HIRESWHEELUNITS = 120;
 
 // Keep references to active keys and mouse buttons.
 QHash<int, int> GlobalVariables::JoyButton::activeKeys;
@@ -78,6 +80,10 @@ QList<double> GlobalVariables::JoyButton::mouseHistoryY;
 double GlobalVariables::JoyButton::cursorRemainderX = 0.0;
 double GlobalVariables::JoyButton::cursorRemainderY = 0.0;
 
+// Carry over partial high resolution wheel movement for the next mouse event.
+double GlobalVariables::JoyButton::wheelRemainderX = 0.0;
+double GlobalVariables::JoyButton::wheelRemainderY = 0.0;
+
 double GlobalVariables::JoyButton::weightModifier = 0;
 // Mouse history buffer size
 int GlobalVariables::JoyButton::mouseHistorySize = 1;
@@ -85,6 +91,7 @@ int GlobalVariables::JoyButton::mouseHistorySize = 1;
 int GlobalVariables::JoyButton::mouseRefreshRate = 5;
 int GlobalVariables::JoyButton::springModeScreen = -1;
 int GlobalVariables::JoyButton::gamepadRefreshRate = 10;
+bool GlobalVariables::JoyButton::hiResScroll = false;
 
 // ---- ANTIMICROSETTINGS --- //
 
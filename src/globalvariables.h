@@ -36,9 +36,13 @@ class JoyButton
     static int springModeScreen;
     // gamepad poll rate used by the application in ms
     static int gamepadRefreshRate;
+    // Scroll with high resolution wheel events instead of wheel clicks
+    static bool hiResScroll;
 
     static double cursorRemainderX;
     static double cursorRemainderY;
+    static double wheelRemainderX;
+    static double wheelRemainderY;
     static double mouseSpeedModifier;
     // Weight modifier in the range of 0.0 - 1.0
     static double weightModifier;
@@ -82,6 +86,7 @@ class JoyButton
     static const int MINCYCLERESETTIME;
     static const int MAXCYCLERESETTIME;
     static const int DEFAULTSPRINGRELEASERADIUS;
+    static const int HIRESWHEELUNITS;
 
     static QHash<int, int> activeKeys;
     static QHash<int, int> activeMouseButtons;
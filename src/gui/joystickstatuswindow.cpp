@@ -30,9 +30,11 @@
 #include <QDebug>
 #include <QGridLayout>
 #include <QHBoxLayout>
+#include <QHeaderView>
 #include <QLabel>
 #include <QProgressBar>
 #include <QSpacerItem>
+#include <QTableWidgetItem>
 #include <QVBoxLayout>
 #include <QWidget>
 
@@ -298,6 +300,17 @@ JoystickStatusWindow::JoystickStatusWindow(InputDevice *joystick, QWidget *paren
 
     PadderCommon::inputDaemonMutex.unlock();
 
+    QStringList counterHeaders = {tr("Element"), tr("Events"), tr("Events/s"), tr("Coalesced"), tr("Output"), tr("CPU ms")};
+    ui->countersTableWidget->setColumnCount(counterHeaders.size());
+    ui->countersTableWidget->setHorizontalHeaderLabels(counterHeaders);
+    ui->countersTableWidget->verticalHeader()->hide();
+    ui->countersTableWidget->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    countersTimer.setInterval(1000);
+    connect(&countersTimer, &QTimer::timeout, this, &JoystickStatusWindow::updateCounters);
+    updateCounters();
+    countersTimer.start();
+
     connect(joystick, &InputDevice::destroyed, this, &JoystickStatusWindow::obliterate);
     connect(this, &JoystickStatusWindow::finished, this, &JoystickStatusWindow::restoreButtonStates);
 }
@@ -341,4 +354,50 @@ void JoystickStatusWindow::updateGyroscopeValues(float valueX, float valueY, flo
     m_gyro_axes[2]->setValue(JoySensor::radToDeg(valueZ) * 1000);
 }
 
+/**
+ * @brief Refresh activity counters of device and its elements. Rate of
+ *  events is calculated from change since previous refresh.
+ */
+void JoystickStatusWindow::updateCounters()
+{
+    QList<ElementCountersEntry> entries = joystick->collectElementCounters();
+    ElementCountersEntry total = {tr("Total"), joystick->getCounterTotals(entries)};
+    entries.prepend(total);
+
+    double seconds = countersInterval.isValid() ? (countersInterval.restart() / 1000.0) : 0.0;
+
+    if (!countersInterval.isValid())
+        countersInterval.start();
+
+    ui->countersTableWidget->setRowCount(entries.size());
+
+    for (int row = 0; row < entries.size(); row++)
+    {
+        const ElementCountersEntry &entry = entries.at(row);
+        quint64 previous = lastReceived.value(entry.element, entry.values.received);
+        double rate = (seconds > 0.0) ? ((entry.values.received - previous) / seconds) : 0.0;
+        lastReceived.insert(entry.element, entry.values.received);
+
+        QStringList columns = {entry.element,
+                               QString::number(entry.values.received),
+                               QString::number(rate, 'f', 0),
+                               QString::number(entry.values.coalesced),
+                               QString::number(entry.values.output),
+                               QString::number(entry.values.processingNs / 1000000.0, 'f', 1)};
+
+        for (int column = 0; column < columns.size(); column++)
+        {
+            QTableWidgetItem *item = ui->countersTableWidget->item(row, column);
+
+            if (item == nullptr)
+            {
+                item = new QTableWidgetItem();
+                ui->countersTableWidget->setItem(row, column, item);
+            }
+
+            item->setText(columns.at(column));
+        }
+    }
+}
+
 InputDevice *JoystickStatusWindow::getJoystick() const { return joystick; }
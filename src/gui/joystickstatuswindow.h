@@ -20,6 +20,9 @@
 #define JOYSTICKSTATUSWINDOW_H
 
 #include <QDialog>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QTimer>
 
 class InputDevice;
 class QProgressBar;
@@ -50,11 +53,16 @@ class JoystickStatusWindow : public QDialog
     QProgressBar *m_accel_axes[3];
     QProgressBar *m_gyro_axes[3];
 
+    QTimer countersTimer;
+    QElapsedTimer countersInterval;
+    QHash<QString, quint64> lastReceived;
+
   private slots:
     void restoreButtonStates(int code);
     void obliterate();
     void updateAccelerometerValues(float valueX, float valueY, float valueZ);
     void updateGyroscopeValues(float valueX, float valueY, float valueZ);
+    void updateCounters();
 };
 
 #endif // JOYSTICKSTATUSWINDOW_H
@@ -905,6 +905,9 @@ void JoyTabWidget::changeJoyConfig(int index)
         qInfo() << "Change joystick " << m_joystick->getSDLName() << " profile to: " << filename;
     }
 
+    bool preloaded = !filename.isEmpty() && (filename == preloadedProfile);
+    preloadedProfile.clear();
+
     if (!filename.isEmpty())
     {
         removeCurrentButtons();
@@ -912,8 +915,11 @@ void JoyTabWidget::changeJoyConfig(int index)
 
         qDebug() << "SDL Current Power Level: " << SDL_JoystickCurrentPowerLevel(m_joystick->getJoyHandle()) << "\n";
 
-        if (SDL_JoystickCurrentPowerLevel(m_joystick->getJoyHandle()) == SDL_JOYSTICK_POWER_WIRED ||
-            SDL_JoystickCurrentPowerLevel(m_joystick->getJoyHandle()) == SDL_JOYSTICK_POWER_UNKNOWN)
+        if (preloaded)
+        {
+            qDebug() << "Profile already loaded at startup";
+        } else if (SDL_JoystickCurrentPowerLevel(m_joystick->getJoyHandle()) == SDL_JOYSTICK_POWER_WIRED ||
+                   SDL_JoystickCurrentPowerLevel(m_joystick->getJoyHandle()) == SDL_JOYSTICK_POWER_UNKNOWN)
         {
             QMetaObject::invokeMethod(&tabHelper, "readConfigFile", Qt::BlockingQueuedConnection, Q_ARG(QString, filename));
         } else
@@ -927,7 +933,7 @@ void JoyTabWidget::changeJoyConfig(int index)
         configBox->setItemText(0, tr("<New>"));
         XMLConfigReader *reader = tabHelper.getReader();
 
-        if (!reader->hasError())
+        if (preloaded || !reader->hasError())
         {
             QString profileName = QString();
             if (!m_joystick->getProfileName().isEmpty())
@@ -2586,6 +2592,12 @@ void JoyTabWidget::propogateMappingUpdate(QString mapping, InputDevice *device)
 
 void JoyTabWidget::refreshHelperThread() { tabHelper.moveToThread(m_joystick->thread()); }
 
+/**
+ * @brief Profile was already read into device before tab was created. It
+ *     is not read again when it gets selected as the last profile.
+ */
+void JoyTabWidget::setPreloadedProfile(const QString &fileLocation) { preloadedProfile = fileLocation; }
+
 void JoyTabWidget::changeEvent(QEvent *event)
 {
     if (event->type() == QEvent::LanguageChange)
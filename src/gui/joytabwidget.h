@@ -60,6 +60,7 @@ class JoyTabWidget : public QWidget
     void unloadConfig();                          // JoyTabSettings class
     void checkHideEmptyOption();
     void refreshHelperThread();
+    void setPreloadedProfile(const QString &fileLocation);
     void convToUniqueIDControllerGroupSett(QSettings *sett, QString guidControllerSett, QString uniqueControllerSett);
 
     bool isDisplayingNames();
@@ -223,6 +224,7 @@ class JoyTabWidget : public QWidget
     int comboBoxIndex = 0;
     bool hideEmptyButtons = false;
     QString oldProfileName;
+    QString preloadedProfile;
 
     JoyTabWidgetHelper tabHelper;
 
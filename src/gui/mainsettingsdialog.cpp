@@ -216,6 +216,8 @@ MainSettingsDialog::MainSettingsDialog(AntiMicroSettings *settings, QList<InputD
     if (attachedNumKeypad)
         ui->attachNumKeypadCheckbox->setChecked(true);
 
+    ui->hiResScrollCheckBox->setChecked(settings->value("Mouse/HiResScroll", false).toBool());
+
     bool smoothingEnabled = settings->value("Mouse/Smoothing", false).toBool();
     if (smoothingEnabled)
     {
@@ -637,6 +639,11 @@ void MainSettingsDialog::saveNewSettings()
         QMetaObject::invokeMethod(tempDevice, "haltServices", Qt::BlockingQueuedConnection);
     }
 
+    bool hiResScroll = ui->hiResScrollCheckBox->isChecked();
+    settings->setValue("Mouse/HiResScroll", hiResScroll ? "1" : "0");
+    JoyButton::setHiResScroll(hiResScroll && EventHandlerFactory::getInstance()->handler()->supportsHiResScroll(),
+                              GlobalVariables::JoyButton::hiResScroll);
+
     bool smoothingEnabled = ui->smoothingEnableCheckBox->isChecked();
     int historySize = ui->historySizeSpinBox->value();
     double weightModifier = ui->weightModifierDoubleSpinBox->value();
@@ -1987,6 +1994,7 @@ void MainSettingsDialog::resetAutoProfSett()
 void MainSettingsDialog::resetMouseSett()
 {
     ui->disableWindowsEnhancedPointCheckBox->setChecked(false);
+    ui->hiResScrollCheckBox->setChecked(false);
     ui->smoothingEnableCheckBox->setChecked(false);
     ui->smoothingEnableCheckBox->setEnabled(true);
     ui->historySizeSpinBox->setValue(10);
@@ -304,6 +304,12 @@ void MainWindow::alterConfigFromSettings()
 
 void MainWindow::fillButtons() { fillButtonsMap(m_joysticks); }
 
+/**
+ * @brief Profiles loaded before window was built. They are handed to device
+ *     tabs when tabs are filled for the first time.
+ */
+void MainWindow::setPreloadedProfiles(const QHash<SDL_JoystickID, QString> &profiles) { preloadedProfiles = profiles; }
+
 void MainWindow::makeJoystickTabs()
 {
     ui->stackedWidget->setCurrentIndex(0);
@@ -376,6 +382,7 @@ void MainWindow::fillButtonsMap(QMap<SDL_JoystickID, InputDevice *> *joysticks)
         InputDevice *joystick = iter.value();
 
         JoyTabWidget *tabwidget = new JoyTabWidget(joystick, m_settings, this);
+        tabwidget->setPreloadedProfile(preloadedProfiles.take(joystick->getSDLJoystickID()));
         QString joytabName = joystick->getSDLName();
         joytabName.append(" ").append(tr("(%1)").arg(joystick->getName()));
         ui->tabWidget->addTab(tabwidget, joytabName);
@@ -1055,6 +1062,27 @@ void MainWindow::handleInstanceDisconnect()
     loadAppConfig(true);
 }
 
+/**
+ * @brief Load profile for device on request of local socket client.
+ */
+void MainWindow::loadDeviceConfigFile(InputDevice *device, QString fileLocation)
+{
+    for (JoyTabWidget *tab : ui->tabWidget->findChildren<JoyTabWidget *>())
+    {
+        if (tab->getJoystick() == device)
+            tab->loadConfigFile(fileLocation);
+    }
+}
+
+void MainWindow::unloadDeviceConfig(InputDevice *device)
+{
+    for (JoyTabWidget *tab : ui->tabWidget->findChildren<JoyTabWidget *>())
+    {
+        if (tab->getJoystick() == device)
+            tab->unloadConfig();
+    }
+}
+
 void MainWindow::openJoystickStatusWindow()
 {
     int index = ui->tabWidget->currentIndex();
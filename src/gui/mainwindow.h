@@ -21,6 +21,7 @@
 
 #include <SDL2/SDL_joystick.h>
 
+#include <QHash>
 #include <QMainWindow>
 #include <QMap>
 #include <QSystemTrayIcon>
@@ -68,6 +69,7 @@ class MainWindow : public QMainWindow
     QTranslator *getAppTranslator() const;
 
     QMap<int, QList<QAction *>> const &getProfileActions();
+    void setPreloadedProfiles(const QHash<SDL_JoystickID, QString> &profiles);
 
     bool isKeypadUnlocked();
 
@@ -112,6 +114,8 @@ class MainWindow : public QMainWindow
     void addJoyTab(InputDevice *device);
     void selectControllerJoyTab(QString GUID);
     void handleInstanceDisconnect();
+    void loadDeviceConfigFile(InputDevice *device, QString fileLocation);
+    void unloadDeviceConfig(InputDevice *device);
 
   private slots:
     void refreshTrayIconMenu();
@@ -157,6 +161,7 @@ class MainWindow : public QMainWindow
 
     QMap<SDL_JoystickID, InputDevice *> *m_joysticks;
     QMap<int, QList<QAction *>> profileActions;
+    QHash<SDL_JoystickID, QString> preloadedProfiles;
 
     QSystemTrayIcon *trayIcon;
     QMenu *trayIconMenu;
@@ -0,0 +1,382 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "headlessdaemon.h"
+
+#include "antimicrosettings.h"
+#include "autoprofileinfo.h"
+#include "commandlineutility.h"
+#include "inputdevice.h"
+#include "logger.h"
+#include "uihelpers/joytabwidgethelper.h"
+#include "xmlconfigreader.h"
+
+#if defined(WITH_X11) || defined(Q_OS_WIN)
+    #include "autoprofilewatcher.h"
+#endif
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QThread>
+
+// Helpers live in input thread, wait for them like JoyTabWidget does
+static Qt::ConnectionType helperConnection(QObject *helper)
+{
+    return (helper->thread() == QThread::currentThread()) ? Qt::DirectConnection : Qt::BlockingQueuedConnection;
+}
+
+HeadlessDaemon::HeadlessDaemon(QMap<SDL_JoystickID, InputDevice *> *joysticks, CommandLineUtility *cmdutility,
+                               AntiMicroSettings *settings, QObject *parent)
+    : QObject(parent)
+    , m_joysticks(joysticks)
+    , m_cmdutility(cmdutility)
+    , m_settings(settings)
+    , appWatcher(nullptr)
+{
+#if defined(WITH_X11)
+    if (QGuiApplication::platformName() == QStringLiteral("xcb"))
+    {
+        appWatcher = new AutoProfileWatcher(settings, this);
+        connect(appWatcher, &AutoProfileWatcher::foundApplicableProfile, this, &HeadlessDaemon::autoprofileLoad);
+        checkAutoProfileWatcherTimer();
+    }
+#elif defined(Q_OS_WIN)
+    appWatcher = new AutoProfileWatcher(settings, this);
+    connect(appWatcher, &AutoProfileWatcher::foundApplicableProfile, this, &HeadlessDaemon::autoprofileLoad);
+    checkAutoProfileWatcherTimer();
+#endif
+}
+
+HeadlessDaemon::~HeadlessDaemon() { removeDevices(); }
+
+/**
+ * @brief Load last selected profile of every present device before GUI is
+ *     built, so controllers are usable while MainWindow is created. Device
+ *     tabs take over the loaded profiles instead of reading them again.
+ * @return Absolute path of profile loaded without error, per device
+ */
+QHash<SDL_JoystickID, QString> HeadlessDaemon::preloadLastProfiles(QMap<SDL_JoystickID, InputDevice *> *joysticks,
+                                                                   AntiMicroSettings *settings)
+{
+    QHash<SDL_JoystickID, QString> loaded;
+
+    for (InputDevice *device : *joysticks)
+    {
+        QString lastfile = lastProfileLocation(device, settings);
+
+        if (lastfile.isEmpty())
+            continue;
+
+        DeviceEntry entry;
+        entry.device = device;
+        entry.helper = new JoyTabWidgetHelper(device);
+        entry.helper->moveToThread(device->thread());
+
+        if (loadProfile(entry, lastfile))
+            loaded.insert(device->getSDLJoystickID(), entry.profile);
+
+        entry.helper->deleteLater();
+    }
+
+    return loaded;
+}
+
+/**
+ * @brief Load last selected profile of every present device and apply
+ *     profile options given on command line afterwards, in the same
+ *     order as MainWindow does.
+ */
+void HeadlessDaemon::loadDeviceProfiles()
+{
+    for (InputDevice *device : *m_joysticks)
+    {
+        if (!devices.contains(device->getSDLJoystickID()))
+            loadLastProfile(insertDevice(device));
+    }
+
+    applyCommandLine();
+}
+
+void HeadlessDaemon::addDevice(InputDevice *device)
+{
+    qInfo() << "Loading device settings for: " << device->getSDLName();
+    loadLastProfile(insertDevice(device));
+}
+
+void HeadlessDaemon::removeDevice(SDL_JoystickID deviceID)
+{
+    auto iter = devices.find(deviceID);
+
+    if (iter == devices.end())
+        return;
+
+    iter.value().helper->deleteLater();
+    QMetaObject::invokeMethod(iter.value().device, "finalRemoval");
+    devices.erase(iter);
+}
+
+/**
+ * @brief Another instance changed settings (e.g. selected profiles) and
+ *     closed connection. Apply them like MainWindow does.
+ */
+void HeadlessDaemon::handleInstanceDisconnect()
+{
+    m_settings->sync();
+
+    for (DeviceEntry &entry : devices)
+        loadLastProfile(entry);
+
+#if defined(WITH_X11) || defined(Q_OS_WIN)
+    if (appWatcher != nullptr)
+    {
+        appWatcher->syncProfileAssignment();
+        checkAutoProfileWatcherTimer();
+    }
+#endif
+}
+
+/**
+ * @brief Same rules as MainWindow::autoprofileLoad. Controller specific
+ *     assignments take precedence over the default for all controllers.
+ */
+void HeadlessDaemon::autoprofileLoad(AutoProfileInfo *info)
+{
+#if defined(WITH_X11) || defined(Q_OS_WIN)
+    if (info == nullptr)
+    {
+        qCritical() << QString("Auto-switching to nullptr profile!");
+        return;
+    }
+
+    qDebug() << QString("Auto-switching to profile \"%1\".").arg(info->getProfileLocation());
+
+    for (DeviceEntry &entry : devices)
+    {
+        bool applies = false;
+
+        if (info->getUniqueID() == "all")
+        {
+            QList<AutoProfileInfo *> *customs = appWatcher->getCustomDefaults();
+            applies = true;
+
+            for (AutoProfileInfo *tempinfo : *customs)
+            {
+                if ((tempinfo->getUniqueID() == entry.device->getUniqueIDString()) && info->isCurrentDefault())
+                    applies = false;
+            }
+
+            delete customs;
+            customs = nullptr;
+
+            if (applies && appWatcher->isUniqueIDLocked(entry.device->getUniqueIDString()))
+                applies = false;
+        } else if (info->getUniqueID() == entry.device->getStringIdentifier())
+        {
+            applies = true;
+        }
+
+        if (!applies)
+            continue;
+
+        // Empty profile location means that device should be unloaded
+        if (info->getProfileLocation().isEmpty())
+            unloadProfile(entry);
+        else
+            loadProfile(entry, info->getProfileLocation());
+    }
+#else
+    Q_UNUSED(info);
+#endif
+}
+
+void HeadlessDaemon::loadDeviceProfile(InputDevice *device, QString fileLocation)
+{
+    auto iter = devices.find(device->getSDLJoystickID());
+
+    if (iter != devices.end())
+        loadProfile(iter.value(), fileLocation);
+}
+
+void HeadlessDaemon::unloadDeviceProfile(InputDevice *device)
+{
+    auto iter = devices.find(device->getSDLJoystickID());
+
+    if (iter != devices.end())
+        unloadProfile(iter.value());
+}
+
+/**
+ * @brief Delete profile helpers. Called before input thread is stopped.
+ */
+void HeadlessDaemon::removeDevices()
+{
+    for (DeviceEntry &entry : devices)
+        entry.helper->deleteLater();
+
+    devices.clear();
+}
+
+HeadlessDaemon::DeviceEntry &HeadlessDaemon::insertDevice(InputDevice *device)
+{
+    DeviceEntry entry;
+    entry.device = device;
+    entry.helper = new JoyTabWidgetHelper(device);
+    entry.helper->moveToThread(device->thread());
+
+    return devices.insert(device->getSDLJoystickID(), entry).value();
+}
+
+void HeadlessDaemon::loadLastProfile(DeviceEntry &entry)
+{
+    QString lastfile = lastProfileLocation(entry.device, m_settings);
+
+    if (lastfile.isEmpty() || !loadProfile(entry, lastfile))
+        unloadProfile(entry);
+}
+
+QString HeadlessDaemon::lastProfileLocation(InputDevice *device, AntiMicroSettings *settings)
+{
+    QString lastfile = QString();
+
+    settings->getLock()->lock();
+
+    bool autoOpenLastProfile = settings->value("AutoOpenLastProfile", true).toBool();
+
+    if (!device->getStringIdentifier().isEmpty() && autoOpenLastProfile)
+    {
+        QString controlEntryLastSelected =
+            QString("Controllers/Controller%1LastSelected").arg(device->getStringIdentifier());
+        lastfile = settings->value(controlEntryLastSelected, "").toString();
+    }
+
+    settings->getLock()->unlock();
+
+    return lastfile;
+}
+
+/**
+ * @brief Read profile for device in thread of the device. Nothing is done
+ *     when the same profile is already active.
+ * @return true when profile is active afterwards
+ */
+bool HeadlessDaemon::loadProfile(DeviceEntry &entry, const QString &fileLocation)
+{
+    QFileInfo fileinfo(fileLocation);
+
+    if (!fileinfo.exists() || ((fileinfo.suffix() != "xml") && (fileinfo.suffix() != "amgp")))
+    {
+        qWarning() << "Profile " << fileLocation << " does not exist or has wrong extension";
+        return false;
+    }
+
+    QString filename = fileinfo.absoluteFilePath();
+
+    if (filename == entry.profile)
+        return true;
+
+    qInfo() << "Change joystick " << entry.device->getSDLName() << " profile to: " << filename;
+
+    bool result = false;
+    QMetaObject::invokeMethod(entry.helper, "readConfigFile", helperConnection(entry.helper), Q_RETURN_ARG(bool, result),
+                              Q_ARG(QString, filename));
+
+    // Device could be partially configured, keep profile so it can be unloaded
+    entry.profile = filename;
+
+    if (!result)
+        PRINT_STDERR() << entry.helper->getReader()->getErrorString() << "\n";
+
+    return result;
+}
+
+void HeadlessDaemon::unloadProfile(DeviceEntry &entry)
+{
+    if (entry.profile.isEmpty())
+        return;
+
+    QMetaObject::invokeMethod(entry.helper, "reInitDevice", helperConnection(entry.helper));
+    entry.profile.clear();
+}
+
+/**
+ * @brief Counterpart of MainWindow::alterConfigFromSettings
+ */
+void HeadlessDaemon::applyCommandLine()
+{
+    if (m_cmdutility->hasProfile())
+    {
+        for (DeviceEntry *entry : matchingDevices(m_cmdutility->getControllerNumber(), m_cmdutility->getControllerID()))
+            loadProfile(*entry, m_cmdutility->getProfileLocation());
+    }
+
+    for (ControllerOptionsInfo temp : m_cmdutility->getControllerOptionsList())
+    {
+        QList<DeviceEntry *> entries = matchingDevices(temp.getControllerNumber(), temp.getControllerID());
+
+        for (DeviceEntry *entry : entries)
+        {
+            if (temp.hasProfile())
+                loadProfile(*entry, temp.getProfileLocation());
+            else if (temp.isUnloadRequested())
+                unloadProfile(*entry);
+
+            if (temp.getStartSetNumber() > 0)
+                QMetaObject::invokeMethod(entry->device, "setActiveSetNumber", helperConnection(entry->device),
+                                          Q_ARG(int, temp.getJoyStartSetNumber()));
+        }
+    }
+}
+
+void HeadlessDaemon::checkAutoProfileWatcherTimer()
+{
+#if defined(WITH_X11) || defined(Q_OS_WIN)
+    QString autoProfileActive = m_settings->value("AutoProfiles/AutoProfilesActive", "0").toString();
+
+    if (autoProfileActive == "1")
+        appWatcher->startTimer();
+    else
+        appWatcher->stopTimer();
+#endif
+}
+
+/**
+ * @brief Devices selected by controller number (starting from 1) or by
+ *     identifier. All devices are returned when none of them is given.
+ */
+QList<HeadlessDaemon::DeviceEntry *> HeadlessDaemon::matchingDevices(int controllerNumber, const QString &controllerID)
+{
+    QList<DeviceEntry *> result;
+
+    for (DeviceEntry &entry : devices)
+    {
+        if (controllerNumber > 0)
+        {
+            if (entry.device->getRealJoyNumber() == controllerNumber)
+                result.append(&entry);
+        } else if (!controllerID.isEmpty())
+        {
+            if (entry.device->getStringIdentifier() == controllerID)
+                result.append(&entry);
+        } else
+        {
+            result.append(&entry);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,87 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HEADLESSDAEMON_H
+#define HEADLESSDAEMON_H
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QObject>
+
+#include <SDL2/SDL_joystick.h>
+
+class AntiMicroSettings;
+class AutoProfileInfo;
+class AutoProfileWatcher;
+class CommandLineUtility;
+class InputDevice;
+class JoyTabWidgetHelper;
+
+/**
+ * @brief Profile handling used instead of MainWindow when program runs
+ *     with --headless. Loads last selected profiles, applies command line
+ *     options and auto profiles without creating any widget. Other
+ *     instances control it through the local socket like the GUI.
+ */
+class HeadlessDaemon : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit HeadlessDaemon(QMap<SDL_JoystickID, InputDevice *> *joysticks, CommandLineUtility *cmdutility,
+                            AntiMicroSettings *settings, QObject *parent = nullptr);
+    ~HeadlessDaemon();
+
+    static QHash<SDL_JoystickID, QString> preloadLastProfiles(QMap<SDL_JoystickID, InputDevice *> *joysticks,
+                                                              AntiMicroSettings *settings);
+
+  public slots:
+    void loadDeviceProfiles();
+    void addDevice(InputDevice *device);
+    void removeDevice(SDL_JoystickID deviceID);
+    void handleInstanceDisconnect();
+    void autoprofileLoad(AutoProfileInfo *info);
+    void loadDeviceProfile(InputDevice *device, QString fileLocation);
+    void unloadDeviceProfile(InputDevice *device);
+    void removeDevices();
+
+  private:
+    struct DeviceEntry
+    {
+        InputDevice *device;
+        JoyTabWidgetHelper *helper;
+        QString profile;
+    };
+
+    DeviceEntry &insertDevice(InputDevice *device);
+    void loadLastProfile(DeviceEntry &entry);
+    static QString lastProfileLocation(InputDevice *device, AntiMicroSettings *settings);
+    static bool loadProfile(DeviceEntry &entry, const QString &fileLocation);
+    void unloadProfile(DeviceEntry &entry);
+    void applyCommandLine();
+    void checkAutoProfileWatcherTimer();
+    QList<DeviceEntry *> matchingDevices(int controllerNumber, const QString &controllerID);
+
+    QMap<SDL_JoystickID, InputDevice *> *m_joysticks;
+    CommandLineUtility *m_cmdutility;
+    AntiMicroSettings *m_settings;
+    AutoProfileWatcher *appWatcher;
+    QHash<SDL_JoystickID, DeviceEntry> devices;
+};
+
+#endif // HEADLESSDAEMON_H
@@ -20,43 +20,78 @@
 
 #include "antimicrosettings.h"
 #include "common.h"
+#include "eventhandlerfactory.h"
+#include "gamecontroller/gamecontrollermappingstore.h"
+#include "gamecontroller/virtualgamecontroller.h"
 #include "globalvariables.h"
 #include "inputdevicebitarraystatus.h"
+#include "inputdevicebuilder.h"
+#include "inputtracerecorder.h"
+#include "joybuttontypes/joyaxisbutton.h"
+#include "joybuttontypes/joycontrolstickbutton.h"
+#include "joycontrolstick.h"
 #include "joydpad.h"
 #include "joysensor.h"
 #include "joystick.h"
 #include "logger.h"
 #include "sdleventreader.h"
+#include "startuptrace.h"
+#include "virtualjoystick.h"
 
 #include <QDebug>
 #include <QEventLoop>
 #include <QMapIterator>
+#include <QMutexLocker>
 #include <QThread>
 #include <QTime>
 #include <QTimer>
 
+#include <cmath>
+
+// SDL counts instance ids up from 0 and never reuses them, start far above
+static const SDL_JoystickID VIRTUAL_DEVICE_ID_BASE = 0x1000;
+
 InputDaemon::InputDaemon(QMap<SDL_JoystickID, InputDevice *> *joysticks, AntiMicroSettings *settings, bool graphical,
                          QObject *parent)
     : QObject(parent)
     , pollResetTimer(this)
+    , traceRecorder(nullptr)
 {
     m_joysticks = joysticks;
     // Xbox360Wireless* xbox360class = new Xbox360Wireless();
     // xbox360 = xbox360class->getResult();
     this->stopped = false;
+    this->firstPollTraced = false;
+    this->keepAxisPeaks = false;
+    this->nextVirtualDeviceID = VIRTUAL_DEVICE_ID_BASE;
     m_graphical = graphical;
     m_settings = settings;
 
+    if (m_graphical)
+    {
+        connect(this, &InputDaemon::deviceAdded, this, &InputDaemon::attachOutputDevice);
+        connect(this, &InputDaemon::deviceRemoved, this, &InputDaemon::detachOutputDevice);
+    }
+
     eventWorker = new SDLEventReader(joysticks, settings);
     refreshJoysticks();
     sdlWorkerThread = nullptr;
 
+    deviceBuilder = new InputDeviceBuilder(settings);
+    deviceBuilderThread = nullptr;
+    connect(deviceBuilder, &InputDeviceBuilder::deviceBuilt, this, &InputDaemon::attachBuiltDevice);
+
     if (m_graphical)
     {
         sdlWorkerThread = new QThread;
         sdlWorkerThread->setObjectName("sdlWorkerThread");
         eventWorker->moveToThread(sdlWorkerThread);
 
+        deviceBuilderThread = new QThread;
+        deviceBuilderThread->setObjectName("deviceBuilderThread");
+        deviceBuilder->moveToThread(deviceBuilderThread);
+        connect(deviceBuilderThread, &QThread::finished, deviceBuilder, &QObject::deleteLater);
+
         connect(sdlWorkerThread, &QThread::started, eventWorker, &SDLEventReader::performWork);
         connect(eventWorker, &SDLEventReader::eventRaised, this, &InputDaemon::run);
 
@@ -90,17 +125,108 @@ InputDaemon::~InputDaemon()
         sdlWorkerThread->deleteLater();
         sdlWorkerThread = nullptr;
     }
+
+    if (deviceBuilderThread != nullptr)
+    {
+        // Builder is deleted when its thread finishes
+        deviceBuilderThread->quit();
+        deviceBuilderThread->wait();
+        deviceBuilderThread->deleteLater();
+        deviceBuilderThread = nullptr;
+    } else
+    {
+        delete deviceBuilder;
+    }
+
+    deviceBuilder = nullptr;
+
+    delete traceRecorder;
+    traceRecorder = nullptr;
+}
+
+/**
+ * @brief Keep lowest and highest value of axis events coalesced in one
+ *     poll besides the latest one.
+ */
+void InputDaemon::setKeepAxisPeaks(bool enabled) { keepAxisPeaks = enabled; }
+
+/**
+ * @brief Let SDL worker lower its poll rate while all devices are idle.
+ *     Has to be called before the worker is started.
+ */
+void InputDaemon::setAdaptivePolling(bool enabled)
+{
+    if (eventWorker != nullptr)
+        eventWorker->setAdaptivePolling(enabled);
+}
+
+/**
+ * @brief Open a device without SDL handle. Events pushed into the SDL
+ *     queue with returned instance id are processed like events of
+ *     hardware. Element counts are used by joysticks only, game
+ *     controllers have the standard layout. Has to be called from thread
+ *     of the daemon.
+ */
+SDL_JoystickID InputDaemon::addVirtualDevice(bool gameController, const QString &name, const QString &guid,
+                                             const QString &uniqueID, int buttons, int axes, int hats)
+{
+    SDL_JoystickID deviceID = nextVirtualDeviceID++;
+    int deviceIndex = m_joysticks->size();
+    InputDevice *device = nullptr;
+
+    if (gameController)
+    {
+        VirtualGameController *controller =
+            new VirtualGameController(deviceID, deviceIndex, name, guid, uniqueID, m_settings, this);
+        trackcontrollers.insert(deviceID, controller);
+        device = controller;
+    } else
+    {
+        VirtualJoystick *joystick =
+            new VirtualJoystick(deviceID, deviceIndex, name, guid, uniqueID, buttons, axes, hats, m_settings, this);
+        getTrackjoysticksLocal().insert(deviceID, joystick);
+        device = joystick;
+    }
+
+    m_joysticks->insert(deviceID, device);
+    rebuildRoutes();
+
+    qInfo() << "Virtual device " << name << " added as " << deviceID;
+
+    emit deviceAdded(device);
+    return deviceID;
+}
+
+/**
+ * @brief Record input events of opened devices into file until the
+ *     daemon is deleted.
+ */
+bool InputDaemon::startInputRecording(const QString &fileName)
+{
+    if (traceRecorder == nullptr)
+        traceRecorder = new InputTraceRecorder();
+
+    return traceRecorder->open(fileName);
 }
 
 void InputDaemon::startWorker()
 {
     if (!sdlWorkerThread->isRunning())
         sdlWorkerThread->start(QThread::HighPriority);
+
+    if (!deviceBuilderThread->isRunning())
+        deviceBuilderThread->start(QThread::LowPriority);
 }
 
 void InputDaemon::run()
 {
-    PadderCommon::inputDaemonMutex.lock();
+    QMutexLocker locker(&PadderCommon::inputDaemonMutex);
+
+    if (!firstPollTraced)
+    {
+        StartupTrace::mark("first input poll");
+        firstPollTraced = true;
+    }
 
     // SDL has found events. The timeout is not necessary.
     pollResetTimer.stop();
@@ -109,11 +235,17 @@ void InputDaemon::run()
     {
         JoyButton::resetActiveButtonMouseDistances(JoyButton::getMouseHelper());
 
+        BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+        handler->beginOutputBatch();
+
         QQueue<SDL_Event> sdlEventQueue;
         firstInputPass(&sdlEventQueue);
         modifyUnplugEvents(&sdlEventQueue);
+        coalesceAxisEvents(&sdlEventQueue);
         secondInputPass(&sdlEventQueue);
         clearBitArrayStatusInstances();
+
+        handler->flushOutputBatch();
     }
 
     if (stopped)
@@ -125,11 +257,13 @@ void InputDaemon::run()
         stopped = false;
     } else
     {
+        // Scanning devices is only needed to let adaptive polling back off
+        if (eventWorker->isAdaptivePolling())
+            eventWorker->setInputsActive(hasActiveInputs());
+
         QTimer::singleShot(0, eventWorker, SLOT(performWork()));
         pollResetTimer.start();
     }
-
-    PadderCommon::inputDaemonMutex.unlock();
 }
 
 QString InputDaemon::getJoyInfo(SDL_JoystickGUID sdlvalue)
@@ -160,6 +294,9 @@ void InputDaemon::refreshJoysticks()
 
         if (joystick != nullptr)
         {
+            if (m_graphical)
+                detachOutputDevice(iter.key());
+
             m_joysticks->remove(iter.key());
             joystick->deleteLater();
         }
@@ -168,6 +305,7 @@ void InputDaemon::refreshJoysticks()
     m_joysticks->clear();
     getTrackjoysticksLocal().clear();
     trackcontrollers.clear();
+    routes.clear();
 
     m_settings->getLock()->lock();
     m_settings->beginGroup("Mappings");
@@ -180,6 +318,11 @@ void InputDaemon::refreshJoysticks()
     {
         int index = i;
 
+        if (isOwnVirtualDevice(index))
+            continue;
+
+        GameControllerMappingStore::registerDevice(index);
+
         // Check if device is considered a Game Controller at the start.
         if (SDL_IsGameController(index))
         {
@@ -253,6 +396,8 @@ void InputDaemon::refreshJoysticks()
     m_settings->endGroup();
     m_settings->getLock()->unlock();
 
+    rebuildRoutes();
+
     emit joysticksRefreshed(m_joysticks);
 }
 
@@ -362,6 +507,7 @@ void InputDaemon::refreshMapping(QString mapping, InputDevice *device)
                     device->closeSDLDevice();
                     getTrackjoysticksLocal().remove(joystickID);
                     m_joysticks->remove(joystickID);
+                    rebuildRoutes();
 
                     SDL_GameController *controller = SDL_GameControllerOpen(i);
 
@@ -390,6 +536,7 @@ void InputDaemon::refreshMapping(QString mapping, InputDevice *device)
                     joystickID = SDL_JoystickInstanceID(sdlStick);
                     m_joysticks->insert(joystickID, damncontroller);
                     trackcontrollers.insert(joystickID, damncontroller);
+                    rebuildRoutes();
                     emit deviceUpdated(i, damncontroller);
                 }
             }
@@ -409,6 +556,7 @@ void InputDaemon::removeDevice(InputDevice *device)
         m_joysticks->remove(deviceID);
         getTrackjoysticksLocal().remove(deviceID);
         trackcontrollers.remove(deviceID);
+        rebuildRoutes();
 
         refreshIndexes();
 
@@ -416,15 +564,24 @@ void InputDaemon::removeDevice(InputDevice *device)
     }
 }
 
+/**
+ * @brief Virtual gamepads created by the event handler are reported by SDL
+ *     as new game controllers. They are never opened, otherwise every one
+ *     of them would get a virtual gamepad of its own and pass our output
+ *     back through the program.
+ */
+bool InputDaemon::isOwnVirtualDevice(int index)
+{
+    const char *name = SDL_JoystickNameForIndex(index);
+    return (name != nullptr) && QString::fromUtf8(name).startsWith(PadderCommon::gamepadDeviceName);
+}
+
 void InputDaemon::refreshIndexes()
 {
     for (int i = 0; i < SDL_NumJoysticks(); i++)
-    // for (int i = 0; i < 1; i++)
     {
-        SDL_Joystick *joystick = SDL_JoystickOpen(i);
-        // SDL_Joystick *joystick = xbox360;
-        SDL_JoystickID joystickID = SDL_JoystickInstanceID(joystick);
-        SDL_JoystickClose(joystick); // Make sure to decrement reference count
+        // Instance id can be read without opening the device
+        SDL_JoystickID joystickID = SDL_JoystickGetDeviceInstanceID(i);
         InputDevice *tempdevice = m_joysticks->value(joystickID);
 
         if (tempdevice != nullptr)
@@ -432,199 +589,42 @@ void InputDaemon::refreshIndexes()
     }
 }
 
-void InputDaemon::addInputDevice(int index, QMap<QString, int> &uniques, int &counterUniques, bool &duplicatedGamepad)
+/**
+ * @brief Take over device built by InputDeviceBuilder. Devices which were
+ *     opened in the meantime or are already unplugged are dropped.
+ */
+void InputDaemon::attachBuiltDevice(InputDevice *device)
 {
-#ifdef USE_NEW_ADD
-    // Check if device is considered a Game Controller at the start.
-    if (SDL_IsGameController(index))
-    {
-        SDL_GameController *controller = SDL_GameControllerOpen(index);
-        if (controller != nullptr)
-        {
-            SDL_Joystick *sdlStick = SDL_GameControllerGetJoystick(controller);
-            SDL_JoystickID tempJoystickID = SDL_JoystickInstanceID(sdlStick);
-
-            // Check if device has already been grabbed.
-            if (!m_joysticks->contains(tempJoystickID))
-            {
-                m_settings->getLock()->lock();
-                m_settings->beginGroup("Mappings");
-
-                QString temp = QString();
-                SDL_JoystickGUID tempGUID = SDL_JoystickGetGUID(sdlStick);
-                char guidString[65] = {'0'};
-                SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
-                temp = QString(guidString);
-
-                bool disableGameController = m_settings->value(QString("%1Disable").arg(temp), false).toBool();
-
-                m_settings->endGroup();
-                m_settings->getLock()->unlock();
-
-                // Check if user has designated device Joystick mode.
-                if (!disableGameController)
-                {
-                    GameController *damncontroller = new GameController(controller, index, m_settings, this);
-                    connect(damncontroller, &GameController::requestWait, eventWorker, &SDLEventReader::haltServices);
-                    m_joysticks->insert(tempJoystickID, damncontroller);
-                    trackcontrollers.insert(tempJoystickID, damncontroller);
+    SDL_JoystickID deviceID = device->getSDLJoystickID();
 
-                    qInfo() << QString("New game controller found - #%1 [%2]".arg(index + 1).arg(
-                        QTime::currentTime().toString("hh:mm:ss.zzz")));
+    if (m_joysticks->contains(deviceID) || !SDL_JoystickGetAttached(device->getJoyHandle()))
+    {
+        device->closeSDLDevice();
+        device->deleteLater();
+        return;
+    }
 
-                    emit deviceAdded(damncontroller);
-                } else
-                {
-                    // Check if joystick is considered connected.
+    device->setParent(this);
+    m_joysticks->insert(deviceID, device);
 
-                    Joystick *joystick = openJoystickDevice(index);
-                    if (joystick != nullptr)
-                    {
-                        qInfo() << QString("New joystick found - #%1 [%2]".arg(index + 1).arg(
-                            QTime::currentTime().toString("hh:mm:ss.zzz")));
+    GameController *controller = qobject_cast<GameController *>(device);
 
-                        emit deviceAdded(joystick);
-                    }
-                }
-            } else
-            {
-                // Make sure to decrement reference count
-                SDL_GameControllerClose(controller);
-            }
-        }
+    if (controller != nullptr)
+    {
+        connect(controller, &GameController::requestWait, eventWorker, &SDLEventReader::haltServices);
+        trackcontrollers.insert(deviceID, controller);
     } else
     {
-        Joystick *joystick = openJoystickDevice(index);
-        if (joystick != nullptr)
-        {
-            Logger::LogInfo(
-                QString("New joystick found - #%1 [%2]").arg(index + 1).arg(QTime::currentTime().toString("hh:mm:ss.zzz")));
-
-            emit deviceAdded(joystick);
-        }
+        getTrackjoysticksLocal().insert(deviceID, qobject_cast<Joystick *>(device));
     }
-#else
-    SDL_GameController *controller = SDL_GameControllerOpen(index);
-    SDL_Joystick *joystick = SDL_JoystickOpen(index);
-
-    // SDL_Joystick *joystick = xbox360;
-    // SDL_GameController *controller = SDL_GameControllerFromInstanceID(xbox360->instance_id);
-
-    if (joystick != nullptr)
-    {
-        SDL_JoystickID tempJoystickID_local = SDL_JoystickInstanceID(joystick);
-
-        if (!m_joysticks->contains(tempJoystickID_local))
-        {
-            m_settings->getLock()->lock();
-            m_settings->beginGroup("Mappings");
-
-            //            QString temp = QString();
-            //            SDL_JoystickGUID tempGUID = SDL_JoystickGetGUID(joystick);
-            //            char guidString[65] = {'0'};
-            //            SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
-            //            temp = QString(guidString);
-
-            //            bool disableGameController = m_settings->value(QString("%1Disable").arg(temp), false).toBool();
-
-            QString guidText = QString();
-
-            SDL_JoystickGUID tempGUID = SDL_JoystickGetGUID(joystick);
-            char guidString[65] = {'0'};
-            SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
-            guidText = QString(guidString);
-
-            QString vendor = QString();
-
-            if (controller != nullptr)
-            {
-                Uint16 tempVendor = SDL_GameControllerGetVendor(controller);
-                char buffer[50];
-                sprintf(buffer, "%u", tempVendor);
-
-                vendor = QString(buffer);
-            }
-
-            QString productID = QString();
-
-            if (controller != nullptr)
-            {
-                Uint16 tempProduct = SDL_GameControllerGetProduct(controller);
-                char buffer[50];
-                sprintf(buffer, "%u", tempProduct);
-
-                productID = QString(buffer);
-            }
-
-            if (uniques.contains(guidText))
-            {
-                productID = getJoyInfo(SDL_GameControllerGetProduct(controller) + ++uniques[guidText]);
-                duplicatedGamepad = true;
-                uniques.insert(guidText, uniques[guidText]);
-            } else
-            {
-                uniques.insert(guidText, counterUniques);
-            }
-
-            convertMappingsToUnique(m_settings, guidText, guidText + vendor + productID);
-
-            int resultDuplicated = 0;
-            if (duplicatedGamepad)
-                resultDuplicated = uniques[guidText];
-
-            bool disableGameController =
-                m_settings->value(QString("%1Disable").arg(guidText + vendor + productID), false).toBool();
-
-            if (SDL_IsGameController(index) && !disableGameController)
-            {
-                // Make sure to decrement reference count
-                SDL_JoystickClose(joystick);
-
-                SDL_GameController *controller = SDL_GameControllerOpen(index);
-
-                if (controller != nullptr)
-                {
-                    SDL_Joystick *sdlStick = SDL_GameControllerGetJoystick(controller);
-                    SDL_JoystickID tempJoystickID_local_2 = SDL_JoystickInstanceID(sdlStick);
-
-                    if (!m_joysticks->contains(tempJoystickID_local_2))
-                    {
-                        GameController *damncontroller =
-                            new GameController(controller, index, m_settings, resultDuplicated, this);
-                        connect(damncontroller, &GameController::requestWait, eventWorker, &SDLEventReader::haltServices);
-                        m_joysticks->insert(tempJoystickID_local_2, damncontroller);
-                        trackcontrollers.insert(tempJoystickID_local_2, damncontroller);
 
-                        m_settings->endGroup();
-                        m_settings->getLock()->unlock();
+    rebuildRoutes();
 
-                        emit deviceAdded(damncontroller);
-                    }
+    qInfo() << QString("New device found - #%1 [%2]")
+                   .arg(device->getRealJoyNumber())
+                   .arg(QTime::currentTime().toString("hh:mm:ss.zzz"));
 
-                    duplicatedGamepad = false;
-                } else
-                {
-                    m_settings->endGroup();
-                    m_settings->getLock()->unlock();
-                }
-            } else
-            {
-                Joystick *curJoystick = new Joystick(joystick, index, m_settings, this);
-                m_joysticks->insert(tempJoystickID_local, curJoystick);
-                getTrackjoysticksLocal().insert(tempJoystickID_local, curJoystick);
-
-                m_settings->endGroup();
-                m_settings->getLock()->unlock();
-
-                emit deviceAdded(curJoystick);
-            }
-        } else
-        {
-            // Make sure to decrement reference count
-            SDL_JoystickClose(joystick);
-        }
-    }
-#endif
+    emit deviceAdded(device);
 }
 
 Joystick *InputDaemon::openJoystickDevice(int index)
@@ -640,29 +640,12 @@ Joystick *InputDaemon::openJoystickDevice(int index)
         curJoystick = new Joystick(joystick, index, m_settings, this);
         m_joysticks->insert(tempJoystickID, curJoystick);
         getTrackjoysticksLocal().insert(tempJoystickID, curJoystick);
+        rebuildRoutes();
     }
 
     return curJoystick;
 }
 
-InputDeviceBitArrayStatus *
-InputDaemon::createOrGrabBitStatusEntry(QHash<InputDevice *, InputDeviceBitArrayStatus *> *statusHash, InputDevice *device,
-                                        bool readCurrent)
-{
-    InputDeviceBitArrayStatus *bitArrayStatus = nullptr;
-
-    if (!statusHash->contains(device))
-    {
-        bitArrayStatus = new InputDeviceBitArrayStatus(device, readCurrent, this);
-        statusHash->insert(device, bitArrayStatus);
-    } else
-    {
-        bitArrayStatus = statusHash->value(device);
-    }
-
-    return bitArrayStatus;
-}
-
 /**
  * @brief Fetches events from SDL event queue, filters them and
  *  updates InputDeviceBitArrayStatus.
@@ -673,6 +656,9 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
     while (SDL_PollEvent(&event) > 0)
     {
+        if (traceRecorder != nullptr)
+            recordTraceEvent(event);
+
         if (Logger::isDebugEnabled())
         {
             const QMap<Uint32, QString> STRING_MAP = {
@@ -709,7 +695,8 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
         {
         case SDL_JOYBUTTONDOWN:
         case SDL_JOYBUTTONUP: {
-            InputDevice *joy = getTrackjoysticksLocal().value(event.jbutton.which);
+            const DeviceRoute &route = getRoute(event.jbutton.which);
+            InputDevice *joy = route.joystick;
 
             if (joy != nullptr)
             {
@@ -718,8 +705,8 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                 if (button != nullptr)
                 {
-                    InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
-                    pending->changeButtonStatus(event.jbutton.button, event.type == SDL_JOYBUTTONDOWN ? true : false);
+                    route.pendingStatus->changeButtonStatus(event.jbutton.button,
+                                                            event.type == SDL_JOYBUTTONDOWN ? true : false);
                     sdlEventQueue->append(event);
                 }
             } else
@@ -730,7 +717,8 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
             break;
         }
         case SDL_JOYAXISMOTION: {
-            InputDevice *joy = getTrackjoysticksLocal().value(event.jaxis.which);
+            const DeviceRoute &route = getRoute(event.jaxis.which);
+            InputDevice *joy = route.joystick;
 
             if (joy != nullptr)
             {
@@ -739,11 +727,9 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                 if (axis != nullptr)
                 {
-                    InputDeviceBitArrayStatus *temp = createOrGrabBitStatusEntry(&releaseEventsGenerated, joy, false);
-                    temp->changeAxesStatus(event.jaxis.axis, event.jaxis.axis == 0);
+                    route.releaseStatus->changeAxesStatus(event.jaxis.axis, event.jaxis.axis == 0);
 
-                    InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
-                    pending->changeAxesStatus(event.jaxis.axis, !axis->inDeadZone(event.jaxis.value));
+                    route.pendingStatus->changeAxesStatus(event.jaxis.axis, !axis->inDeadZone(event.jaxis.value));
                     sdlEventQueue->append(event);
                 }
             } else
@@ -754,7 +740,8 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
             break;
         }
         case SDL_JOYHATMOTION: {
-            InputDevice *joy = getTrackjoysticksLocal().value(event.jhat.which);
+            const DeviceRoute &route = getRoute(event.jhat.which);
+            InputDevice *joy = route.joystick;
 
             if (joy != nullptr)
             {
@@ -763,8 +750,7 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                 if (dpad != nullptr)
                 {
-                    InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
-                    pending->changeHatStatus(event.jhat.hat, (event.jhat.value != 0) ? true : false);
+                    route.pendingStatus->changeHatStatus(event.jhat.hat, (event.jhat.value != 0) ? true : false);
                     sdlEventQueue->append(event);
                 }
             } else
@@ -776,7 +762,8 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
         }
 
         case SDL_CONTROLLERAXISMOTION: {
-            InputDevice *joy = trackcontrollers.value(event.caxis.which);
+            const DeviceRoute &route = getRoute(event.caxis.which);
+            InputDevice *joy = route.controller;
 
             if (joy != nullptr)
             {
@@ -785,21 +772,18 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                 if (axis != nullptr)
                 {
-                    InputDeviceBitArrayStatus *temp = createOrGrabBitStatusEntry(&releaseEventsGenerated, joy, false);
-
                     if ((event.caxis.axis != SDL_CONTROLLER_AXIS_TRIGGERLEFT) &&
                         (event.caxis.axis != SDL_CONTROLLER_AXIS_TRIGGERRIGHT))
                     {
-                        temp->changeAxesStatus(event.caxis.axis, event.caxis.value == 0);
+                        route.releaseStatus->changeAxesStatus(event.caxis.axis, event.caxis.value == 0);
                     } else
                     {
-                        temp->changeAxesStatus(event.caxis.axis,
-                                               event.caxis.value ==
-                                                   GlobalVariables::InputDaemon::GAMECONTROLLERTRIGGERRELEASE);
+                        route.releaseStatus->changeAxesStatus(
+                            event.caxis.axis,
+                            event.caxis.value == GlobalVariables::InputDaemon::GAMECONTROLLERTRIGGERRELEASE);
                     }
 
-                    InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
-                    pending->changeAxesStatus(event.caxis.axis, !axis->inDeadZone(event.caxis.value));
+                    route.pendingStatus->changeAxesStatus(event.caxis.axis, !axis->inDeadZone(event.caxis.value));
                     sdlEventQueue->append(event);
                 }
             }
@@ -808,7 +792,8 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
 #if SDL_VERSION_ATLEAST(2, 0, 14)
         case SDL_CONTROLLERSENSORUPDATE: {
-            InputDevice *joy = trackcontrollers.value(event.caxis.which);
+            const DeviceRoute &route = getRoute(event.caxis.which);
+            InputDevice *joy = route.controller;
 
             if (joy != nullptr)
             {
@@ -827,11 +812,9 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                 if (sensor != nullptr)
                 {
-                    InputDeviceBitArrayStatus *temp = createOrGrabBitStatusEntry(&releaseEventsGenerated, joy, false);
-                    temp->changeSensorStatus(sensor_type, event.csensor.sensor == 0);
+                    route.releaseStatus->changeSensorStatus(sensor_type, event.csensor.sensor == 0);
 
-                    InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
-                    pending->changeSensorStatus(sensor_type, !sensor->inDeadZone(event.csensor.data));
+                    route.pendingStatus->changeSensorStatus(sensor_type, !sensor->inDeadZone(event.csensor.data));
                     sdlEventQueue->append(event);
                 }
             } else
@@ -844,7 +827,8 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
         case SDL_CONTROLLERBUTTONDOWN:
         case SDL_CONTROLLERBUTTONUP: {
-            InputDevice *joy = trackcontrollers.value(event.cbutton.which);
+            const DeviceRoute &route = getRoute(event.cbutton.which);
+            InputDevice *joy = route.controller;
 
             if (joy != nullptr)
             {
@@ -853,8 +837,8 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                 if (button != nullptr)
                 {
-                    InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
-                    pending->changeButtonStatus(event.cbutton.button, event.type == SDL_CONTROLLERBUTTONDOWN ? true : false);
+                    route.pendingStatus->changeButtonStatus(event.cbutton.button,
+                                                            event.type == SDL_CONTROLLERBUTTONDOWN ? true : false);
                     sdlEventQueue->append(event);
                 }
             }
@@ -891,118 +875,52 @@ void InputDaemon::modifyUnplugEvents(QQueue<SDL_Event> *sdlEventQueue)
         genIter.next();
         InputDevice *device = genIter.key();
         InputDeviceBitArrayStatus *generatedTemp = genIter.value();
-        QBitArray tempBitArray = generatedTemp->generateFinalBitArray();
 
-        int bitArraySize = tempBitArray.size();
+        if (!generatedTemp->isDirty())
+            continue;
 
-        qDebug() << "Raw array: " << tempBitArray << " array size: " << bitArraySize;
-
-        if ((bitArraySize > 0) && (tempBitArray.count(true) == device->getNumberAxes()))
+        if (generatedTemp->countSetBits() == device->getNumberAxes())
         {
-            if (getPendingEventValuesLocal().contains(device))
+            QBitArray tempBitArray = generatedTemp->generateFinalBitArray();
+            int bitArraySize = tempBitArray.size();
+
+            qDebug() << "Raw array: " << tempBitArray << " array size: " << bitArraySize;
+
+            InputDeviceBitArrayStatus *pendingTemp = getPendingEventValuesLocal().value(device);
+
+            if ((pendingTemp != nullptr) && pendingTemp->isDirty())
             {
-                InputDeviceBitArrayStatus *pendingTemp = getPendingEventValuesLocal().value(device);
                 QBitArray pendingBitArray = pendingTemp->generateFinalBitArray();
                 QBitArray unplugBitArray = createUnplugEventBitArray(device);
                 int pendingBitArraySize = pendingBitArray.size();
 
                 if ((bitArraySize == pendingBitArraySize) && (pendingBitArray == unplugBitArray))
                 {
-                    QQueue<SDL_Event> tempQueue;
+                    // Only axis events of unplugged device are changed. Rewrite
+                    // them in place so events of other devices stay untouched.
+                    SDL_JoystickID unpluggedID = device->getSDLJoystickID();
+                    const DeviceRoute &route = getRoute(unpluggedID);
+                    SetJoystick *set = device->getActiveSetJoystick();
 
-                    while (!sdlEventQueue->isEmpty())
+                    for (SDL_Event &event : *sdlEventQueue)
                     {
-                        SDL_Event event = sdlEventQueue->dequeue();
+                        if ((event.type == SDL_JOYAXISMOTION) && (event.jaxis.which == unpluggedID) &&
+                            (route.joystick != nullptr))
+                        {
+                            JoyAxis *axis = set->getJoyAxis(event.jaxis.axis);
 
-                        switch (event.type)
+                            if ((axis != nullptr) && (axis->getThrottle() != static_cast<int>(JoyAxis::NormalThrottle)))
+                                event.jaxis.value = axis->getProperReleaseValue();
+                        } else if ((event.type == SDL_CONTROLLERAXISMOTION) && (event.caxis.which == unpluggedID) &&
+                                   (route.controller != nullptr))
                         {
-                        case SDL_JOYBUTTONDOWN:
-                        case SDL_JOYBUTTONUP: {
-                            tempQueue.enqueue(event);
-                            break;
-                        }
-                        case SDL_JOYAXISMOTION: {
-                            if (event.jaxis.which != device->getSDLJoystickID())
-                            {
-                                tempQueue.enqueue(event);
-                            } else
-                            {
-                                InputDevice *joy = getTrackjoysticksLocal().value(event.jaxis.which);
-
-                                if (joy != nullptr)
-                                {
-                                    JoyAxis *axis = joy->getActiveSetJoystick()->getJoyAxis(event.jaxis.axis);
-                                    if (axis != nullptr)
-                                    {
-                                        if (axis->getThrottle() != static_cast<int>(JoyAxis::NormalThrottle))
-                                        {
-                                            event.jaxis.value = axis->getProperReleaseValue();
-                                        }
-                                    }
-                                }
-
-                                tempQueue.enqueue(event);
-                            }
-
-                            break;
-                        }
-                        case SDL_JOYHATMOTION: {
-                            tempQueue.enqueue(event);
-                            break;
-                        }
-                        case SDL_CONTROLLERAXISMOTION: {
-                            if (event.caxis.which != device->getSDLJoystickID())
-                            {
-                                tempQueue.enqueue(event);
-                            } else
-                            {
-                                InputDevice *joy = trackcontrollers.value(event.caxis.which);
-
-                                if (joy != nullptr)
-                                {
-                                    SetJoystick *set = joy->getActiveSetJoystick();
-                                    JoyAxis *axis = set->getJoyAxis(event.caxis.axis);
-
-                                    if (axis != nullptr)
-                                    {
-                                        if ((event.caxis.axis == SDL_CONTROLLER_AXIS_TRIGGERLEFT) ||
-                                            (event.caxis.axis == SDL_CONTROLLER_AXIS_TRIGGERRIGHT))
-                                        {
-                                            event.caxis.value = axis->getProperReleaseValue();
-                                        }
-                                    }
-                                }
-
-                                tempQueue.enqueue(event);
-                            }
-
-                            break;
-                        }
-#if SDL_VERSION_ATLEAST(2, 0, 14)
-                        case SDL_CONTROLLERSENSORUPDATE: {
-                            tempQueue.enqueue(event);
-                            break;
-                        }
-#endif
-                        case SDL_CONTROLLERBUTTONDOWN:
-                        case SDL_CONTROLLERBUTTONUP: {
-                            tempQueue.enqueue(event);
-                            break;
-                        }
-                        case SDL_JOYDEVICEREMOVED:
-                        case SDL_JOYDEVICEADDED:
-                        case SDL_CONTROLLERDEVICEREMOVED:
-                        case SDL_CONTROLLERDEVICEADDED: {
-                            tempQueue.enqueue(event);
-                            break;
-                        }
-                        default: {
-                            tempQueue.enqueue(event);
-                        }
+                            JoyAxis *axis = set->getJoyAxis(event.caxis.axis);
+
+                            if ((axis != nullptr) && ((event.caxis.axis == SDL_CONTROLLER_AXIS_TRIGGERLEFT) ||
+                                                      (event.caxis.axis == SDL_CONTROLLER_AXIS_TRIGGERRIGHT)))
+                                event.caxis.value = axis->getProperReleaseValue();
                         }
                     }
-
-                    sdlEventQueue->swap(tempQueue);
                 }
             }
         }
@@ -1026,163 +944,202 @@ QBitArray InputDaemon::createUnplugEventBitArray(InputDevice *device)
 }
 
 /**
- * @brief Dispatches postprocessed SDL events to the input objects like
- *  JoyAxis or JoyButton and activates them at the end.
+ * @brief Returns SDL instance id of the device which generated an input event.
  */
-void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
+static SDL_JoystickID getEventDeviceID(const SDL_Event &event)
 {
-    QMap<QString, int> uniques = QMap<QString, int>();
-    int counterUniques = 1;
-    bool duplicatedGamepad = false;
+    switch (event.type)
+    {
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP:
+        return event.jbutton.which;
+    case SDL_JOYAXISMOTION:
+        return event.jaxis.which;
+    case SDL_JOYHATMOTION:
+        return event.jhat.which;
+    case SDL_CONTROLLERAXISMOTION:
+        return event.caxis.which;
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    case SDL_CONTROLLERSENSORUPDATE:
+        return event.csensor.which;
+#endif
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+        return event.cbutton.which;
+    default:
+        return -1;
+    }
+}
 
-    QHash<SDL_JoystickID, InputDevice *> activeDevices;
+/**
+ * @brief Axis identifier used to match events of the same axis. -1 for
+ *     events which are not axis motion.
+ */
+static qint64 getEventAxisKey(const SDL_Event &event)
+{
+    if (event.type == SDL_JOYAXISMOTION)
+        return (static_cast<qint64>(static_cast<quint32>(event.jaxis.which)) << 16) | event.jaxis.axis;
+    else if (event.type == SDL_CONTROLLERAXISMOTION)
+        return (static_cast<qint64>(static_cast<quint32>(event.caxis.which)) << 16) | 0x100 | event.caxis.axis;
 
-    while (!sdlEventQueue->isEmpty())
-    {
-        SDL_Event event = sdlEventQueue->dequeue();
+    return -1;
+}
 
-        switch (event.type)
-        {
-        case SDL_JOYBUTTONDOWN:
-        case SDL_JOYBUTTONUP: {
-            InputDevice *joy = getTrackjoysticksLocal().value(event.jbutton.which);
+static int getEventAxisValue(const SDL_Event &event)
+{
+    return (event.type == SDL_JOYAXISMOTION) ? event.jaxis.value : event.caxis.value;
+}
 
-            if (joy != nullptr)
-            {
-                SetJoystick *set = joy->getActiveSetJoystick();
-                JoyButton *button = set->getJoyButton(event.jbutton.button);
+/**
+ * @brief Drop axis motion events superseded by a later event of the same
+ *     axis in this poll, so only the latest value is processed. Button and
+ *     hat events of a device end coalescing of its axes, which keeps axis
+ *     state seen by every press and release as it was. When keepAxisPeaks
+ *     is set, the lowest and highest value of coalesced events are kept as
+ *     well, so short movements still cross thresholds.
+ */
+void InputDaemon::coalesceAxisEvents(QQueue<SDL_Event> *sdlEventQueue)
+{
+    QVector<bool> keep(sdlEventQueue->size(), true);
+    QHash<qint64, QVector<int>> runs;
+    bool coalesced = false;
 
-                if (button != nullptr)
-                {
-                    button->queuePendingEvent(event.type == SDL_JOYBUTTONDOWN ? true : false);
+    auto finishRun = [this, sdlEventQueue, &keep, &coalesced](const QVector<int> &run) {
+        if (run.size() < 2)
+            return;
 
-                    if (!activeDevices.contains(event.jbutton.which))
-                        activeDevices.insert(event.jbutton.which, joy);
-                }
-            } else if (trackcontrollers.contains(event.jbutton.which))
-            {
-                GameController *gamepad = trackcontrollers.value(event.jbutton.which);
-                gamepad->rawButtonEvent(event.jbutton.button, event.type == SDL_JOYBUTTONDOWN ? true : false);
-            }
+        int minIndex = run.last();
+        int maxIndex = run.last();
 
-            break;
-        }
+        for (int index : run)
+        {
+            int value = getEventAxisValue(sdlEventQueue->at(index));
 
-        case SDL_JOYAXISMOTION: {
-            InputDevice *joy = getTrackjoysticksLocal().value(event.jaxis.which);
+            if (value < getEventAxisValue(sdlEventQueue->at(minIndex)))
+                minIndex = index;
 
-            if (joy != nullptr)
-            {
-                SetJoystick *set = joy->getActiveSetJoystick();
-                JoyAxis *axis = set->getJoyAxis(event.jaxis.axis);
+            if (value > getEventAxisValue(sdlEventQueue->at(maxIndex)))
+                maxIndex = index;
+        }
 
-                if (axis != nullptr)
-                {
-                    axis->queuePendingEvent(event.jaxis.value);
+        for (int index : run)
+        {
+            if ((index == run.last()) || (keepAxisPeaks && ((index == minIndex) || (index == maxIndex))))
+                continue;
 
-                    if (!activeDevices.contains(event.jaxis.which))
-                        activeDevices.insert(event.jaxis.which, joy);
-                }
+            keep[index] = false;
+            coalesced = true;
+
+            InputDevice *device = m_joysticks->value(getEventDeviceID(sdlEventQueue->at(index)), nullptr);
 
-                joy->rawAxisEvent(event.jaxis.which, event.jaxis.value);
-            } else if (trackcontrollers.contains(event.jaxis.which))
+            if (device != nullptr)
             {
-                GameController *gamepad = trackcontrollers.value(event.jaxis.which);
-                gamepad->rawAxisEvent(event.jaxis.axis, event.jaxis.value);
+                device->getCounters().addReceived();
+                device->getCounters().addCoalesced();
             }
-
-            break;
         }
+    };
 
-        case SDL_JOYHATMOTION: {
-            InputDevice *joy = getTrackjoysticksLocal().value(event.jhat.which);
+    for (int i = 0; i < sdlEventQueue->size(); i++)
+    {
+        const SDL_Event &event = sdlEventQueue->at(i);
+        qint64 axisKey = getEventAxisKey(event);
 
-            if (joy != nullptr)
-            {
-                SetJoystick *set = joy->getActiveSetJoystick();
-                JoyDPad *dpad = set->getJoyDPad(event.jhat.hat);
+        if (axisKey != -1)
+        {
+            runs[axisKey].append(i);
+        } else if ((event.type == SDL_JOYBUTTONDOWN) || (event.type == SDL_JOYBUTTONUP) ||
+                   (event.type == SDL_JOYHATMOTION) || (event.type == SDL_CONTROLLERBUTTONDOWN) ||
+                   (event.type == SDL_CONTROLLERBUTTONUP))
+        {
+            SDL_JoystickID deviceID = getEventDeviceID(event);
 
-                if (dpad != nullptr)
+            for (auto iter = runs.begin(); iter != runs.end();)
+            {
+                if ((iter.key() >> 16) == static_cast<quint32>(deviceID))
                 {
-                    dpad->joyEvent(event.jhat.value);
-
-                    if (!activeDevices.contains(event.jhat.which))
-                        activeDevices.insert(event.jhat.which, joy);
+                    finishRun(iter.value());
+                    iter = runs.erase(iter);
+                } else
+                {
+                    ++iter;
                 }
-            } else if (trackcontrollers.contains(event.jhat.which))
-            {
-                GameController *gamepad = trackcontrollers.value(event.jaxis.which);
-                gamepad->rawDPadEvent(event.jhat.hat, event.jhat.value);
             }
-
-            break;
         }
+    }
 
-        case SDL_CONTROLLERAXISMOTION: {
-            InputDevice *joy = trackcontrollers.value(event.caxis.which);
+    for (const QVector<int> &run : runs)
+        finishRun(run);
 
-            if (joy != nullptr)
-            {
-                SetJoystick *set = joy->getActiveSetJoystick();
-                JoyAxis *axis = set->getJoyAxis(event.caxis.axis);
+    if (!coalesced)
+        return;
 
-                if (axis != nullptr)
-                {
-                    axis->queuePendingEvent(event.caxis.value);
+    QQueue<SDL_Event> result;
 
-                    if (!activeDevices.contains(event.caxis.which))
-                        activeDevices.insert(event.caxis.which, joy);
-                }
-            }
+    for (int i = 0; i < sdlEventQueue->size(); i++)
+    {
+        if (keep.at(i))
+            result.enqueue(sdlEventQueue->at(i));
+    }
 
-            break;
-        }
+    sdlEventQueue->swap(result);
+}
 
-#if SDL_VERSION_ATLEAST(2, 0, 14)
-        case SDL_CONTROLLERSENSORUPDATE: {
-            InputDevice *joy = trackcontrollers.value(event.csensor.which);
+/**
+ * @brief Activate events queued in elements of a device.
+ */
+static void activateDeviceEvents(InputDevice *device)
+{
+    device->activatePossibleControlStickEvents();
+    device->activatePossibleAxisEvents();
+    device->activatePossibleSensorEvents();
+    device->activatePossibleDPadEvents();
+    device->activatePossibleVDPadEvents();
+    device->activatePossibleButtonEvents();
+    device->getKeyRepeatHelper()->sendDueRepeats();
+}
 
-            if (joy != nullptr)
-            {
-                SetJoystick *set = joy->getActiveSetJoystick();
-                JoySensor *sensor = nullptr;
-                if (event.csensor.sensor == SDL_SENSOR_ACCEL)
-                    sensor = set->getSensor(ACCELEROMETER);
-                else if (event.csensor.sensor == SDL_SENSOR_GYRO)
-                    sensor = set->getSensor(GYROSCOPE);
-                else
-                    Q_ASSERT(false);
+/**
+ * @brief Send pending mouse events right away instead of waiting for the mouse timer.
+ */
+static void invokePendingMouseEvents()
+{
+    if (JoyButton::shouldInvokeMouseEvents(JoyButton::getPendingMouseButtons(), JoyButton::getStaticMouseEventTimer(),
+                                           JoyButton::getTestOldMouseTime()))
+        JoyButton::invokeMouseEvents(JoyButton::getMouseHelper());
+}
 
-                if (sensor != nullptr)
-                {
-                    sensor->queuePendingEvent(event.csensor.data);
+/**
+ * @brief Dispatches postprocessed SDL events to the input objects like
+ *  JoyAxis or JoyButton and activates them at the end.
+ */
+void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
+{
+    QHash<SDL_JoystickID, InputDevice *> activeDevices;
+    QList<SDL_JoystickID> addedIDs;
 
-                    if (!activeDevices.contains(event.csensor.which))
-                        activeDevices.insert(event.csensor.which, joy);
-                }
-            }
+    while (!sdlEventQueue->isEmpty())
+    {
+        SDL_Event event = sdlEventQueue->dequeue();
 
-            break;
-        }
+        switch (event.type)
+        {
+        case SDL_JOYBUTTONDOWN:
+        case SDL_JOYBUTTONUP:
+        case SDL_JOYAXISMOTION:
+        case SDL_JOYHATMOTION:
+        case SDL_CONTROLLERAXISMOTION:
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+        case SDL_CONTROLLERSENSORUPDATE:
 #endif
-
         case SDL_CONTROLLERBUTTONDOWN:
         case SDL_CONTROLLERBUTTONUP: {
-            InputDevice *joy = trackcontrollers.value(event.cbutton.which);
+            SDL_JoystickID deviceID = getEventDeviceID(event);
+            const DeviceRoute &route = getRoute(deviceID);
+            InputDevice *activeDevice = dispatchDeviceEvent(route, event);
 
-            if (joy != nullptr)
-            {
-                SetJoystick *set = joy->getActiveSetJoystick();
-                JoyButton *button = set->getJoyButton(event.cbutton.button);
-
-                if (button != nullptr)
-                {
-                    button->queuePendingEvent(event.type == SDL_CONTROLLERBUTTONDOWN ? true : false);
-
-                    if (!activeDevices.contains(event.cbutton.which))
-                        activeDevices.insert(event.cbutton.which, joy);
-                }
-            }
+            if ((activeDevice != nullptr) && !activeDevices.contains(deviceID))
+                activeDevices.insert(deviceID, activeDevice);
 
             break;
         }
@@ -1205,7 +1162,16 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
         case SDL_JOYDEVICEADDED:
         case SDL_CONTROLLERDEVICEADDED: {
-            addInputDevice(event.jdevice.which, uniques, counterUniques, duplicatedGamepad);
+            // Devices are built in deviceBuilderThread. Skip devices
+            // which are already opened (SDL reports them at start too).
+            SDL_JoystickID addedID = SDL_JoystickGetDeviceInstanceID(event.jdevice.which);
+
+            if (isOwnVirtualDevice(event.jdevice.which))
+                break;
+
+            if (!m_joysticks->contains(addedID) && !addedIDs.contains(addedID))
+                addedIDs.append(addedID);
+
             break;
         }
 
@@ -1219,57 +1185,192 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
         }
 
         // Active possible queued events.
-        QHashIterator<SDL_JoystickID, InputDevice *> activeDevIter(activeDevices);
+        for (InputDevice *tempDevice : activeDevices)
+            activateDeviceEvents(tempDevice);
 
-        while (activeDevIter.hasNext())
-        {
-            InputDevice *tempDevice = activeDevIter.next().value();
-            tempDevice->activatePossibleControlStickEvents();
-            tempDevice->activatePossibleAxisEvents();
-            tempDevice->activatePossibleSensorEvents();
-            tempDevice->activatePossibleDPadEvents();
-            tempDevice->activatePossibleVDPadEvents();
-            tempDevice->activatePossibleButtonEvents();
-        }
+        invokePendingMouseEvents();
+    }
 
-        if (JoyButton::shouldInvokeMouseEvents(JoyButton::getPendingMouseButtons(), JoyButton::getStaticMouseEventTimer(),
-                                               JoyButton::getTestOldMouseTime()))
-            JoyButton::invokeMouseEvents(
-                JoyButton::getMouseHelper()); // Do not wait for next event loop run. Execute immediately.
+    if (!addedIDs.isEmpty())
+    {
+        QThread *targetThread = thread();
+        InputDeviceBuilder *builder = deviceBuilder;
+        QMetaObject::invokeMethod(builder, [builder, addedIDs, targetThread]() {
+            builder->buildDevices(addedIDs, targetThread);
+        });
     }
 }
 
-void InputDaemon::clearBitArrayStatusInstances()
+/**
+ * @brief Pass input event to element of device it belongs to.
+ * @return Device with queued events which should be activated or nullptr.
+ */
+InputDevice *InputDaemon::dispatchDeviceEvent(const DeviceRoute &route, const SDL_Event &event)
 {
-    QHashIterator<InputDevice *, InputDeviceBitArrayStatus *> genIter(releaseEventsGenerated);
+    InputDevice *activeDevice = nullptr;
 
-    while (genIter.hasNext())
+    switch (event.type)
     {
-        InputDeviceBitArrayStatus *temp = genIter.next().value();
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP: {
+        InputDevice *joy = route.joystick;
 
-        if (temp != nullptr)
+        if (joy != nullptr)
         {
-            temp->deleteLater();
-            temp = nullptr;
+            SetJoystick *set = joy->getActiveSetJoystick();
+            JoyButton *button = set->getJoyButton(event.jbutton.button);
+
+            if (button != nullptr)
+            {
+                button->queuePendingEvent(event.type == SDL_JOYBUTTONDOWN ? true : false);
+
+                activeDevice = joy;
+            }
+        } else if (route.controller != nullptr)
+        {
+            route.controller->rawButtonEvent(event.jbutton.button, event.type == SDL_JOYBUTTONDOWN ? true : false);
         }
+
+        break;
     }
 
-    getReleaseEventsGeneratedLocal().clear();
+    case SDL_JOYAXISMOTION: {
+        InputDevice *joy = route.joystick;
 
-    QHashIterator<InputDevice *, InputDeviceBitArrayStatus *> pendIter(pendingEventValues);
+        if (joy != nullptr)
+        {
+            SetJoystick *set = joy->getActiveSetJoystick();
+            JoyAxis *axis = set->getJoyAxis(event.jaxis.axis);
 
-    while (pendIter.hasNext())
-    {
-        InputDeviceBitArrayStatus *temp = pendIter.next().value();
+            if (axis != nullptr)
+            {
+                axis->queuePendingEvent(event.jaxis.value);
+
+                activeDevice = joy;
+            }
 
-        if (temp != nullptr)
+            joy->rawAxisEvent(event.jaxis.which, event.jaxis.value);
+        } else if (route.controller != nullptr)
         {
-            temp->deleteLater();
-            temp = nullptr;
+            route.controller->rawAxisEvent(event.jaxis.axis, event.jaxis.value);
         }
+
+        break;
+    }
+
+    case SDL_JOYHATMOTION: {
+        InputDevice *joy = route.joystick;
+
+        if (joy != nullptr)
+        {
+            SetJoystick *set = joy->getActiveSetJoystick();
+            JoyDPad *dpad = set->getJoyDPad(event.jhat.hat);
+
+            if (dpad != nullptr)
+            {
+                dpad->joyEvent(event.jhat.value);
+
+                activeDevice = joy;
+            }
+        } else if (route.controller != nullptr)
+        {
+            route.controller->rawDPadEvent(event.jhat.hat, event.jhat.value);
+        }
+
+        break;
+    }
+
+    case SDL_CONTROLLERAXISMOTION: {
+        InputDevice *joy = route.controller;
+
+        if (joy != nullptr)
+        {
+            SetJoystick *set = joy->getActiveSetJoystick();
+            JoyAxis *axis = set->getJoyAxis(event.caxis.axis);
+
+            if (axis != nullptr)
+            {
+                axis->queuePendingEvent(event.caxis.value);
+
+                activeDevice = joy;
+                passthroughGamepadAxis(event.caxis.which, axis, event.caxis.value);
+            }
+        }
+
+        break;
     }
 
-    getPendingEventValuesLocal().clear();
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    case SDL_CONTROLLERSENSORUPDATE: {
+        InputDevice *joy = route.controller;
+
+        if (joy != nullptr)
+        {
+            SetJoystick *set = joy->getActiveSetJoystick();
+            JoySensor *sensor = nullptr;
+            if (event.csensor.sensor == SDL_SENSOR_ACCEL)
+                sensor = set->getSensor(ACCELEROMETER);
+            else if (event.csensor.sensor == SDL_SENSOR_GYRO)
+                sensor = set->getSensor(GYROSCOPE);
+            else
+                Q_ASSERT(false);
+
+            if (sensor != nullptr)
+            {
+                sensor->queuePendingEvent(event.csensor.data);
+
+                activeDevice = joy;
+            }
+        }
+
+        break;
+    }
+#endif
+
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP: {
+        InputDevice *joy = route.controller;
+
+        if (joy != nullptr)
+        {
+            SetJoystick *set = joy->getActiveSetJoystick();
+            JoyButton *button = set->getJoyButton(event.cbutton.button);
+
+            if (button != nullptr)
+            {
+                button->queuePendingEvent(event.type == SDL_CONTROLLERBUTTONDOWN ? true : false);
+
+                activeDevice = joy;
+                passthroughGamepadButton(event.cbutton.which, event.cbutton.button, button,
+                                         event.type == SDL_CONTROLLERBUTTONDOWN);
+            }
+        }
+
+        break;
+    }
+
+
+    default:
+        break;
+    }
+
+    if (activeDevice != nullptr)
+        activeDevice->getCounters().addReceived();
+
+    return activeDevice;
+}
+
+/**
+ * @brief Reset status bits collected during the poll. Status objects
+ *     are kept for the next poll.
+ */
+void InputDaemon::clearBitArrayStatusInstances()
+{
+    for (InputDeviceBitArrayStatus *status : releaseEventsGenerated)
+        status->clearStatusValues();
+
+    for (InputDeviceBitArrayStatus *status : pendingEventValues)
+        status->clearStatusValues();
 }
 
 void InputDaemon::resetActiveButtonMouseDistances()
@@ -1277,6 +1378,40 @@ void InputDaemon::resetActiveButtonMouseDistances()
     pollResetTimer.stop();
 
     JoyButton::resetActiveButtonMouseDistances(JoyButton::getMouseHelper());
+
+    // Mouse output could have stopped since last poll
+    if ((eventWorker != nullptr) && eventWorker->isAdaptivePolling())
+        eventWorker->setInputsActive(hasActiveInputs());
+}
+
+/**
+ * @brief Check whether a button is held, an axis of an active set is
+ *     outside its dead zone or mouse output is running. SDL reports no
+ *     events while a stick is held still, so adaptive polling must not
+ *     back off then.
+ */
+bool InputDaemon::hasActiveInputs()
+{
+    if (JoyButton::getStaticMouseEventTimer()->isActive())
+        return true;
+
+    for (InputDevice *device : m_joysticks->values())
+    {
+        if (device->getButtonDownCount() > 0)
+            return true;
+
+        SetJoystick *currentSet = device->getActiveSetJoystick();
+
+        for (int i = 0; i < currentSet->getNumberAxes(); i++)
+        {
+            JoyAxis *axis = currentSet->getJoyAxis(i);
+
+            if ((axis != nullptr) && !axis->inDeadZone(axis->getCurrentRawValue()))
+                return true;
+        }
+    }
+
+    return false;
 }
 
 void InputDaemon::updatePollResetRate(int tempPollRate)
@@ -1314,6 +1449,72 @@ void InputDaemon::convertMappingsToUnique(QSettings *sett, QString guidString, Q
     }
 }
 
+/**
+ * @brief Rebuild table routing SDL instance ids to opened devices. Has
+ *     to be called after trackjoysticks or trackcontrollers change.
+ *     Status objects of remaining devices are reused, others are deleted.
+ */
+void InputDaemon::rebuildRoutes()
+{
+    QHash<InputDevice *, InputDeviceBitArrayStatus *> oldReleaseStatus;
+    QHash<InputDevice *, InputDeviceBitArrayStatus *> oldPendingStatus;
+    oldReleaseStatus.swap(releaseEventsGenerated);
+    oldPendingStatus.swap(pendingEventValues);
+
+    routes.clear();
+
+    auto addRoute = [&](SDL_JoystickID deviceID, InputDevice *device) -> DeviceRoute & {
+        if (deviceID >= routes.size())
+            routes.resize(deviceID + 1);
+
+        DeviceRoute &route = routes[deviceID];
+        route.releaseStatus = oldReleaseStatus.take(device);
+        route.pendingStatus = oldPendingStatus.take(device);
+
+        if (route.releaseStatus == nullptr)
+            route.releaseStatus = new InputDeviceBitArrayStatus(device, false, this);
+
+        if (route.pendingStatus == nullptr)
+            route.pendingStatus = new InputDeviceBitArrayStatus(device, true, this);
+
+        releaseEventsGenerated.insert(device, route.releaseStatus);
+        pendingEventValues.insert(device, route.pendingStatus);
+        return route;
+    };
+
+    for (auto iter = trackjoysticks.cbegin(); iter != trackjoysticks.cend(); ++iter)
+        addRoute(iter.key(), iter.value()).joystick = iter.value();
+
+    for (auto iter = trackcontrollers.cbegin(); iter != trackcontrollers.cend(); ++iter)
+        addRoute(iter.key(), iter.value()).controller = iter.value();
+
+    qDeleteAll(oldReleaseStatus);
+    qDeleteAll(oldPendingStatus);
+}
+
+void InputDaemon::recordTraceEvent(const SDL_Event &event)
+{
+    SDL_JoystickID deviceID = getEventDeviceID(event);
+    const DeviceRoute &route = getRoute(deviceID);
+    InputDevice *device = route.controller;
+
+    if (device == nullptr)
+        device = route.joystick;
+
+    if (device != nullptr)
+        traceRecorder->record(event, deviceID, device);
+}
+
+const InputDaemon::DeviceRoute &InputDaemon::getRoute(SDL_JoystickID deviceID) const
+{
+    static const DeviceRoute noRoute;
+
+    if ((deviceID < 0) || (deviceID >= routes.size()))
+        return noRoute;
+
+    return routes.at(deviceID);
+}
+
 QHash<SDL_JoystickID, Joystick *> &InputDaemon::getTrackjoysticksLocal() { return trackjoysticks; }
 
 QHash<InputDevice *, InputDeviceBitArrayStatus *> &InputDaemon::getReleaseEventsGeneratedLocal()
@@ -1322,3 +1523,107 @@ QHash<InputDevice *, InputDeviceBitArrayStatus *> &InputDaemon::getReleaseEvents
 }
 
 QHash<InputDevice *, InputDeviceBitArrayStatus *> &InputDaemon::getPendingEventValuesLocal() { return pendingEventValues; }
+
+/**
+ * @brief Create output devices dedicated to a newly added controller
+ *     when event handler is configured to use them.
+ */
+void InputDaemon::attachOutputDevice(InputDevice *device)
+{
+    BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+
+    if ((device != nullptr) && handler->isPerDeviceOutput())
+        handler->addOutputDevice(device->getSDLJoystickID(), device->getSDLName());
+
+    if ((device != nullptr) && device->isGameController() && handler->isVirtualGamepadOutput())
+        handler->addGamepadDevice(device->getSDLJoystickID(), device->getSDLName());
+}
+
+void InputDaemon::detachOutputDevice(SDL_JoystickID deviceID)
+{
+    BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+
+    if (handler->isPerDeviceOutput())
+        handler->removeOutputDevice(deviceID);
+
+    if (handler->isVirtualGamepadOutput())
+        handler->removeGamepadDevice(deviceID);
+
+    QMutableSetIterator<QPair<SDL_JoystickID, int>> iter(forwardedGamepadButtons);
+
+    while (iter.hasNext())
+    {
+        if (iter.next().first == deviceID)
+            iter.remove();
+    }
+}
+
+/**
+ * @brief Forward button without assigned slots to virtual gamepad. Release
+ *     is forwarded for every forwarded press even when slots were assigned
+ *     in between, so the virtual button is never left held.
+ */
+void InputDaemon::passthroughGamepadButton(SDL_JoystickID deviceID, int index, JoyButton *button, bool pressed)
+{
+    BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+
+    if (!handler->isVirtualGamepadOutput())
+        return;
+
+    QPair<SDL_JoystickID, int> key(deviceID, index);
+
+    if (pressed && button->getAssignedSlots()->isEmpty())
+    {
+        forwardedGamepadButtons.insert(key);
+        handler->sendGamepadButtonEvent(deviceID, index, true);
+    } else if (!pressed && forwardedGamepadButtons.remove(key))
+    {
+        handler->sendGamepadButtonEvent(deviceID, index, false);
+    }
+}
+
+/**
+ * @brief Forward axis without assigned slots to virtual gamepad. Value is
+ *     rescaled using dead zone and max zone from the active profile. Stick
+ *     axes use the radial dead zone of the stick, so both axes of the stick
+ *     are sent.
+ */
+void InputDaemon::passthroughGamepadAxis(SDL_JoystickID deviceID, JoyAxis *axis, int value)
+{
+    BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+
+    if (!handler->isVirtualGamepadOutput())
+        return;
+
+    bool assigned = !axis->getPAxisButton()->getAssignedSlots()->isEmpty() ||
+                    !axis->getNAxisButton()->getAssignedSlots()->isEmpty();
+
+    if (axis->isPartControlStick())
+    {
+        for (JoyControlStickButton *button : axis->getControlStick()->getButtons()->values())
+            assigned = assigned || !button->getAssignedSlots()->isEmpty();
+    }
+
+    if (assigned)
+        return;
+
+    if (axis->isPartControlStick())
+    {
+        // Stick axes already hold the new value, it is applied when queued.
+        JoyControlStick *stick = axis->getControlStick();
+        int xValue = stick->getAxisX()->getCurrentRawValue();
+        int yValue = stick->getAxisY()->getCurrentRawValue();
+        double rawDistance = sqrt((static_cast<double>(xValue) * xValue) + (static_cast<double>(yValue) * yValue));
+        double scale = 0.0;
+
+        if (rawDistance > 0.0)
+            scale = stick->getDistanceFromDeadZone(xValue, yValue) * GlobalVariables::JoyAxis::AXISMAX / rawDistance;
+
+        handler->sendGamepadAxisEvent(deviceID, stick->getAxisX()->getIndex(), qRound(xValue * scale));
+        handler->sendGamepadAxisEvent(deviceID, stick->getAxisY()->getIndex(), qRound(yValue * scale));
+        return;
+    }
+
+    int output = qRound(axis->getDistanceFromDeadZone(value) * GlobalVariables::JoyAxis::AXISMAX);
+    handler->sendGamepadAxisEvent(deviceID, axis->getIndex(), (value < 0) ? -output : output);
+}
@@ -23,10 +23,18 @@
 //#include "fakeclasses/xbox360wireless.h"
 #include <SDL2/SDL_events.h>
 
+#include <QPair>
+#include <QSet>
+#include <QVector>
+
 class InputDevice;
 class AntiMicroSettings;
 class InputDeviceBitArrayStatus;
+class InputDeviceBuilder;
+class InputTraceRecorder;
 class Joystick;
+class JoyAxis;
+class JoyButton;
 class GameController;
 class SDLEventReader;
 class QThread;
@@ -45,21 +53,27 @@ class InputDaemon : public QObject
                          QObject *parent = 0);
     ~InputDaemon();
 
-  protected:
-    InputDeviceBitArrayStatus *createOrGrabBitStatusEntry(QHash<InputDevice *, InputDeviceBitArrayStatus *> *statusHash,
-                                                          InputDevice *device, bool readCurrent = true);
+    static QString getJoyInfo(SDL_JoystickGUID sdlvalue);
+    static QString getJoyInfo(Uint16 sdlvalue);
+    static void convertMappingsToUnique(QSettings *sett, QString guidString, QString uniqueIdString);
+    static bool isOwnVirtualDevice(int index);
 
-    QString getJoyInfo(SDL_JoystickGUID sdlvalue);
-    QString getJoyInfo(Uint16 sdlvalue);
+    bool startInputRecording(const QString &fileName);
+    void setKeepAxisPeaks(bool enabled);
+    void setAdaptivePolling(bool enabled);
+    SDL_JoystickID addVirtualDevice(bool gameController, const QString &name, const QString &guid,
+                                    const QString &uniqueID, int buttons, int axes, int hats);
+
+  protected:
 
     void firstInputPass(QQueue<SDL_Event> *sdlEventQueue);
     void secondInputPass(QQueue<SDL_Event> *sdlEventQueue);
     void modifyUnplugEvents(QQueue<SDL_Event> *sdlEventQueue);
+    void coalesceAxisEvents(QQueue<SDL_Event> *sdlEventQueue);
     QBitArray createUnplugEventBitArray(InputDevice *device);
     Joystick *openJoystickDevice(int index);
 
     void clearBitArrayStatusInstances();
-    void convertMappingsToUnique(QSettings *sett, QString guidString, QString uniqueIdString);
 
   signals:
     void joystickRefreshed(InputDevice *joystick);
@@ -80,15 +94,39 @@ class InputDaemon : public QObject
     void startWorker();
     void refreshMapping(QString mapping, InputDevice *device);
     void removeDevice(InputDevice *device);
-    void addInputDevice(int index, QMap<QString, int> &uniques, int &counterUniques, bool &duplicatedGamepad);
     void refreshIndexes();
+    void passthroughGamepadAxis(SDL_JoystickID deviceID, JoyAxis *axis, int value);
+    bool hasActiveInputs();
 
   private slots:
     void stop();
     void resetActiveButtonMouseDistances();
     void updatePollResetRate(int tempPollRate);
+    void attachOutputDevice(InputDevice *device);
+    void detachOutputDevice(SDL_JoystickID deviceID);
+    void attachBuiltDevice(InputDevice *device);
 
   private:
+    /**
+     * @brief Device receiving events of one SDL instance id. Only one
+     *     of joystick and controller is set depending on how the device
+     *     was opened. Status objects are owned by the hashes below.
+     */
+    struct DeviceRoute
+    {
+        Joystick *joystick = nullptr;
+        GameController *controller = nullptr;
+        InputDeviceBitArrayStatus *releaseStatus = nullptr;
+        InputDeviceBitArrayStatus *pendingStatus = nullptr;
+    };
+
+    void rebuildRoutes();
+    const DeviceRoute &getRoute(SDL_JoystickID deviceID) const;
+    void recordTraceEvent(const SDL_Event &event);
+    void passthroughGamepadButton(SDL_JoystickID deviceID, int index, JoyButton *button, bool pressed);
+
+    InputDevice *dispatchDeviceEvent(const DeviceRoute &route, const SDL_Event &event);
+
     QHash<SDL_JoystickID, Joystick *> &getTrackjoysticksLocal();
     QHash<InputDevice *, InputDeviceBitArrayStatus *> &getReleaseEventsGeneratedLocal();
     QHash<InputDevice *, InputDeviceBitArrayStatus *> &getPendingEventValuesLocal();
@@ -96,15 +134,23 @@ class InputDaemon : public QObject
     QMap<SDL_JoystickID, InputDevice *> *m_joysticks;
     QHash<SDL_JoystickID, Joystick *> trackjoysticks;
     QHash<SDL_JoystickID, GameController *> trackcontrollers;
+    QVector<DeviceRoute> routes; // indexed by SDL instance id
 
     QHash<InputDevice *, InputDeviceBitArrayStatus *> releaseEventsGenerated;
     QHash<InputDevice *, InputDeviceBitArrayStatus *> pendingEventValues;
+    QSet<QPair<SDL_JoystickID, int>> forwardedGamepadButtons; // pressed on virtual gamepad
 
     bool stopped;
+    bool firstPollTraced;
+    bool keepAxisPeaks;
     bool m_graphical;
+    SDL_JoystickID nextVirtualDeviceID;
 
     SDLEventReader *eventWorker;
     QThread *sdlWorkerThread;
+    InputDeviceBuilder *deviceBuilder;
+    QThread *deviceBuilderThread;
+    InputTraceRecorder *traceRecorder;
     AntiMicroSettings *m_settings;
     QTimer pollResetTimer;
     // SDL_Joystick* xbox360;
@@ -22,6 +22,7 @@
 #include "common.h"
 #include "globalvariables.h"
 #include "joybuttontypes/joycontrolstickbutton.h"
+#include "joybuttontypes/joycontrolstickmodifierbutton.h"
 #include "joybuttontypes/joydpadbutton.h"
 #include "joybuttontypes/joysensorbutton.h"
 #include "joycontrolstick.h"
@@ -38,6 +39,7 @@
 InputDevice::InputDevice(SDL_Joystick *joystick, int deviceIndex, AntiMicroSettings *settings, QObject *parent)
     : QObject(parent)
     , m_calibrations(this)
+    , m_keyRepeatHelper(this)
 {
     buttonDownCount = 0;
     joyNumber = deviceIndex;
@@ -68,6 +70,10 @@ void InputDevice::reset()
     resetButtonDownCount();
     deviceEdited = false;
     profileName = "";
+    keyRepeatEnabled = false;
+    keyRepeatDelay = 0;
+    keyRepeatRate = 0;
+    m_keyRepeatHelper.clear();
 
     for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
     {
@@ -1243,7 +1249,13 @@ void InputDevice::disconnectPropertyUpdatedConnection()
     disconnect(this, &InputDevice::propertyUpdated, this, &InputDevice::profileEdited);
 }
 
-void InputDevice::setKeyRepeatStatus(bool enabled) { keyRepeatEnabled = enabled; }
+void InputDevice::setKeyRepeatStatus(bool enabled)
+{
+    keyRepeatEnabled = enabled;
+
+    if (!enabled)
+        m_keyRepeatHelper.clear();
+}
 
 void InputDevice::setKeyRepeatDelay(int delay)
 {
@@ -1416,6 +1428,32 @@ bool InputDevice::isKnownController()
     return result;
 }
 
+/**
+ * @brief Activate pending events of elements queued in dirty list. Elements
+ *     queued again while activating are kept for next pass.
+ */
+template <typename T> static void activateDirtyElements(QVector<T *> &dirty)
+{
+    if (dirty.isEmpty())
+        return;
+
+    QVector<T *> pending;
+    pending.swap(dirty);
+
+    for (T *element : pending)
+    {
+        if (element->hasPendingEvent())
+            element->activatePendingEvent();
+    }
+
+    // Reuse allocated storage if nothing was queued during activation
+    if (dirty.isEmpty())
+    {
+        pending.clear();
+        dirty.swap(pending);
+    }
+}
+
 void InputDevice::activatePossiblePendingEvents()
 {
     activatePossibleControlStickEvents();
@@ -1427,85 +1465,32 @@ void InputDevice::activatePossiblePendingEvents()
 
 void InputDevice::activatePossibleControlStickEvents()
 {
-    SetJoystick *currentSet = getActiveSetJoystick();
-
-    for (int i = 0; i < currentSet->getNumberSticks(); i++)
-    {
-        JoyControlStick *tempStick = currentSet->getJoyStick(i);
-
-        if ((tempStick != nullptr) && tempStick->hasPendingEvent())
-        {
-            tempStick->activatePendingEvent();
-        }
-    }
+    activateDirtyElements(getActiveSetJoystick()->getDirtySticks());
 }
 
 void InputDevice::activatePossibleAxisEvents()
 {
-    SetJoystick *currentSet = getActiveSetJoystick();
-
-    for (int i = 0; i < currentSet->getNumberAxes(); i++)
-    {
-        JoyAxis *tempAxis = currentSet->getJoyAxis(i);
-
-        if ((tempAxis != nullptr) && tempAxis->hasPendingEvent())
-        {
-            tempAxis->activatePendingEvent();
-        }
-    }
+    activateDirtyElements(getActiveSetJoystick()->getDirtyAxes());
 }
 
 void InputDevice::activatePossibleSensorEvents()
 {
-    SetJoystick *currentSet = getActiveSetJoystick();
-    JoySensor *sensor = nullptr;
-
-    for (size_t i = 0; i < SENSOR_COUNT; ++i)
-    {
-        JoySensorType type = static_cast<JoySensorType>(i);
-        sensor = currentSet->getSensor(type);
-        if ((sensor != nullptr) && sensor->hasPendingEvent())
-            sensor->activatePendingEvent();
-    }
+    activateDirtyElements(getActiveSetJoystick()->getDirtySensors());
 }
 
 void InputDevice::activatePossibleDPadEvents()
 {
-    SetJoystick *currentSet = getActiveSetJoystick();
-
-    for (int i = 0; i < currentSet->getNumberHats(); i++)
-    {
-        JoyDPad *tempDPad = currentSet->getJoyDPad(i);
-
-        if ((tempDPad != nullptr) && tempDPad->hasPendingEvent())
-            tempDPad->activatePendingEvent();
-    }
+    activateDirtyElements(getActiveSetJoystick()->getDirtyDPads());
 }
 
 void InputDevice::activatePossibleVDPadEvents()
 {
-    SetJoystick *currentSet = getActiveSetJoystick();
-
-    for (int i = 0; i < currentSet->getNumberVDPads(); i++)
-    {
-        VDPad *tempVDPad = currentSet->getVDPad(i);
-
-        if ((tempVDPad != nullptr) && tempVDPad->hasPendingEvent())
-            tempVDPad->activatePendingEvent();
-    }
+    activateDirtyElements(getActiveSetJoystick()->getDirtyVDPads());
 }
 
 void InputDevice::activatePossibleButtonEvents()
 {
-    SetJoystick *currentSet = getActiveSetJoystick();
-
-    for (int i = 0; i < currentSet->getNumberButtons(); i++)
-    {
-        JoyButton *tempButton = currentSet->getJoyButton(i);
-
-        if ((tempButton != nullptr) && tempButton->hasPendingEvent())
-            tempButton->activatePendingEvent();
-    }
+    activateDirtyElements(getActiveSetJoystick()->getDirtyButtons());
 }
 
 bool InputDevice::elementsHaveNames()
@@ -1739,6 +1724,131 @@ SDL_GameControllerType InputDevice::getControllerType() const { return SDL_CONTR
  */
 InputDeviceCalibration *InputDevice::getCalibrationBackend() { return &m_calibrations; }
 
+JoyKeyRepeatHelper *InputDevice::getKeyRepeatHelper() { return &m_keyRepeatHelper; }
+
+/**
+ * @brief Device level counters. Only input events received by device and
+ *     axis events coalesced before dispatch are counted here, everything
+ *     else is counted by elements.
+ */
+ElementCounters &InputDevice::getCounters() { return counters; }
+
+/**
+ * @brief Counters of sticks, axes, hats, sensors and buttons summed over
+ *     all sets. Counters of buttons belonging to a stick, axis, hat or
+ *     sensor are added to it, so the element driving a macro or mouse
+ *     movement shows its cost.
+ */
+QList<ElementCountersEntry> InputDevice::collectElementCounters()
+{
+    QList<ElementCountersEntry> entries;
+    QHash<QString, int> positions;
+
+    auto addEntry = [&entries, &positions](const QString &element, const ElementCounters::Values &values) {
+        auto iter = positions.constFind(element);
+
+        if (iter == positions.constEnd())
+        {
+            positions.insert(element, entries.size());
+            entries.append({element, values});
+        } else
+        {
+            entries[iter.value()].values += values;
+        }
+    };
+
+    for (SetJoystick *set : joystick_sets)
+    {
+        for (int i = 0; i < set->getNumberSticks(); i++)
+        {
+            JoyControlStick *stick = set->getJoyStick(i);
+
+            if (stick == nullptr)
+                continue;
+
+            ElementCounters::Values values = stick->getCounters().values();
+
+            for (JoyControlStickButton *button : *stick->getButtons())
+                values += button->getCounters().values();
+
+            if (stick->getModifierButton() != nullptr)
+                values += stick->getModifierButton()->getCounters().values();
+
+            addEntry(QString("Stick %1").arg(stick->getRealJoyIndex()), values);
+        }
+
+        for (int i = 0; i < set->getNumberAxes(); i++)
+        {
+            JoyAxis *axis = set->getJoyAxis(i);
+
+            if (axis == nullptr)
+                continue;
+
+            ElementCounters::Values values = axis->getCounters().values();
+            values += axis->getNAxisButton()->getCounters().values();
+            values += axis->getPAxisButton()->getCounters().values();
+            addEntry(QString("Axis %1").arg(axis->getRealJoyIndex()), values);
+        }
+
+        for (int i = 0; i < set->getNumberHats(); i++)
+        {
+            JoyDPad *dpad = set->getJoyDPad(i);
+
+            if (dpad == nullptr)
+                continue;
+
+            ElementCounters::Values values = dpad->getCounters().values();
+
+            for (JoyDPadButton *button : *dpad->getButtons())
+                values += button->getCounters().values();
+
+            addEntry(QString("Hat %1").arg(dpad->getRealJoyNumber()), values);
+        }
+
+        for (int i = 0; i < SENSOR_COUNT; i++)
+        {
+            JoySensor *sensor = set->getSensor(static_cast<JoySensorType>(i));
+
+            if (sensor == nullptr)
+                continue;
+
+            ElementCounters::Values values = sensor->getCounters().values();
+
+            for (JoySensorButton *button : *sensor->getButtons())
+                values += button->getCounters().values();
+
+            addEntry((sensor->getType() == ACCELEROMETER) ? QString("Accelerometer") : QString("Gyroscope"), values);
+        }
+
+        for (int i = 0; i < set->getNumberButtons(); i++)
+        {
+            JoyButton *button = set->getJoyButton(i);
+
+            if (button != nullptr)
+                addEntry(QString("Button %1").arg(button->getRealJoyNumber()), button->getCounters().values());
+        }
+    }
+
+    return entries;
+}
+
+/**
+ * @brief Input events received by device together with sum of element
+ *     counters returned by collectElementCounters.
+ */
+ElementCounters::Values InputDevice::getCounterTotals(const QList<ElementCountersEntry> &entries)
+{
+    ElementCounters::Values totals;
+
+    for (const ElementCountersEntry &entry : entries)
+        totals += entry.values;
+
+    ElementCounters::Values own = counters.values();
+    totals.received = own.received;
+    totals.coalesced += own.coalesced;
+    return totals;
+}
+
 /**
  * @brief Updates stored calibration for this controller and applies
  *   calibration to the specified stick in all sets
@@ -19,7 +19,9 @@
 #ifndef INPUTDEVICE_H
 #define INPUTDEVICE_H
 
+#include "elementcounters.h"
 #include "inputdevicecalibration.h"
+#include "joykeyrepeathelper.h"
 #include "joysensordirection.h"
 #include "joysensortype.h"
 #include "setjoystick.h"
@@ -164,6 +166,10 @@ class InputDevice : public QObject
     virtual SDL_GameControllerType getControllerType() const;
 
     InputDeviceCalibration *getCalibrationBackend();
+    JoyKeyRepeatHelper *getKeyRepeatHelper();
+    ElementCounters &getCounters();
+    QList<ElementCountersEntry> collectElementCounters();
+    ElementCounters::Values getCounterTotals(const QList<ElementCountersEntry> &entries);
     void updateStickCalibration(int index, double offsetX, double gainX, double offsetY, double gainY);
     void applyStickCalibration(int index, double offsetX, double gainX, double offsetY, double gainY);
     void updateAccelerometerCalibration(double offsetX, double offsetY, double offsetZ);
@@ -181,6 +187,7 @@ class InputDevice : public QObject
     int keyPressTime; // unsigned
     QString profileName;
     InputDeviceCalibration m_calibrations;
+    JoyKeyRepeatHelper m_keyRepeatHelper;
 
   signals:
     void setChangeActivated(int index);
@@ -285,6 +292,8 @@ class InputDevice : public QObject
     QList<bool> buttonstates;
     QList<int> axesstates;
     QList<int> dpadstates;
+
+    ElementCounters counters;
 };
 
 Q_DECLARE_METATYPE(InputDevice *)
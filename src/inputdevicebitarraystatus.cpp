@@ -25,117 +25,117 @@
 #include "setjoystick.h"
 
 #include <QDebug>
+#include <QtAlgorithms>
 
+static const int BITS_PER_WORD = 64;
+
+/**
+ * @brief Bits are laid out as axes, hats, buttons and sensors, the same
+ *     order as in generateFinalBitArray. When readCurrent is set, bits not
+ *     changed during the poll report current state of the element.
+ */
 InputDeviceBitArrayStatus::InputDeviceBitArrayStatus(InputDevice *device, bool readCurrent, QObject *parent)
     : QObject(parent)
+    , m_device(device)
+    , m_read_current(readCurrent)
+    , m_dirty(false)
 {
-    for (int i = 0; i < device->getNumberRawAxes(); i++)
-    {
-        SetJoystick *currentSet = device->getActiveSetJoystick();
-        JoyAxis *axis = currentSet->getJoyAxis(i);
-
-        if ((axis != nullptr) && readCurrent)
-        {
-            axesStatus.append(!axis->inDeadZone(axis->getCurrentRawValue()) ? true : false);
-        } else
-        {
-            axesStatus.append(false);
-        }
-    }
-
-    for (int i = 0; i < device->getNumberRawHats(); i++)
-    {
-        SetJoystick *currentSet = device->getActiveSetJoystick();
-        JoyDPad *dpad = currentSet->getJoyDPad(i);
-
-        if ((dpad != nullptr) && readCurrent)
-        {
-            hatButtonStatus.append(dpad->getCurrentDirection() != JoyDPadButton::DpadCentered ? true : false);
-        } else
-        {
-            hatButtonStatus.append(false);
-        }
-    }
+    m_hat_offset = device->getNumberRawAxes();
+    m_button_offset = m_hat_offset + device->getNumberRawHats();
+    m_sensor_offset = m_button_offset + device->getNumberRawButtons();
+    m_total_bits = m_sensor_offset + SENSOR_COUNT;
+
+    int words = (m_total_bits + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    m_status_words.fill(0, words);
+    m_changed_words.fill(0, words);
+}
 
-    getButtonStatusLocal().resize(device->getNumberRawButtons());
-    getButtonStatusLocal().fill(0);
+void InputDeviceBitArrayStatus::changeStatus(int offset, int count, int index, bool value)
+{
+    if ((index < 0) || (index >= count))
+        return;
 
-    for (int i = 0; i < device->getNumberRawButtons(); i++)
-    {
-        SetJoystick *currentSet = device->getActiveSetJoystick();
-        JoyButton *button = currentSet->getJoyButton(i);
+    int bit = offset + index;
+    quint64 mask = quint64(1) << (bit % BITS_PER_WORD);
+    quint64 &word = m_status_words[bit / BITS_PER_WORD];
 
-        if ((button != nullptr) && readCurrent)
-        {
-            getButtonStatusLocal().setBit(i, button->getButtonState());
-        }
-    }
-
-    m_sensor_status.resize(SENSOR_COUNT);
-    m_sensor_status.fill(0);
+    word = value ? (word | mask) : (word & ~mask);
+    m_changed_words[bit / BITS_PER_WORD] |= mask;
+    m_dirty = true;
 }
 
 void InputDeviceBitArrayStatus::changeAxesStatus(int axisIndex, bool value)
 {
-    if ((axisIndex >= 0) && (axisIndex <= axesStatus.size()))
-    {
-        axesStatus.replace(axisIndex, value);
-    }
+    changeStatus(0, m_hat_offset, axisIndex, value);
 }
 
 void InputDeviceBitArrayStatus::changeButtonStatus(int buttonIndex, bool value)
 {
-    if ((buttonIndex >= 0) && (buttonIndex <= getButtonStatusLocal().size()))
-    {
-        getButtonStatusLocal().setBit(buttonIndex, value);
-    }
+    changeStatus(m_button_offset, m_sensor_offset - m_button_offset, buttonIndex, value);
 }
 
 void InputDeviceBitArrayStatus::changeHatStatus(int hatIndex, bool value)
 {
-    if ((hatIndex >= 0) && (hatIndex <= hatButtonStatus.size()))
-    {
-        hatButtonStatus.replace(hatIndex, value);
-    }
+    changeStatus(m_hat_offset, m_button_offset - m_hat_offset, hatIndex, value);
 }
 
 void InputDeviceBitArrayStatus::changeSensorStatus(int sensorIndex, bool value)
 {
-    if ((sensorIndex >= 0) && (sensorIndex <= m_sensor_status.size()))
-    {
-        m_sensor_status.setBit(sensorIndex, value);
-    }
+    changeStatus(m_sensor_offset, m_total_bits - m_sensor_offset, sensorIndex, value);
 }
 
-QBitArray InputDeviceBitArrayStatus::generateFinalBitArray()
+/**
+ * @brief Check if any status was changed since last clearStatusValues().
+ */
+bool InputDeviceBitArrayStatus::isDirty() const { return m_dirty; }
+
+/**
+ * @brief Count bits set during the poll. Current state of elements
+ *     is not taken into account.
+ */
+int InputDeviceBitArrayStatus::countSetBits() const
 {
-    int totalArraySize = 0;
-    totalArraySize = axesStatus.size() + hatButtonStatus.size() + getButtonStatusLocal().size() + m_sensor_status.size();
-    QBitArray aggregateBitArray(totalArraySize, false);
-    int currentBit = 0;
+    int result = 0;
 
-    for (int i = 0; i < axesStatus.size(); i++)
-    {
-        aggregateBitArray.setBit(currentBit, axesStatus.at(i));
-        currentBit++;
-    }
+    for (quint64 word : m_status_words)
+        result += qPopulationCount(word);
 
-    for (int i = 0; i < hatButtonStatus.size(); i++)
-    {
-        aggregateBitArray.setBit(currentBit, hatButtonStatus.at(i));
-        currentBit++;
-    }
+    return result;
+}
+
+bool InputDeviceBitArrayStatus::readCurrentStatus(int bit) const
+{
+    SetJoystick *currentSet = m_device->getActiveSetJoystick();
 
-    for (int i = 0; i < getButtonStatusLocal().size(); i++)
+    if (bit < m_hat_offset)
     {
-        aggregateBitArray.setBit(currentBit, getButtonStatusLocal().at(i));
-        currentBit++;
+        JoyAxis *axis = currentSet->getJoyAxis(bit);
+        return (axis != nullptr) && !axis->inDeadZone(axis->getCurrentRawValue());
+    } else if (bit < m_button_offset)
+    {
+        JoyDPad *dpad = currentSet->getJoyDPad(bit - m_hat_offset);
+        return (dpad != nullptr) && (dpad->getCurrentDirection() != JoyDPadButton::DpadCentered);
+    } else if (bit < m_sensor_offset)
+    {
+        JoyButton *button = currentSet->getJoyButton(bit - m_button_offset);
+        return (button != nullptr) && button->getButtonState();
     }
 
-    for (int i = 0; i < SENSOR_COUNT; i++)
+    return false;
+}
+
+QBitArray InputDeviceBitArrayStatus::generateFinalBitArray()
+{
+    QBitArray aggregateBitArray(m_total_bits, false);
+
+    for (int i = 0; i < m_total_bits; i++)
     {
-        aggregateBitArray.setBit(currentBit, m_sensor_status.at(i));
-        currentBit++;
+        quint64 mask = quint64(1) << (i % BITS_PER_WORD);
+
+        if ((m_changed_words.at(i / BITS_PER_WORD) & mask) != 0)
+            aggregateBitArray.setBit(i, (m_status_words.at(i / BITS_PER_WORD) & mask) != 0);
+        else if (m_read_current)
+            aggregateBitArray.setBit(i, readCurrentStatus(i));
     }
 
     return aggregateBitArray;
@@ -143,14 +143,10 @@ QBitArray InputDeviceBitArrayStatus::generateFinalBitArray()
 
 void InputDeviceBitArrayStatus::clearStatusValues()
 {
-    for (int i = 0; i < axesStatus.size(); i++)
-        axesStatus.replace(i, false);
+    if (!m_dirty)
+        return;
 
-    for (int i = 0; i < hatButtonStatus.size(); i++)
-        hatButtonStatus.replace(i, false);
-
-    getButtonStatusLocal().fill(false);
-    m_sensor_status.fill(false);
+    m_status_words.fill(0);
+    m_changed_words.fill(0);
+    m_dirty = false;
 }
-
-QBitArray &InputDeviceBitArrayStatus::getButtonStatusLocal() { return buttonStatus; }
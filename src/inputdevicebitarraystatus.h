@@ -20,11 +20,16 @@
 #define INPUTDEVICESTATUSEVENT_H
 
 #include <QBitArray>
-#include <QList>
 #include <QObject>
+#include <QVector>
 
 class InputDevice;
 
+/**
+ * @brief Status bits of axes, hats, buttons and sensors of a device
+ *     collected during one poll. Storage is sized once for the device
+ *     and only cleared between polls.
+ */
 class InputDeviceBitArrayStatus : public QObject
 {
     Q_OBJECT
@@ -37,16 +42,26 @@ class InputDeviceBitArrayStatus : public QObject
     void changeHatStatus(int hatIndex, bool value);
     void changeSensorStatus(int sensorIndex, bool value);
 
+    bool isDirty() const;
+    int countSetBits() const;
     QBitArray generateFinalBitArray();
     void clearStatusValues();
 
   private:
-    QBitArray &getButtonStatusLocal();
+    void changeStatus(int offset, int count, int index, bool value);
+    bool readCurrentStatus(int bit) const;
+
+    InputDevice *m_device;
+    bool m_read_current;
+    bool m_dirty;
+
+    int m_hat_offset;
+    int m_button_offset;
+    int m_sensor_offset;
+    int m_total_bits;
 
-    QList<bool> axesStatus;
-    QList<bool> hatButtonStatus;
-    QBitArray buttonStatus;
-    QBitArray m_sensor_status;
+    QVector<quint64> m_status_words;
+    QVector<quint64> m_changed_words;
 };
 
 #endif // INPUTDEVICESTATUSEVENT_H
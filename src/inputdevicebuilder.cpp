@@ -0,0 +1,158 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "inputdevicebuilder.h"
+
+#include "antimicrosettings.h"
+#include "gamecontroller/gamecontroller.h"
+#include "gamecontroller/gamecontrollermappingstore.h"
+#include "inputdaemon.h"
+#include "joystick.h"
+
+#include <SDL2/SDL_gamecontroller.h>
+#include <SDL2/SDL_joystick.h>
+
+#include <QDebug>
+#include <QThread>
+
+InputDeviceBuilder::InputDeviceBuilder(AntiMicroSettings *settings, QObject *parent)
+    : QObject(parent)
+    , m_settings(settings)
+{
+}
+
+/**
+ * @brief Build devices for SDL instance ids reported in one poll.
+ *     Devices are created without parent, so they can be moved to
+ *     targetThread before being emitted.
+ */
+void InputDeviceBuilder::buildDevices(QList<SDL_JoystickID> instanceIDs, QThread *targetThread)
+{
+    QMap<QString, int> uniques = QMap<QString, int>();
+    int counterUniques = 1;
+    bool duplicatedGamepad = false;
+
+    for (SDL_JoystickID instanceID : instanceIDs)
+    {
+        int index = resolveDeviceIndex(instanceID);
+
+        if (index < 0)
+        {
+            qDebug() << "Device with instance id" << instanceID << "was removed before it could be built";
+            continue;
+        }
+
+        InputDevice *device = buildDevice(index, uniques, counterUniques, duplicatedGamepad);
+
+        if (device != nullptr)
+        {
+            device->moveToThread(targetThread);
+            emit deviceBuilt(device);
+        }
+    }
+}
+
+/**
+ * @brief Device indexes shift when other devices are removed between
+ *     the poll and the build, so look the index up again by instance id.
+ * @return Current device index or -1 if device is gone.
+ */
+int InputDeviceBuilder::resolveDeviceIndex(SDL_JoystickID instanceID)
+{
+    for (int i = 0; i < SDL_NumJoysticks(); i++)
+    {
+        if (SDL_JoystickGetDeviceInstanceID(i) == instanceID)
+            return i;
+    }
+
+    return -1;
+}
+
+InputDevice *InputDeviceBuilder::buildDevice(int index, QMap<QString, int> &uniques, int &counterUniques,
+                                             bool &duplicatedGamepad)
+{
+    InputDevice *device = nullptr;
+
+    if (InputDaemon::isOwnVirtualDevice(index))
+        return device;
+
+    GameControllerMappingStore::registerDevice(index);
+
+    SDL_GameController *controller = SDL_GameControllerOpen(index);
+    SDL_Joystick *joystick = SDL_JoystickOpen(index);
+
+    if (joystick != nullptr)
+    {
+        m_settings->getLock()->lock();
+        m_settings->beginGroup("Mappings");
+
+        QString guidText = InputDaemon::getJoyInfo(SDL_JoystickGetGUID(joystick));
+        QString vendor = QString();
+        QString productID = QString();
+
+        if (controller != nullptr)
+        {
+            vendor = InputDaemon::getJoyInfo(SDL_GameControllerGetVendor(controller));
+            productID = InputDaemon::getJoyInfo(SDL_GameControllerGetProduct(controller));
+        }
+
+        if (uniques.contains(guidText))
+        {
+            productID = InputDaemon::getJoyInfo(SDL_GameControllerGetProduct(controller) + ++uniques[guidText]);
+            duplicatedGamepad = true;
+            uniques.insert(guidText, uniques[guidText]);
+        } else
+        {
+            uniques.insert(guidText, counterUniques);
+        }
+
+        InputDaemon::convertMappingsToUnique(m_settings, guidText, guidText + vendor + productID);
+
+        int resultDuplicated = 0;
+        if (duplicatedGamepad)
+            resultDuplicated = uniques[guidText];
+
+        bool disableGameController =
+            m_settings->value(QString("%1Disable").arg(guidText + vendor + productID), false).toBool();
+
+        if (SDL_IsGameController(index) && !disableGameController)
+        {
+            // Make sure to decrement reference count
+            SDL_JoystickClose(joystick);
+
+            SDL_GameController *gameController = SDL_GameControllerOpen(index);
+
+            if (gameController != nullptr)
+            {
+                device = new GameController(gameController, index, m_settings, resultDuplicated, nullptr);
+                duplicatedGamepad = false;
+            }
+        } else
+        {
+            device = new Joystick(joystick, index, m_settings, nullptr);
+        }
+
+        m_settings->endGroup();
+        m_settings->getLock()->unlock();
+    }
+
+    // Handle was only needed for vendor and product info
+    if (controller != nullptr)
+        SDL_GameControllerClose(controller);
+
+    return device;
+}
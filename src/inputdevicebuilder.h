@@ -0,0 +1,56 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INPUTDEVICEBUILDER_H
+#define INPUTDEVICEBUILDER_H
+
+#include <SDL2/SDL_joystick.h>
+
+#include <QList>
+#include <QMap>
+#include <QObject>
+
+class AntiMicroSettings;
+class InputDevice;
+class QThread;
+
+/**
+ * @brief Opens hot-plugged devices and constructs their InputDevice
+ *  objects outside of the input thread. Finished devices are moved to
+ *  the target thread and handed over through deviceBuilt().
+ */
+class InputDeviceBuilder : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit InputDeviceBuilder(AntiMicroSettings *settings, QObject *parent = nullptr);
+
+  signals:
+    void deviceBuilt(InputDevice *device);
+
+  public slots:
+    void buildDevices(QList<SDL_JoystickID> instanceIDs, QThread *targetThread);
+
+  private:
+    static int resolveDeviceIndex(SDL_JoystickID instanceID);
+    InputDevice *buildDevice(int index, QMap<QString, int> &uniques, int &counterUniques, bool &duplicatedGamepad);
+
+    AntiMicroSettings *m_settings;
+};
+
+#endif // INPUTDEVICEBUILDER_H
@@ -0,0 +1,230 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "inputtracerecorder.h"
+
+#include "inputdevice.h"
+#include "logger.h"
+
+#include <SDL2/SDL_timer.h>
+
+#include <QDebug>
+
+InputTraceRecorder::InputTraceRecorder()
+    : lastTimestamp(0)
+    , eventCount(0)
+{
+}
+
+InputTraceRecorder::~InputTraceRecorder() { close(); }
+
+bool InputTraceRecorder::open(const QString &fileName)
+{
+    close();
+    file.setFileName(fileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "Could not open input trace " << fileName << " for writing";
+        return false;
+    }
+
+    stream.setDevice(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream << MAGIC << VERSION;
+
+    recordedDevices.clear();
+    lastTimestamp = SDL_GetTicks();
+    eventCount = 0;
+
+    qInfo() << "Recording input trace to " << fileName;
+    return true;
+}
+
+void InputTraceRecorder::close()
+{
+    if (!file.isOpen())
+        return;
+
+    stream.setDevice(nullptr);
+    file.close();
+
+    qInfo() << "Input trace " << file.fileName() << " closed after " << eventCount << " events";
+}
+
+bool InputTraceRecorder::isOpen() const { return file.isOpen(); }
+
+/**
+ * @brief Append event generated by device. Events not related to input
+ *     elements are skipped.
+ */
+void InputTraceRecorder::record(const SDL_Event &event, SDL_JoystickID deviceID, InputDevice *device)
+{
+    if (!file.isOpen() || !isTraceable(event.type))
+        return;
+
+    if (!recordedDevices.contains(deviceID))
+        recordDevice(deviceID, device);
+
+    // Unsigned difference stays correct when SDL ticks wrap around
+    Uint32 delta = event.common.timestamp - lastTimestamp;
+    lastTimestamp = event.common.timestamp;
+
+    stream << static_cast<quint8>(EventRecord) << static_cast<quint32>(delta) << static_cast<quint16>(event.type);
+    writeEventData(stream, event);
+    eventCount++;
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        qWarning() << "Writing input trace " << file.fileName() << " failed, recording stopped";
+        close();
+    }
+}
+
+void InputTraceRecorder::recordDevice(SDL_JoystickID deviceID, InputDevice *device)
+{
+    recordedDevices.insert(deviceID);
+
+    stream << static_cast<quint8>(DeviceRecord) << static_cast<qint32>(deviceID) << device->isGameController()
+           << device->getGUIDString() << device->getUniqueIDString() << device->getSDLName()
+           << static_cast<qint32>(device->getNumberRawButtons()) << static_cast<qint32>(device->getNumberRawAxes())
+           << static_cast<qint32>(device->getNumberRawHats());
+
+    DEBUG() << "Input trace device " << deviceID << ": " << device->getSDLName();
+}
+
+bool InputTraceRecorder::isTraceable(Uint32 type)
+{
+    switch (type)
+    {
+    case SDL_JOYAXISMOTION:
+    case SDL_JOYHATMOTION:
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP:
+    case SDL_CONTROLLERAXISMOTION:
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    case SDL_CONTROLLERSENSORUPDATE:
+#endif
+        return true;
+    default:
+        return false;
+    }
+}
+
+void InputTraceRecorder::writeEventData(QDataStream &stream, const SDL_Event &event)
+{
+    switch (event.type)
+    {
+    case SDL_JOYAXISMOTION:
+        stream << static_cast<qint32>(event.jaxis.which) << static_cast<quint8>(event.jaxis.axis)
+               << static_cast<qint16>(event.jaxis.value);
+        break;
+    case SDL_JOYHATMOTION:
+        stream << static_cast<qint32>(event.jhat.which) << static_cast<quint8>(event.jhat.hat)
+               << static_cast<quint8>(event.jhat.value);
+        break;
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP:
+        stream << static_cast<qint32>(event.jbutton.which) << static_cast<quint8>(event.jbutton.button);
+        break;
+    case SDL_CONTROLLERAXISMOTION:
+        stream << static_cast<qint32>(event.caxis.which) << static_cast<quint8>(event.caxis.axis)
+               << static_cast<qint16>(event.caxis.value);
+        break;
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+        stream << static_cast<qint32>(event.cbutton.which) << static_cast<quint8>(event.cbutton.button);
+        break;
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    case SDL_CONTROLLERSENSORUPDATE:
+        stream << static_cast<qint32>(event.csensor.which) << static_cast<qint32>(event.csensor.sensor)
+               << event.csensor.data[0] << event.csensor.data[1] << event.csensor.data[2];
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Fill event of given type from fields written by writeEventData.
+ * @return false for unknown types or truncated data
+ */
+bool InputTraceRecorder::readEventData(QDataStream &stream, Uint32 type, SDL_Event &event)
+{
+    qint32 which = 0;
+    quint8 index = 0;
+    qint16 value = 0;
+
+    SDL_memset(&event, 0, sizeof(event));
+    event.type = type;
+    stream >> which;
+
+    switch (type)
+    {
+    case SDL_JOYAXISMOTION:
+        stream >> index >> value;
+        event.jaxis.which = which;
+        event.jaxis.axis = index;
+        event.jaxis.value = value;
+        break;
+    case SDL_JOYHATMOTION: {
+        quint8 hatValue = 0;
+        stream >> index >> hatValue;
+        event.jhat.which = which;
+        event.jhat.hat = index;
+        event.jhat.value = hatValue;
+        break;
+    }
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP:
+        stream >> index;
+        event.jbutton.which = which;
+        event.jbutton.button = index;
+        event.jbutton.state = (type == SDL_JOYBUTTONDOWN) ? SDL_PRESSED : SDL_RELEASED;
+        break;
+    case SDL_CONTROLLERAXISMOTION:
+        stream >> index >> value;
+        event.caxis.which = which;
+        event.caxis.axis = index;
+        event.caxis.value = value;
+        break;
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+        stream >> index;
+        event.cbutton.which = which;
+        event.cbutton.button = index;
+        event.cbutton.state = (type == SDL_CONTROLLERBUTTONDOWN) ? SDL_PRESSED : SDL_RELEASED;
+        break;
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    case SDL_CONTROLLERSENSORUPDATE: {
+        qint32 sensor = 0;
+        stream >> sensor >> event.csensor.data[0] >> event.csensor.data[1] >> event.csensor.data[2];
+        event.csensor.which = which;
+        event.csensor.sensor = sensor;
+        break;
+    }
+#endif
+    default:
+        return false;
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
@@ -0,0 +1,72 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INPUTTRACERECORDER_H
+#define INPUTTRACERECORDER_H
+
+#include <QDataStream>
+#include <QFile>
+#include <QSet>
+
+#include <SDL2/SDL_events.h>
+
+class InputDevice;
+
+/**
+ * @brief Writes raw SDL input events of opened devices into a compact
+ *     binary trace. The file starts with magic and version followed by
+ *     records. A device record with GUID, unique ID, name and element
+ *     counts precedes the first event of every device. An event record holds ms since
+ *     the previous record, SDL event type, device instance id and only
+ *     the fields used by that event type.
+ */
+class InputTraceRecorder
+{
+  public:
+    static const quint32 MAGIC = 0x414d5854;
+    static const quint16 VERSION = 2;
+
+    enum RecordType
+    {
+        DeviceRecord = 1,
+        EventRecord = 2
+    };
+
+    InputTraceRecorder();
+    ~InputTraceRecorder();
+
+    bool open(const QString &fileName);
+    void close();
+    bool isOpen() const;
+
+    void record(const SDL_Event &event, SDL_JoystickID deviceID, InputDevice *device);
+
+    static bool isTraceable(Uint32 type);
+    static void writeEventData(QDataStream &stream, const SDL_Event &event);
+    static bool readEventData(QDataStream &stream, Uint32 type, SDL_Event &event);
+
+  private:
+    void recordDevice(SDL_JoystickID deviceID, InputDevice *device);
+
+    QFile file;
+    QDataStream stream;
+    QSet<SDL_JoystickID> recordedDevices;
+    Uint32 lastTimestamp;
+    quint64 eventCount;
+};
+
+#endif // INPUTTRACERECORDER_H
@@ -0,0 +1,349 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "inputtracereplayer.h"
+
+#include "inputdaemon.h"
+#include "inputdevice.h"
+#include "inputtracerecorder.h"
+#include "logger.h"
+
+#include <SDL2/SDL_gamecontroller.h>
+#include <SDL2/SDL_timer.h>
+
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QThread>
+
+#include <climits>
+
+// Events pushed at once when replaying without delays, keeps SDL queue from overflowing
+static const int MAX_BURST = 256;
+
+/**
+ * @brief Field of event holding SDL instance id of its device.
+ */
+static SDL_JoystickID *eventDeviceID(SDL_Event &event)
+{
+    switch (event.type)
+    {
+    case SDL_JOYAXISMOTION:
+        return &event.jaxis.which;
+    case SDL_JOYHATMOTION:
+        return &event.jhat.which;
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP:
+        return &event.jbutton.which;
+    case SDL_CONTROLLERAXISMOTION:
+        return &event.caxis.which;
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+        return &event.cbutton.which;
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    case SDL_CONTROLLERSENSORUPDATE:
+        return &event.csensor.which;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+InputTraceReplayer::InputTraceReplayer(InputDaemon *daemon, QMap<SDL_JoystickID, InputDevice *> *joysticks,
+                                       QObject *parent)
+    : QObject(parent)
+    , m_daemon(daemon)
+    , m_joysticks(joysticks)
+    , nextEvent(0)
+    , skippedEvents(0)
+    , m_speed(1.0)
+{
+    replayTimer.setParent(this);
+    replayTimer.setSingleShot(true);
+    replayTimer.setTimerType(Qt::PreciseTimer);
+    connect(&replayTimer, &QTimer::timeout, this, &InputTraceReplayer::replayDueEvents);
+}
+
+/**
+ * @brief Load whole trace into memory.
+ */
+bool InputTraceReplayer::open(const QString &fileName)
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Could not open input trace " << fileName;
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+
+    if ((magic != InputTraceRecorder::MAGIC) || (version < 1) || (version > InputTraceRecorder::VERSION))
+    {
+        qWarning() << "File " << fileName << " is not a supported input trace";
+        return false;
+    }
+
+    devices.clear();
+    events.clear();
+    qint64 time = 0;
+
+    while (!stream.atEnd() && (stream.status() == QDataStream::Ok))
+    {
+        quint8 recordType = 0;
+        stream >> recordType;
+
+        if (recordType == InputTraceRecorder::DeviceRecord)
+        {
+            qint32 deviceID = 0;
+            TraceDevice device;
+            stream >> deviceID >> device.gameController >> device.guid >> device.uniqueID >> device.name;
+            device.buttons = 0;
+            device.axes = 0;
+            device.hats = 0;
+            device.targetID = -1;
+
+            // Version 1 has no element counts, they are taken from events
+            if (version >= 2)
+            {
+                qint32 buttons = 0;
+                qint32 axes = 0;
+                qint32 hats = 0;
+                stream >> buttons >> axes >> hats;
+                device.buttons = buttons;
+                device.axes = axes;
+                device.hats = hats;
+            }
+
+            devices.insert(deviceID, device);
+        } else if (recordType == InputTraceRecorder::EventRecord)
+        {
+            quint32 delta = 0;
+            quint16 type = 0;
+            TraceEvent entry;
+            stream >> delta >> type;
+
+            if (!InputTraceRecorder::readEventData(stream, type, entry.event))
+                break;
+
+            time += delta;
+            entry.time = time;
+            events.append(entry);
+            countEventElements(entry.event);
+        } else
+        {
+            break;
+        }
+    }
+
+    if (!stream.atEnd() || (stream.status() != QDataStream::Ok))
+        qWarning() << "Input trace " << fileName << " is damaged, replaying first " << events.size() << " events";
+
+    qInfo() << "Loaded input trace " << fileName << " with " << events.size() << " events of " << devices.size()
+            << " devices";
+    return true;
+}
+
+void InputTraceReplayer::setSpeed(double speed) { m_speed = qMax(0.0, speed); }
+
+/**
+ * @brief Assign devices to recorded ones and start replay from the
+ *     beginning.
+ */
+void InputTraceReplayer::start()
+{
+    // Devices are owned by the daemon thread, match and open them there
+    Qt::ConnectionType type =
+        (m_daemon->thread() == QThread::currentThread()) ? Qt::DirectConnection : Qt::BlockingQueuedConnection;
+    QMetaObject::invokeMethod(m_daemon, [this]() { assignTargetDevices(); }, type);
+
+    nextEvent = 0;
+    skippedEvents = 0;
+    replayClock.start();
+    replayDueEvents();
+}
+
+void InputTraceReplayer::stop()
+{
+    replayTimer.stop();
+    nextEvent = events.size();
+}
+
+void InputTraceReplayer::replayDueEvents()
+{
+    qint64 now = replayClock.elapsed();
+    int burst = 0;
+
+    while (nextEvent < events.size())
+    {
+        const TraceEvent &entry = events.at(nextEvent);
+
+        if (m_speed > 0.0)
+        {
+            qint64 due = qRound64(entry.time / m_speed);
+
+            if (due > now)
+            {
+                replayTimer.start(static_cast<int>(qMin<qint64>(due - now, INT_MAX)));
+                return;
+            }
+        } else if (burst >= MAX_BURST)
+        {
+            replayTimer.start(1);
+            return;
+        }
+
+        SDL_Event event = entry.event;
+        SDL_JoystickID *deviceID = eventDeviceID(event);
+        auto device = devices.constFind(*deviceID);
+        nextEvent++;
+        burst++;
+
+        if ((device == devices.constEnd()) || (device.value().targetID == -1))
+        {
+            skippedEvents++;
+            continue;
+        }
+
+        *deviceID = device.value().targetID;
+        event.common.timestamp = SDL_GetTicks();
+
+        if (SDL_PushEvent(&event) < 0)
+            skippedEvents++;
+    }
+
+    qInfo() << "Input trace replay finished, " << skippedEvents << " of " << events.size() << " events skipped";
+    emit finished();
+}
+
+/**
+ * @brief Pick an opened device for every recorded one or open a virtual
+ *     device in its place. Runs in thread of the daemon.
+ */
+void InputTraceReplayer::assignTargetDevices()
+{
+    QSet<SDL_JoystickID> usedTargets;
+
+    for (auto iter = devices.begin(); iter != devices.end(); ++iter)
+    {
+        TraceDevice &device = iter.value();
+        device.targetID = findTargetDevice(device, usedTargets);
+
+        if (device.targetID == -1)
+        {
+            device.targetID = m_daemon->addVirtualDevice(device.gameController, device.name, device.guid,
+                                                         device.uniqueID, device.buttons, device.axes, device.hats);
+            qInfo() << "Replaying events of " << device.name << " recorded as " << iter.key()
+                    << " through virtual device " << device.targetID;
+        } else
+        {
+            qInfo() << "Replaying events of " << device.name << " recorded as " << iter.key() << " through device "
+                    << device.targetID;
+        }
+
+        usedTargets.insert(device.targetID);
+    }
+}
+
+/**
+ * @brief Opened device matching recorded one best, preferring devices
+ *     not used for another recorded device. A device of another model is
+ *     used only when its element counts equal recorded ones, otherwise
+ *     indexes of elements would not match.
+ */
+SDL_JoystickID InputTraceReplayer::findTargetDevice(const TraceDevice &device, const QSet<SDL_JoystickID> &usedTargets)
+{
+    InputDevice *sameGuid = nullptr;
+    InputDevice *sameKind = nullptr;
+
+    for (InputDevice *candidate : *m_joysticks)
+    {
+        if (usedTargets.contains(candidate->getSDLJoystickID()))
+            continue;
+
+        if (!device.uniqueID.isEmpty() && (candidate->getUniqueIDString() == device.uniqueID))
+            return candidate->getSDLJoystickID();
+
+        if ((sameGuid == nullptr) && (candidate->getGUIDString() == device.guid))
+            sameGuid = candidate;
+
+        if ((sameKind == nullptr) && (candidate->isGameController() == device.gameController) &&
+            (candidate->getNumberRawButtons() == device.buttons) && (candidate->getNumberRawAxes() == device.axes) &&
+            (candidate->getNumberRawHats() == device.hats))
+        {
+            sameKind = candidate;
+        }
+    }
+
+    if (sameGuid != nullptr)
+        return sameGuid->getSDLJoystickID();
+
+    if (sameKind != nullptr)
+    {
+        qWarning() << "Replaying events of " << device.name << " through different device " << sameKind->getSDLName()
+                   << " with the same layout";
+        return sameKind->getSDLJoystickID();
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Raise element counts of recorded device to cover indexes used
+ *     by event. Game controllers have fixed layout.
+ */
+void InputTraceReplayer::countEventElements(const SDL_Event &event)
+{
+    SDL_Event copy = event;
+    SDL_JoystickID *deviceID = eventDeviceID(copy);
+
+    if ((deviceID == nullptr) || !devices.contains(*deviceID))
+        return;
+
+    TraceDevice &device = devices[*deviceID];
+
+    if (device.gameController)
+    {
+        device.buttons = SDL_CONTROLLER_BUTTON_MAX;
+        device.axes = SDL_CONTROLLER_AXIS_MAX;
+        device.hats = 0;
+        return;
+    }
+
+    switch (event.type)
+    {
+    case SDL_JOYAXISMOTION:
+        device.axes = qMax(device.axes, event.jaxis.axis + 1);
+        break;
+    case SDL_JOYHATMOTION:
+        device.hats = qMax(device.hats, event.jhat.hat + 1);
+        break;
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP:
+        device.buttons = qMax(device.buttons, event.jbutton.button + 1);
+        break;
+    default:
+        break;
+    }
+}
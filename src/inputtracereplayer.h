@@ -0,0 +1,99 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INPUTTRACEREPLAYER_H
+#define INPUTTRACEREPLAYER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+#include <QVector>
+
+#include <SDL2/SDL_events.h>
+
+class InputDaemon;
+class InputDevice;
+
+/**
+ * @brief Feeds events of a trace written by InputTraceRecorder back into
+ *     the SDL event queue, so they take the same path as live input.
+ *     Every recorded device is replayed through an opened device with the
+ *     same unique ID, GUID or at least the same kind and element counts.
+ *     Without such device a virtual device with recorded identity and
+ *     layout is opened, so traces replay without the original hardware.
+ *     Events keep their recorded spacing divided by speed. Speed 0
+ *     replays without delays.
+ */
+class InputTraceReplayer : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit InputTraceReplayer(InputDaemon *daemon, QMap<SDL_JoystickID, InputDevice *> *joysticks,
+                                QObject *parent = nullptr);
+
+    bool open(const QString &fileName);
+    void setSpeed(double speed);
+
+  signals:
+    void finished();
+
+  public slots:
+    void start();
+    void stop();
+
+  private slots:
+    void replayDueEvents();
+
+  private:
+    struct TraceDevice
+    {
+        bool gameController;
+        QString guid;
+        QString uniqueID;
+        QString name;
+        int buttons;
+        int axes;
+        int hats;
+        SDL_JoystickID targetID;
+    };
+
+    struct TraceEvent
+    {
+        qint64 time;
+        SDL_Event event;
+    };
+
+    void assignTargetDevices();
+    SDL_JoystickID findTargetDevice(const TraceDevice &device, const QSet<SDL_JoystickID> &usedTargets);
+    void countEventElements(const SDL_Event &event);
+
+    InputDaemon *m_daemon;
+    QMap<SDL_JoystickID, InputDevice *> *m_joysticks;
+    QHash<SDL_JoystickID, TraceDevice> devices;
+    QVector<TraceEvent> events;
+    int nextEvent;
+    int skippedEvents;
+    double m_speed;
+    QTimer replayTimer;
+    QElapsedTimer replayClock;
+};
+
+#endif // INPUTTRACEREPLAYER_H
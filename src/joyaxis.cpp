@@ -55,6 +55,8 @@ JoyAxis::~JoyAxis() { resetPrivateVars(); }
 
 void JoyAxis::queuePendingEvent(int value, bool ignoresets, bool updateLastValues)
 {
+    counters.addReceived();
+
     if (m_calibrated)
         value = value * m_gain + m_offset;
 
@@ -66,6 +68,11 @@ void JoyAxis::queuePendingEvent(int value, bool ignoresets, bool updateLastValue
         stickPassEvent(value, ignoresets, updateLastValues);
     } else
     {
+        if (pendingEvent)
+            counters.addCoalesced();
+        else if (m_parentSet != nullptr)
+            m_parentSet->queueDirtyAxis(this);
+
         pendingEvent = true;
         pendingValue = value;
         pendingIgnoreSets = ignoresets;
@@ -86,6 +93,8 @@ void JoyAxis::activatePendingEvent()
 
 bool JoyAxis::hasPendingEvent() { return pendingEvent; }
 
+ElementCounters &JoyAxis::getCounters() { return counters; }
+
 void JoyAxis::clearPendingEvent()
 {
     pendingEvent = false;
@@ -129,6 +138,8 @@ void JoyAxis::stickPassEvent(int value, bool ignoresets, bool updateLastValues)
 
 void JoyAxis::joyEvent(int value, bool ignoresets, bool updateLastValues)
 {
+    ElementCounters::Scope scope(counters);
+
     if ((m_stick != nullptr) && !pendingEvent)
     {
         stickPassEvent(value, ignoresets, updateLastValues);
@@ -318,6 +329,7 @@ int JoyAxis::getIndex() { return m_index; }
 
 void JoyAxis::createDeskEvent(bool ignoresets)
 {
+    ElementCounters::Scope scope(counters);
     JoyAxisButton *eventbutton = nullptr;
 
     if (currentThrottledValue > deadZone)
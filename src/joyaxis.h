@@ -22,6 +22,7 @@
 #include <QList>
 #include <QObject>
 
+#include "elementcounters.h"
 #include "haptictriggermodeps5.h"
 #include "joybuttontypes/joyaxisbutton.h"
 
@@ -60,6 +61,7 @@ class JoyAxis : public QObject
     bool hasPendingEvent();                                                                   // JoyAxisEvent class
     void clearPendingEvent();                                                                 // JoyAxisEvent class
     bool inDeadZone(int value);
+    ElementCounters &getCounters();
 
     virtual QString getName(bool forceFullFormat = false, bool displayNames = false);
     virtual QString getPartialName(bool forceFullFormat = false, bool displayNames = false);
@@ -228,6 +230,8 @@ class JoyAxis : public QObject
     double m_offset;
     double m_gain;
 
+    ElementCounters counters;
+
     void resetPrivateVars();
 };
 
@@ -68,6 +68,15 @@ void JoyButtonMouseHelper::moveSpringMouse()
         emit mouseSpringMoved(finalx, finaly);
 }
 
+/**
+ * @brief Perform high resolution wheel movement.
+ */
+void JoyButtonMouseHelper::moveMouseWheel()
+{
+    JoyButton::moveMouseWheel(JoyButton::getTestOldMouseTime()->elapsed(), JoyButton::getPendingWheelButtons(),
+                              GlobalVariables::JoyButton::wheelRemainderX, GlobalVariables::JoyButton::wheelRemainderY);
+}
+
 /**
  * @brief Perform mouse events for all buttons and slots.
  */
@@ -93,6 +102,8 @@ void JoyButtonMouseHelper::mouseEvent()
         moveSpringMouse();
     }
 
+    moveMouseWheel();
+
     JoyButton::restartLastMouseTime(JoyButton::getTestOldMouseTime());
     firstSpringEvent = false;
 }
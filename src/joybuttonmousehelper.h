@@ -44,6 +44,7 @@ class JoyButtonMouseHelper : public QObject
   public slots:
     void moveMouseCursor();
     void moveSpringMouse();
+    void moveMouseWheel();
     void mouseEvent();
     void changeThread(QThread *thread);
 
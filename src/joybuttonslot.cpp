@@ -26,6 +26,8 @@
 #include <QDebug>
 #include <QFileInfo>
 
+#include <SDL2/SDL_gamecontroller.h>
+
 JoyButtonSlot::JoyButtonSlot(QObject *parent)
     : QObject(parent)
     , extraData()
@@ -37,6 +39,8 @@ JoyButtonSlot::JoyButtonSlot(QObject *parent)
     previousDistance = 0.0;
     easingActive = false;
     mix_slots = nullptr;
+    resolvedCode = 0;
+    resolvedGeneration = -1;
 }
 
 JoyButtonSlot::JoyButtonSlot(int code, JoySlotInputAction mode, QObject *parent)
@@ -74,6 +78,8 @@ JoyButtonSlot::JoyButtonSlot(QString text, JoySlotInputAction mode, QObject *par
     m_distance = 0.0;
     easingActive = false;
     mix_slots = nullptr;
+    resolvedCode = 0;
+    resolvedGeneration = -1;
 
     if ((mode == JoyLoadProfile) || (mode == JoyTextEntry) || (mode == JoyExecute))
     {
@@ -89,11 +95,14 @@ void JoyButtonSlot::setSlotCode(int code)
     {
         deviceCode = code;
         qkeyaliasCode = 0;
+        resolvedGeneration = -1;
     }
 }
 
 void JoyButtonSlot::setSlotCode(int code, int alias)
 {
+    resolvedGeneration = -1;
+
     if ((m_mode == JoyButtonSlot::JoyKeyboard) && (code > 0))
     {
         deviceCode = code;
@@ -109,7 +118,11 @@ int JoyButtonSlot::getSlotCodeAlias() const { return qkeyaliasCode; }
 
 int JoyButtonSlot::getSlotCode() const { return deviceCode; }
 
-void JoyButtonSlot::setSlotMode(JoySlotInputAction selectedMode) { m_mode = selectedMode; }
+void JoyButtonSlot::setSlotMode(JoySlotInputAction selectedMode)
+{
+    m_mode = selectedMode;
+    resolvedGeneration = -1;
+}
 
 JoyButtonSlot::JoySlotInputAction JoyButtonSlot::getSlotMode() const { return m_mode; }
 
@@ -148,7 +161,7 @@ void JoyButtonSlot::setDistance(double distance) { m_distance = distance; }
 
 double JoyButtonSlot::getMouseDistance() { return m_distance; }
 
-QElapsedTimer *JoyButtonSlot::getMouseInterval() { return &mouseInterval; }
+EngineElapsedTimer *JoyButtonSlot::getMouseInterval() { return &mouseInterval; }
 
 void JoyButtonSlot::restartMouseInterval() { mouseInterval.restart(); }
 
@@ -327,6 +340,13 @@ QString JoyButtonSlot::getSlotString()
 
             break;
         }
+        case JoyGamepadButton: {
+            const char *buttonName =
+                SDL_GameControllerGetStringForButton(static_cast<SDL_GameControllerButton>(deviceCode));
+            newlabel.append(tr("[Pad] %1").arg(buttonName != nullptr ? QString(buttonName) : QString::number(deviceCode)));
+
+            break;
+        }
         case JoyButtonSlot::JoyMix: {
             bool firstTime = true;
 
@@ -378,9 +398,13 @@ bool JoyButtonSlot::isEasingActive() const { return easingActive; }
 
 void JoyButtonSlot::setEasingStatus(bool isActive) { easingActive = isActive; }
 
-QElapsedTimer *JoyButtonSlot::getEasingTime() { return &easingTime; }
+EngineElapsedTimer *JoyButtonSlot::getEasingTime() { return &easingTime; }
 
-void JoyButtonSlot::setTextData(QString textData) { m_textData = textData; }
+void JoyButtonSlot::setTextData(QString textData)
+{
+    m_textData = textData;
+    resolvedGeneration = -1;
+}
 
 QString JoyButtonSlot::getTextData() const
 {
@@ -403,6 +427,8 @@ void JoyButtonSlot::copyAssignments(const JoyButtonSlot &slot)
     deviceCode = slot.deviceCode;
     qkeyaliasCode = slot.qkeyaliasCode;
     m_mode = slot.m_mode;
+    resolvedCode = 0;
+    resolvedGeneration = -1;
 
     if (slot.mix_slots != nullptr)
     {
@@ -415,7 +441,7 @@ void JoyButtonSlot::copyAssignments(const JoyButtonSlot &slot)
     m_distance = slot.m_distance;
     previousDistance = slot.previousDistance;
 
-    easingTime = QElapsedTimer();
+    easingTime.invalidate();
     if (slot.easingTime.isValid())
         easingTime.start();
     easingActive = slot.easingActive;
@@ -496,6 +522,31 @@ bool JoyButtonSlot::isValidSlot()
     return result;
 }
 
+/**
+ * @brief Store key code converted by event handler. Generation is compared
+ *     with the current one of event handler to detect outdated codes.
+ */
+void JoyButtonSlot::setResolvedCode(int code, int generation)
+{
+    resolvedCode = code;
+    resolvedGeneration = generation;
+}
+
+int JoyButtonSlot::getResolvedCode() const { return resolvedCode; }
+
+/**
+ * @brief Store complete key event sequence of text entry slot.
+ */
+void JoyButtonSlot::setResolvedSequence(const QVector<ResolvedKeyEvent> &sequence, int generation)
+{
+    resolvedSequence = sequence;
+    resolvedGeneration = generation;
+}
+
+const QVector<JoyButtonSlot::ResolvedKeyEvent> &JoyButtonSlot::getResolvedSequence() const { return resolvedSequence; }
+
+bool JoyButtonSlot::isResolved(int generation) const { return resolvedGeneration == generation; }
+
 JoyButtonSlot &JoyButtonSlot::operator=(JoyButtonSlot *slot)
 {
     copyAssignments(*slot);
@@ -19,11 +19,13 @@
 #ifndef JOYBUTTONSLOT_H
 #define JOYBUTTONSLOT_H
 
-#include <QElapsedTimer>
+#include "engineclock.h"
+
 #include <QObject>
 #include <QPointer>
 #include <QTime>
 #include <QVariant>
+#include <QVector>
 #include <QtWidgets/QApplication>
 
 class QXmlStreamReader;
@@ -56,7 +58,8 @@ class JoyButtonSlot : public QObject
         JoySetChange,
         JoyTextEntry,
         JoyExecute,
-        JoyMix
+        JoyMix,
+        JoyGamepadButton
     };
 
     enum JoySlotMouseDirection
@@ -80,6 +83,17 @@ class JoyButtonSlot : public QObject
         MouseRB
     };
 
+    /**
+     * @brief Key event converted by event handler to its native key code.
+     *     flush marks the last event of a group written together.
+     */
+    struct ResolvedKeyEvent
+    {
+        int code;
+        bool pressed;
+        bool flush;
+    };
+
     explicit JoyButtonSlot(QObject *parent = nullptr);
     explicit JoyButtonSlot(int code, JoySlotInputAction mode, QObject *parent = nullptr);
     explicit JoyButtonSlot(int code, int alias, JoySlotInputAction mode, QObject *parent = nullptr);
@@ -95,7 +109,7 @@ class JoyButtonSlot : public QObject
     void setMouseSpeed(int value);
     void setDistance(double distance);
     double getMouseDistance();
-    QElapsedTimer *getMouseInterval();
+    EngineElapsedTimer *getMouseInterval();
     void restartMouseInterval();
     QString getXmlName();
     QString getSlotString();
@@ -108,7 +122,7 @@ class JoyButtonSlot : public QObject
 
     bool isEasingActive() const;
     void setEasingStatus(bool isActive);
-    QElapsedTimer *getEasingTime();
+    EngineElapsedTimer *getEasingTime();
 
     void setTextData(QString textData);
     QString getTextData() const;
@@ -129,6 +143,12 @@ class JoyButtonSlot : public QObject
 
     bool isValidSlot();
 
+    void setResolvedCode(int code, int generation);
+    int getResolvedCode() const;
+    void setResolvedSequence(const QVector<ResolvedKeyEvent> &sequence, int generation);
+    const QVector<ResolvedKeyEvent> &getResolvedSequence() const;
+    bool isResolved(int generation) const;
+
     void cleanMixSlots();
 
     JoyButtonSlot &operator=(JoyButtonSlot *slot);
@@ -143,11 +163,14 @@ class JoyButtonSlot : public QObject
     QList<JoyButtonSlot *> *mix_slots;
     double m_distance;
     double previousDistance;
-    QElapsedTimer mouseInterval;
-    QElapsedTimer easingTime;
+    EngineElapsedTimer mouseInterval;
+    EngineElapsedTimer easingTime;
     bool easingActive;
     QString m_textData;
     QVariant extraData;
+    int resolvedCode;
+    int resolvedGeneration;
+    QVector<ResolvedKeyEvent> resolvedSequence;
 };
 
 Q_DECLARE_METATYPE(JoyButtonSlot *)
@@ -0,0 +1,131 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "joybuttonslotprogram.h"
+
+#include "joybuttonslot.h"
+
+#include <algorithm>
+
+JoyButtonSlotProgram::JoyButtonSlotProgram()
+    : distanceSlots(false)
+    , releaseSlots(false)
+    , mixSlots(false)
+    , sequence(false)
+{
+    segments.resize(1);
+}
+
+/**
+ * @brief Rebuild layout from slot list. Has to be called with the list
+ *     locked for writing, whenever slots are added, replaced or removed.
+ */
+void JoyButtonSlotProgram::compile(const QList<JoyButtonSlot *> &slots)
+{
+    segments.clear();
+    segments.resize(1);
+    cycleSegments.clear();
+    distanceSlots = releaseSlots = mixSlots = sequence = false;
+
+    double distance = 0.0;
+    double release = 0.0;
+
+    for (JoyButtonSlot *slot : slots)
+    {
+        switch (slot->getSlotMode())
+        {
+        case JoyButtonSlot::JoyDistance:
+            distance += slot->getSlotCode() / 100.0;
+            segments.last().distances.append({distance, slot});
+            distanceSlots = sequence = true;
+            break;
+        case JoyButtonSlot::JoyRelease:
+            release += slot->getSlotCode();
+            segments.last().releases.append({release, slot});
+            releaseSlots = true;
+            break;
+        case JoyButtonSlot::JoyCycle:
+            distance = release = 0.0;
+            segments.append(Segment());
+            cycleSegments.insert(slot, segments.size() - 1);
+            break;
+        case JoyButtonSlot::JoyPause:
+        case JoyButtonSlot::JoyHold:
+            sequence = true;
+            break;
+        case JoyButtonSlot::JoyMix:
+            mixSlots = true;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+bool JoyButtonSlotProgram::hasDistanceSlots() const { return distanceSlots; }
+
+bool JoyButtonSlotProgram::hasReleaseSlots() const { return releaseSlots; }
+
+bool JoyButtonSlotProgram::hasMixSlots() const { return mixSlots; }
+
+/**
+ * @brief Slot list contains pause, hold or distance slots
+ */
+bool JoyButtonSlotProgram::hasSequence() const { return sequence; }
+
+/**
+ * @brief Last distance slot of the segment after cycle whose range starts
+ *     at or below distance.
+ * @return nullptr when distance is below the first distance slot
+ */
+JoyButtonSlot *JoyButtonSlotProgram::distanceSlotFor(JoyButtonSlot *cycle, double distance) const
+{
+    const Segment *segment = segmentFor(cycle);
+    return (segment != nullptr) ? lastReached(segment->distances, distance) : nullptr;
+}
+
+/**
+ * @brief Last release slot of the segment after cycle whose time has
+ *     elapsed.
+ */
+JoyButtonSlot *JoyButtonSlotProgram::releaseSlotFor(JoyButtonSlot *cycle, int elapsed) const
+{
+    const Segment *segment = segmentFor(cycle);
+    return (segment != nullptr) ? lastReached(segment->releases, elapsed) : nullptr;
+}
+
+/**
+ * @brief Segment starting after cycle slot or the first one when cycle
+ *     is nullptr. Slot that is not part of the list has no segment.
+ */
+const JoyButtonSlotProgram::Segment *JoyButtonSlotProgram::segmentFor(JoyButtonSlot *cycle) const
+{
+    if (cycle == nullptr)
+        return &segments.first();
+
+    auto iter = cycleSegments.constFind(cycle);
+    return (iter != cycleSegments.constEnd()) ? &segments.at(iter.value()) : nullptr;
+}
+
+JoyButtonSlot *JoyButtonSlotProgram::lastReached(const QVector<Threshold> &thresholds, double value)
+{
+    // Thresholds are cumulative sums of non negative codes
+    auto iter = std::upper_bound(thresholds.constBegin(), thresholds.constEnd(), value,
+                                 [](double current, const Threshold &threshold) { return current < threshold.value; });
+
+    return (iter != thresholds.constBegin()) ? (iter - 1)->slot : nullptr;
+}
@@ -0,0 +1,73 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOYBUTTONSLOTPROGRAM_H
+#define JOYBUTTONSLOTPROGRAM_H
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+class JoyButtonSlot;
+
+/**
+ * @brief Layout of the slot list of a button computed once when the
+ *     assignments change. Splits the list into cycle segments and keeps
+ *     cumulative distance and release thresholds of every segment, so
+ *     lookups done while a button is used do not walk the slot list.
+ */
+class JoyButtonSlotProgram
+{
+  public:
+    JoyButtonSlotProgram();
+
+    void compile(const QList<JoyButtonSlot *> &slots);
+
+    bool hasDistanceSlots() const;
+    bool hasReleaseSlots() const;
+    bool hasMixSlots() const;
+    bool hasSequence() const;
+
+    JoyButtonSlot *distanceSlotFor(JoyButtonSlot *cycle, double distance) const;
+    JoyButtonSlot *releaseSlotFor(JoyButtonSlot *cycle, int elapsed) const;
+
+  private:
+    struct Threshold
+    {
+        double value;
+        JoyButtonSlot *slot;
+    };
+
+    // Slots following a JoyCycle slot (or the start of the list)
+    struct Segment
+    {
+        QVector<Threshold> distances;
+        QVector<Threshold> releases;
+    };
+
+    const Segment *segmentFor(JoyButtonSlot *cycle) const;
+    static JoyButtonSlot *lastReached(const QVector<Threshold> &thresholds, double value);
+
+    QVector<Segment> segments;
+    QHash<JoyButtonSlot *, int> cycleSegments;
+    bool distanceSlots;
+    bool releaseSlots;
+    bool mixSlots;
+    bool sequence;
+};
+
+#endif // JOYBUTTONSLOTPROGRAM_H
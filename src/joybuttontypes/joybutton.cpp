@@ -26,6 +26,7 @@
 
 #include "SDL2/SDL_events.h"
 #include "eventhandlerfactory.h"
+#include "eventhandlers/outputsink.h"
 
 #include <QDebug>
 //#include <QThread>
@@ -34,7 +35,6 @@
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 #include <QtConcurrent>
-#include <chrono>
 
 const JoyButton::JoyMouseCurve JoyButton::DEFAULTMOUSECURVE = JoyButton::EnhancedPrecisionCurve;
 const JoyButton::SetChangeCondition JoyButton::DEFAULTSETCONDITION = JoyButton::SetChangeDisabled;
@@ -56,20 +56,16 @@ QList<PadderCommon::springModeInfo> JoyButton::springXSpeeds;
 QList<PadderCommon::springModeInfo> JoyButton::springYSpeeds;
 
 // Temporary test object to test old mouse time behavior.
-QElapsedTimer JoyButton::testOldMouseTime;
+EngineElapsedTimer JoyButton::testOldMouseTime;
 
-// time when minislots next to each other in thread pool are waiting to execute function
-// at the same time
-int JoyButton::timeBetweenMiniSlots = 55;
-
-int JoyButton::allSlotTimeBetweenSlots = 0;
 
 // Helper object to have a single mouse event for all JoyButton
 // instances.
 JoyButtonMouseHelper JoyButton::mouseHelper;
 
-QTimer JoyButton::staticMouseEventTimer;
+EngineTimer JoyButton::staticMouseEventTimer;
 QList<JoyButton *> JoyButton::pendingMouseButtons;
+QList<JoyButton *> JoyButton::pendingWheelButtons;
 
 // IT CAN BE HERE
 // LOOK FOR JoyCycle and put JoyMix next to the slots types
@@ -79,8 +75,6 @@ JoyButton::JoyButton(int sdl_button_index, int originset, SetJoystick *parentSet
     m_vdpad = nullptr;
     slotiter = nullptr;
 
-    threadPool = QThreadPool::globalInstance();
-
     turboTimer.setParent(this);
     pauseTimer.setParent(this);
     holdTimer.setParent(this);
@@ -97,17 +91,17 @@ JoyButton::JoyButton(int sdl_button_index, int originset, SetJoystick *parentSet
     slotSetChangeTimer.setSingleShot(true);
     m_parentSet = parentSet;
 
-    connect(&pauseWaitTimer, &QTimer::timeout, this, &JoyButton::pauseWaitEvent);
-    connect(&keyPressTimer, &QTimer::timeout, this, &JoyButton::keyPressEvent);
-    connect(&holdTimer, &QTimer::timeout, this, &JoyButton::holdEvent);
-    connect(&delayTimer, &QTimer::timeout, this, &JoyButton::delayEvent);
-    connect(&createDeskTimer, &QTimer::timeout, this, &JoyButton::waitForDeskEvent);
-    connect(&releaseDeskTimer, &QTimer::timeout, this, &JoyButton::waitForReleaseDeskEvent);
-    connect(&turboTimer, &QTimer::timeout, this, &JoyButton::turboEvent);
-    connect(&mouseWheelVerticalEventTimer, &QTimer::timeout, this, &JoyButton::wheelEventVertical);
-    connect(&mouseWheelHorizontalEventTimer, &QTimer::timeout, this, &JoyButton::wheelEventHorizontal);
-    connect(&setChangeTimer, &QTimer::timeout, this, &JoyButton::checkForSetChange);
-    connect(&slotSetChangeTimer, &QTimer::timeout, this, &JoyButton::slotSetChange);
+    connect(&pauseWaitTimer, &EngineTimer::timeout, this, &JoyButton::pauseWaitEvent);
+    connect(&keyPressTimer, &EngineTimer::timeout, this, &JoyButton::keyPressEvent);
+    connect(&holdTimer, &EngineTimer::timeout, this, &JoyButton::holdEvent);
+    connect(&delayTimer, &EngineTimer::timeout, this, &JoyButton::delayEvent);
+    connect(&createDeskTimer, &EngineTimer::timeout, this, &JoyButton::waitForDeskEvent);
+    connect(&releaseDeskTimer, &EngineTimer::timeout, this, &JoyButton::waitForReleaseDeskEvent);
+    connect(&turboTimer, &EngineTimer::timeout, this, &JoyButton::turboEvent);
+    connect(&mouseWheelVerticalEventTimer, &EngineTimer::timeout, this, &JoyButton::wheelEventVertical);
+    connect(&mouseWheelHorizontalEventTimer, &EngineTimer::timeout, this, &JoyButton::wheelEventHorizontal);
+    connect(&setChangeTimer, &EngineTimer::timeout, this, &JoyButton::checkForSetChange);
+    connect(&slotSetChangeTimer, &EngineTimer::timeout, this, &JoyButton::slotSetChange);
 
     // Will only matter on the first call
     establishMouseTimerConnections();
@@ -122,20 +116,29 @@ JoyButton::JoyButton(int sdl_button_index, int originset, SetJoystick *parentSet
 }
 
 JoyButton::~JoyButton()
-{ // threadPool->clear();
-
+{
     reset();
     // resetPrivVars();
 }
 
 void JoyButton::queuePendingEvent(bool pressed, bool ignoresets)
 {
+    bool wasPending = pendingEvent;
     updatePendingParams(false, false, false);
+    counters.addReceived();
 
     if (m_vdpad != nullptr)
+    {
         vdpadPassEvent(pressed, ignoresets);
-    else
+    } else
+    {
         updatePendingParams(true, pressed, ignoresets);
+
+        if (wasPending)
+            counters.addCoalesced();
+        else if (getParentSet() != nullptr)
+            getParentSet()->queueDirtyButton(this);
+    }
 }
 
 void JoyButton::activatePendingEvent()
@@ -149,6 +152,8 @@ void JoyButton::activatePendingEvent()
 
 bool JoyButton::hasPendingEvent() { return pendingEvent; }
 
+ElementCounters &JoyButton::getCounters() { return counters; }
+
 void JoyButton::clearPendingEvent() { updatePendingParams(false, false, false); }
 
 void JoyButton::vdpadPassEvent(bool pressed, bool ignoresets)
@@ -175,6 +180,8 @@ void JoyButton::vdpadPassEvent(bool pressed, bool ignoresets)
  */
 void JoyButton::joyEvent(bool pressed, bool ignoresets)
 {
+    ElementCounters::Scope scope(counters);
+
     if (Logger::isDebugEnabled())
         DEBUG() << "Processing JoyButton::joyEvent for: " << getName() << " SDL index: " << m_index_sdl
                 << " className: " << metaObject()->className();
@@ -298,12 +305,21 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
 
             if (!setChangeTimer.isActive())
                 updateParamsAfterDistEvent();
+        } else if (m_useTurbo && isButtonPressed && turboTimer.isActive())
+        {
+            turboDistanceEvent();
         }
     }
 
     updateInitAccelValues = true;
 }
 
+/**
+ * @brief Distance of an active turbo button changed. Nothing to do for
+ *     plain turbo which does not depend on distance.
+ */
+void JoyButton::turboDistanceEvent() {}
+
 void JoyButton::updateParamsAfterDistEvent()
 {
     if (distanceEvent())
@@ -410,7 +426,12 @@ bool JoyButton::getToggleState() { return m_toggle; }
 
 int JoyButton::getTurboInterval() { return turboInterval; }
 
-void JoyButton::turboEvent() { changeTurboParams(isKeyPressed, isButtonPressed); }
+void JoyButton::turboEvent()
+{
+    ElementCounters::Scope scope(counters);
+
+    changeTurboParams(isKeyPressed, isButtonPressed);
+}
 
 void JoyButton::changeTurboParams(bool _isKeyPressed, bool isButtonPressed)
 {
@@ -454,37 +475,7 @@ bool JoyButton::distanceEvent()
 
         if (containsDistanceSlots())
         {
-            double currentDistance = getDistanceFromDeadZone();
-            double tempDistance = 0.0;
-            JoyButtonSlot *previousDistanceSlot = nullptr;
-            QListIterator<JoyButtonSlot *> iter(*getAssignedSlots());
-
-            if (previousCycle != nullptr)
-            {
-                qDebug() << "find previous Cycle in next steps in assignments and skip to it";
-
-                iter.findNext(previousCycle);
-            }
-
-            while (iter.hasNext())
-            {
-                JoyButtonSlot *slot = iter.next();
-                int tempcode = slot->getSlotCode();
-
-                if (slot->getSlotMode() == JoyButtonSlot::JoyDistance)
-                {
-                    tempDistance += (tempcode / 100.0);
-
-                    if (currentDistance < tempDistance)
-                        iter.toBack();
-                    else
-                        previousDistanceSlot = slot;
-                } else if (slot->getSlotMode() == JoyButtonSlot::JoyCycle)
-                {
-                    tempDistance = 0.0;
-                    iter.toBack();
-                }
-            }
+            JoyButtonSlot *previousDistanceSlot = slotProgram.distanceSlotFor(previousCycle, getDistanceFromDeadZone());
 
             // No applicable distance slot
             if (!previousDistanceSlot)
@@ -550,6 +541,8 @@ bool JoyButton::distanceEvent()
 
 void JoyButton::createDeskEvent()
 {
+    ElementCounters::Scope scope(counters);
+
     quitEvent = false;
 
     if (slotiter == nullptr)
@@ -580,10 +573,7 @@ void JoyButton::createDeskEvent()
 
 void JoyButton::activateSlots()
 {
-    bool countForAllTime = false;
-
-    if (allSlotTimeBetweenSlots == 0)
-        countForAllTime = true;
+    ElementCounters::Scope scope(counters);
 
     if (slotiter != nullptr)
     {
@@ -602,48 +592,18 @@ void JoyButton::activateSlots()
             {
                 qDebug() << "JOYMIX IN ACTIVATESLOTS";
 
-                if (slot->getMixSlots() != nullptr)
+                if ((slot->getMixSlots() != nullptr) && !slot->getMixSlots()->isEmpty())
                 {
-                    QListIterator<JoyButtonSlot *> mini_it(*slot->getMixSlots());
-                    QListIterator<JoyButtonSlot *> *it(&mini_it);
-
-                    int countMinis = slot->getMixSlots()->count();
-                    int timeX = countMinis;
-
-                    std::chrono::time_point<std::chrono::high_resolution_clock> t1, t2;
-                    t1 = std::chrono::high_resolution_clock::now();
+                    i++;
 
-                    while (it->hasNext())
+                    // Mini slots are pressed together, in list order
+                    for (JoyButtonSlot *slotmini : *slot->getMixSlots())
                     {
-                        JoyButtonSlot *slotmini = it->next();
                         qDebug() << "Run activated mini slot - name - deviceCode - mode: " << slotmini->getSlotString()
                                  << " - " << slotmini->getSlotCode() << " - " << slotmini->getSlotMode();
 
-                        MiniSlotRun *minijob = new MiniSlotRun(slot, slotmini, this, timeBetweenMiniSlots * timeX);
-
-                        minijob->setAutoDelete(false);
-
-                        threadPool->start(minijob);
-
-                        timeX--;
-
-                        if (timeBetweenMiniSlots == 55)
-                        {
-                            t2 = std::chrono::high_resolution_clock::now();
-                            timeBetweenMiniSlots = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
-                        }
-                    }
-
-                    if (countForAllTime)
-                    {
-                        allSlotTimeBetweenSlots += countMinis * timeBetweenMiniSlots;
+                        activateMiniSlots(slotmini, slot);
                     }
-
-                    threadPool->waitForDone();
-
-                    i++;
-                    if (!slotiter->hasNext())
-                        break;
                 }
             } else
             {
@@ -677,6 +637,7 @@ void JoyButton::activateMiniSlots(JoyButtonSlot *slot, JoyButtonSlot *mix)
         {
             qDebug() << "There has been assigned a lastActiveKey " << slot->getSlotString();
 
+            startKeyRepeat(slot);
             lastActiveKey = mix;
         } else
         {
@@ -710,6 +671,7 @@ void JoyButton::addEachSlotToActives(JoyButtonSlot *slot, int &i, bool &delaySeq
         {
             qDebug() << "There has been assigned a lastActiveKey " << slot->getSlotString();
 
+            startKeyRepeat(slot);
             lastActiveKey = slot;
         } else
         {
@@ -730,19 +692,33 @@ void JoyButton::addEachSlotToActives(JoyButtonSlot *slot, int &i, bool &delaySeq
         {
             slot->getMouseInterval()->restart();
             wheelVerticalTime.restart();
-            currentWheelVerticalEvent = slot;
             getActiveSlotsLocal().append(slot);
-            wheelEventVertical();
-            currentWheelVerticalEvent = nullptr;
+
+            if (GlobalVariables::JoyButton::hiResScroll)
+            {
+                startHiResWheelEvent();
+            } else
+            {
+                currentWheelVerticalEvent = slot;
+                wheelEventVertical();
+                currentWheelVerticalEvent = nullptr;
+            }
         } else if ((tempcode == static_cast<int>(JoyButtonSlot::MouseWheelLeft)) ||
                    (tempcode == static_cast<int>(JoyButtonSlot::MouseWheelRight)))
         {
             slot->getMouseInterval()->restart();
             wheelHorizontalTime.restart();
-            currentWheelHorizontalEvent = slot;
             getActiveSlotsLocal().append(slot);
-            wheelEventHorizontal();
-            currentWheelHorizontalEvent = nullptr;
+
+            if (GlobalVariables::JoyButton::hiResScroll)
+            {
+                startHiResWheelEvent();
+            } else
+            {
+                currentWheelHorizontalEvent = slot;
+                wheelEventHorizontal();
+                currentWheelHorizontalEvent = nullptr;
+            }
         } else
         {
             sendevent(slot, true);
@@ -964,6 +940,16 @@ void JoyButton::addEachSlotToActives(JoyButtonSlot *slot, int &i, bool &delaySeq
 
         break;
     }
+    case JoyButtonSlot::JoyGamepadButton: {
+        i++;
+
+        qDebug() << i << ": It's a JoyGamepadButton with code: " << tempcode << " and name: " << slot->getSlotString();
+
+        sendevent(slot, true);
+        getActiveSlotsLocal().append(slot);
+
+        break;
+    }
     default:
         break;
     }
@@ -1021,7 +1007,7 @@ void JoyButton::mouseEvent()
 
         while (buttonslot != nullptr)
         {
-            QElapsedTimer *mouseInterval = buttonslot->getMouseInterval();
+            EngineElapsedTimer *mouseInterval = buttonslot->getMouseInterval();
 
             int mousedirection = buttonslot->getSlotCode();
             JoyButton::JoyMouseMovementMode mousemode = getMouseMode();
@@ -1556,6 +1542,104 @@ void JoyButton::wheelEventHorizontal()
     }
 }
 
+/**
+ * @brief Register button for high resolution scrolling. Wheel movement
+ *     is generated by the shared mouse timer in moveMouseWheel.
+ */
+void JoyButton::startHiResWheelEvent()
+{
+    if (!pendingWheelButtons.contains(this))
+        pendingWheelButtons.append(this);
+
+    if (!staticMouseEventTimer.isActive() ||
+        (staticMouseEventTimer.interval() == GlobalVariables::JoyButton::IDLEMOUSEREFRESHRATE))
+    {
+        staticMouseEventTimer.start(GlobalVariables::JoyButton::mouseRefreshRate);
+        testOldMouseTime.restart();
+    }
+}
+
+/**
+ * @brief Add wheel movement of all active wheel slots for the elapsed time.
+ *     Full deflection moves by wheel speed clicks per second.
+ * @param Elapsed time in ms since last mouse event
+ * @param[in,out] Combined vertical movement in high resolution units
+ * @param[in,out] Combined horizontal movement in high resolution units
+ */
+void JoyButton::hiResWheelEvent(int elapsed, double &finalVertical, double &finalHorizontal)
+{
+    double distance = qBound(0.0, getMouseDistanceFromDeadZone(), 1.0);
+    double units = distance * elapsed * GlobalVariables::JoyButton::HIRESWHEELUNITS / 1000.0;
+
+    for (JoyButtonSlot *slot : getActiveSlots())
+    {
+        if (slot->getSlotMode() != JoyButtonSlot::JoyMouseButton)
+            continue;
+
+        switch (slot->getSlotCode())
+        {
+        case JoyButtonSlot::MouseWheelUp:
+            finalVertical += wheelSpeedY * units;
+            break;
+        case JoyButtonSlot::MouseWheelDown:
+            finalVertical -= wheelSpeedY * units;
+            break;
+        case JoyButtonSlot::MouseWheelLeft:
+            finalHorizontal -= wheelSpeedX * units;
+            break;
+        case JoyButtonSlot::MouseWheelRight:
+            finalHorizontal += wheelSpeedX * units;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Take wheel movement of all buttons using high resolution scrolling
+ *     and send one combined wheel event. Fractional movement is kept
+ *     for the next mouse event.
+ */
+void JoyButton::moveMouseWheel(int elapsed, QList<JoyButton *> *pendingWheelButtons, double &wheelRemainderX,
+                               double &wheelRemainderY)
+{
+    if (pendingWheelButtons->isEmpty())
+    {
+        wheelRemainderX = 0.0;
+        wheelRemainderY = 0.0;
+        return;
+    }
+
+    double finalVertical = wheelRemainderY;
+    double finalHorizontal = wheelRemainderX;
+    bool perDeviceOutput = OutputSink::isPerDeviceOutput();
+    QVector<OutputShare> shares;
+
+    for (JoyButton *button : *pendingWheelButtons)
+    {
+        double previousVertical = finalVertical;
+        double previousHorizontal = finalHorizontal;
+        button->hiResWheelEvent(elapsed, finalVertical, finalHorizontal);
+
+        if (perDeviceOutput)
+            addOutputShare(shares, button, finalVertical - previousVertical, finalHorizontal - previousHorizontal);
+    }
+
+    int vertical = static_cast<int>(finalVertical);
+    int horizontal = static_cast<int>(finalHorizontal);
+    wheelRemainderY = finalVertical - vertical;
+    wheelRemainderX = finalHorizontal - horizontal;
+
+    if ((vertical != 0) || (horizontal != 0))
+    {
+        if (perDeviceOutput)
+            sendOutputShares(shares, vertical, horizontal, sendWheelEvent);
+        else
+            sendWheelEvent(vertical, horizontal);
+    }
+}
+
 void JoyButton::setUseTurbo(bool useTurbo)
 {
     bool initialState = m_useTurbo;
@@ -1803,7 +1887,8 @@ void JoyButton::buildActiveZoneSummarySwitchSlots(JoyButtonSlot::JoySlotInputAct
     {
     case JoyButtonSlot::JoyKeyboard:
     case JoyButtonSlot::JoyMouseButton:
-    case JoyButtonSlot::JoyMouseMovement: {
+    case JoyButtonSlot::JoyMouseMovement:
+    case JoyButtonSlot::JoyGamepadButton: {
         QString temp = slot->getSlotString();
 
         if (behindHold)
@@ -1962,7 +2047,8 @@ QList<JoyButtonSlot *> JoyButton::getActiveZoneList()
             case JoyButtonSlot::JoySetChange:
             case JoyButtonSlot::JoyTextEntry:
             case JoyButtonSlot::JoyExecute:
-            case JoyButtonSlot::JoyMix: {
+            case JoyButtonSlot::JoyMix:
+            case JoyButtonSlot::JoyGamepadButton: {
                 tempSlotList.append(slot);
                 break;
             }
@@ -2050,6 +2136,7 @@ bool JoyButton::setAssignedSlot(int code, JoyButtonSlot::JoySlotInputAction mode
     {
         assignmentsLock.lockForWrite();
         getAssignmentsLocal().append(slot);
+        slotProgram.compile(assignments);
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -2058,6 +2145,7 @@ bool JoyButton::setAssignedSlot(int code, JoyButtonSlot::JoySlotInputAction mode
     {
         assignmentsLock.lockForWrite();
         getAssignmentsLocal().append(slot);
+        slotProgram.compile(assignments);
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -2095,6 +2183,7 @@ bool JoyButton::setAssignedSlot(int code, int alias, JoyButtonSlot::JoySlotInput
     {
         assignmentsLock.lockForWrite();
         getAssignmentsLocal().append(slot);
+        slotProgram.compile(assignments);
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -2103,6 +2192,7 @@ bool JoyButton::setAssignedSlot(int code, int alias, JoyButtonSlot::JoySlotInput
     {
         assignmentsLock.lockForWrite();
         getAssignmentsLocal().append(slot);
+        slotProgram.compile(assignments);
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -2167,6 +2257,7 @@ bool JoyButton::setAssignedSlot(int code, int alias, int index, JoyButtonSlot::J
         }
 
         checkTurboCondition(slot);
+        slotProgram.compile(assignments);
         assignmentsLock.unlock();
         buildActiveZoneSummaryString();
         emit slotsChanged();
@@ -2219,6 +2310,7 @@ bool JoyButton::insertAssignedSlot(int code, int alias, int index, JoyButtonSlot
         qDebug() << "assignments variable in joybutton has now: " << getAssignedSlots()->count() << " input slots";
 
         checkTurboCondition(slot);
+        slotProgram.compile(assignments);
         assignmentsLock.unlock();
         buildActiveZoneSummaryString();
         emit slotsChanged();
@@ -2255,6 +2347,7 @@ bool JoyButton::insertAssignedSlot(JoyButtonSlot *newSlot, bool updateActiveStri
         assignmentsLock.lockForWrite();
         checkTurboCondition(newSlot);
         getAssignmentsLocal().append(newSlot);
+        slotProgram.compile(assignments);
         assignmentsLock.unlock();
 
         if (updateActiveString)
@@ -2297,6 +2390,7 @@ bool JoyButton::insertAssignedSlot(JoyButtonSlot *newSlot, int index, bool updat
         qDebug() << "assignments variable in joybutton has now: " << getAssignedSlots()->count() << " input slots";
 
         checkTurboCondition(slot);
+        slotProgram.compile(assignments);
         assignmentsLock.unlock();
         buildActiveZoneSummaryString();
         emit slotsChanged();
@@ -2375,6 +2469,7 @@ bool JoyButton::setAssignedSlot(JoyButtonSlot *otherSlot, int index)
             getAssignmentsLocal().append(newslot);
         }
 
+        slotProgram.compile(assignments);
         assignmentsLock.unlock();
         buildActiveZoneSummaryString();
         emit slotsChanged();
@@ -2474,6 +2569,8 @@ int JoyButton::getOriginSet() { return m_originset; }
 
 void JoyButton::pauseWaitEvent()
 {
+    ElementCounters::Scope scope(counters);
+
     if (currentPause != nullptr)
     {
         if (!isButtonPressedQueue.isEmpty() && createDeskTimer.isActive())
@@ -2597,6 +2694,8 @@ void JoyButton::restartAllForSetChange()
 
 void JoyButton::waitForDeskEvent()
 {
+    ElementCounters::Scope scope(counters);
+
     if (quitEvent && !isButtonPressedQueue.isEmpty() && isButtonPressedQueue.last())
     {
         if (createDeskTimer.isActive())
@@ -2630,6 +2729,8 @@ void JoyButton::waitForDeskEvent()
 
 void JoyButton::waitForReleaseDeskEvent()
 {
+    ElementCounters::Scope scope(counters);
+
     if (quitEvent && !keyPressTimer.isActive())
     {
         if (releaseDeskTimer.isActive())
@@ -2655,30 +2756,15 @@ void JoyButton::waitForReleaseDeskEvent()
 
 bool JoyButton::containsSequence()
 {
-    bool result = false;
-
-    assignmentsLock.lockForRead();
-    QListIterator<JoyButtonSlot *> tempiter(*getAssignedSlots());
-
-    while (tempiter.hasNext())
-    {
-        JoyButtonSlot *slot = tempiter.next();
-        JoyButtonSlot::JoySlotInputAction mode = slot->getSlotMode();
-
-        if ((mode == JoyButtonSlot::JoyPause) || (mode == JoyButtonSlot::JoyHold) || (mode == JoyButtonSlot::JoyDistance))
-        {
-            result = true;
-            tempiter.toBack();
-        }
-    }
-
-    assignmentsLock.unlock();
+    QReadLocker tempLocker(&assignmentsLock);
 
-    return result;
+    return slotProgram.hasSequence();
 }
 
 void JoyButton::holdEvent()
 {
+    ElementCounters::Scope scope(counters);
+
     if (currentHold != nullptr)
     {
         bool currentlyPressed = false;
@@ -2728,11 +2814,14 @@ void JoyButton::holdEvent()
     }
 }
 
-void JoyButton::startTimerOverrun(int slotCode, QElapsedTimer *currSlotTime, QTimer *currSlotTimer, bool releasedDeskTimer)
+void JoyButton::startTimerOverrun(int slotCode, EngineElapsedTimer *currSlotTime, EngineTimer *currSlotTimer,
+                                  bool releasedDeskTimer)
 {
     int proposedInterval = slotCode - currSlotTime->elapsed();
     proposedInterval = (proposedInterval > 0) ? proposedInterval : 0;
-    int newTimerInterval = qMin(10, proposedInterval);
+    // Slot time is over only after elapsed time exceeds it. Wait at least
+    // 1 ms, a 0 ms timer would fire again at the same virtual clock time.
+    int newTimerInterval = qBound(1, proposedInterval, 10);
     currSlotTimer->start(newTimerInterval);
 
     if (releasedDeskTimer)
@@ -2747,6 +2836,8 @@ void JoyButton::startTimerOverrun(int slotCode, QElapsedTimer *currSlotTime, QTi
 
 void JoyButton::delayEvent()
 {
+    ElementCounters::Scope scope(counters);
+
     if (currentDelay != nullptr)
     {
         bool currentlyPressed = false;
@@ -2779,6 +2870,8 @@ void JoyButton::delayEvent()
 
 void JoyButton::releaseDeskEvent(bool skipsetchange)
 {
+    ElementCounters::Scope scope(counters);
+
     quitEvent = false;
 
     pauseWaitTimer.stop();
@@ -2977,21 +3070,7 @@ double JoyButton::getTotalSlotDistance(JoyButtonSlot *slot)
 
 bool JoyButton::containsDistanceSlots()
 {
-    bool result = false;
-    QListIterator<JoyButtonSlot *> iter(*getAssignedSlots());
-
-    while (iter.hasNext())
-    {
-        JoyButtonSlot *slot = iter.next();
-
-        if (slot->getSlotMode() == JoyButtonSlot::JoyDistance)
-        {
-            result = true;
-            iter.toBack();
-        }
-    }
-
-    return result;
+    return slotProgram.hasDistanceSlots();
 }
 
 void JoyButton::clearAssignedSlots(bool signalEmit)
@@ -3018,6 +3097,8 @@ void JoyButton::clearAssignedSlots(bool signalEmit)
     }
 
     getAssignmentsLocal().clear();
+    slotProgram.compile(assignments);
+
     if (signalEmit)
         emit slotsChanged();
 }
@@ -3060,6 +3141,7 @@ void JoyButton::removeAssignedSlot(int index)
             slot = nullptr;
         }
 
+        slotProgram.compile(assignments);
         tempAssignLocker.unlock();
         buildActiveZoneSummaryString();
         emit slotsChanged();
@@ -3146,6 +3228,7 @@ void JoyButton::releaseActiveSlots()
             mouseEventQueue.clear();
 
         pendingMouseButtons.removeAll(this);
+        pendingWheelButtons.removeAll(this);
         currentWheelVerticalEvent = nullptr;
         currentWheelHorizontalEvent = nullptr;
         mouseWheelVerticalEventTimer.stop();
@@ -3176,6 +3259,18 @@ void JoyButton::releaseActiveSlots()
     }
 }
 
+/**
+ * @brief Emulate key repeat of pressed keyboard slot when enabled in
+ *     profile of the device and the host does not repeat keys itself.
+ */
+void JoyButton::startKeyRepeat(JoyButtonSlot *slot)
+{
+    InputDevice *device = m_parentSet->getInputDevice();
+
+    if (device->isKeyRepeatEnabled() && OutputSink::emulatesKeyRepeat())
+        device->getKeyRepeatHelper()->keyPressed(this, slot, device->getKeyRepeatDelay(), device->getKeyRepeatRate());
+}
+
 void JoyButton::releaseEachSlot(bool &changeRepeatState, int &references, int tempcode,
                                 JoyButtonSlot::JoySlotInputAction mode, JoyButtonSlot *slot)
 {
@@ -3259,6 +3354,9 @@ void JoyButton::releaseEachSlot(bool &changeRepeatState, int &references, int te
     {
         currentSetChangeSlot = slot;
         slotSetChangeTimer.start();
+    } else if (mode == JoyButtonSlot::JoyGamepadButton)
+    {
+        sendevent(slot, false);
     }
 }
 
@@ -3330,36 +3428,12 @@ void JoyButton::releaseMoveSlots(QList<JoyButton::mouseCursorInfo> &cursorSpeeds
 
 bool JoyButton::containsReleaseSlots()
 {
-    bool result = false;
-    QListIterator<JoyButtonSlot *> iter(*getAssignedSlots());
-
-    while (iter.hasNext())
-    {
-        if (iter.next()->getSlotMode() == JoyButtonSlot::JoyRelease)
-        {
-            result = true;
-            iter.toBack();
-        }
-    }
-
-    return result;
+    return slotProgram.hasReleaseSlots();
 }
 
 bool JoyButton::containsJoyMixSlot()
 {
-    bool result = false;
-    QListIterator<JoyButtonSlot *> iter(*getAssignedSlots());
-
-    while (iter.hasNext())
-    {
-        if (iter.next()->getSlotMode() == JoyButtonSlot::JoyMix)
-        {
-            result = true;
-            iter.toBack();
-        }
-    }
-
-    return result;
+    return slotProgram.hasMixSlots();
 }
 
 void JoyButton::releaseSlotEvent()
@@ -3370,33 +3444,7 @@ void JoyButton::releaseSlotEvent()
 
     if (containsReleaseSlots())
     {
-        QListIterator<JoyButtonSlot *> iter(*getAssignedSlots());
-
-        if (previousCycle != nullptr)
-            iter.findNext(previousCycle);
-
-        int tempElapsed = 0;
-
-        while (iter.hasNext())
-        {
-            JoyButtonSlot *currentSlot = iter.next();
-            int tempcode = currentSlot->getSlotCode();
-            JoyButtonSlot::JoySlotInputAction mode = currentSlot->getSlotMode();
-
-            if (mode == JoyButtonSlot::JoyRelease)
-            {
-                tempElapsed += tempcode;
-
-                if (tempElapsed <= timeElapsed)
-                    temp = currentSlot;
-                else
-                    iter.toBack();
-            } else if (mode == JoyButtonSlot::JoyCycle)
-            {
-                tempElapsed = 0;
-                iter.toBack();
-            }
-        }
+        temp = slotProgram.releaseSlotFor(previousCycle, timeElapsed);
 
         if ((temp != nullptr) && (slotiter != nullptr))
         {
@@ -3622,8 +3670,9 @@ QString JoyButton::getDefaultButtonName() { return defaultButtonName; }
  *     send a cursor mode mouse event to the display server.
  */
 void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QList<double> *mouseHistoryX,
-                                QList<double> *mouseHistoryY, QElapsedTimer *testOldMouseTime, QTimer *staticMouseEventTimer,
-                                int mouseRefreshRate, int mouseHistorySize, QList<JoyButton::mouseCursorInfo> *cursorXSpeeds,
+                                QList<double> *mouseHistoryY, EngineElapsedTimer *testOldMouseTime,
+                                EngineTimer *staticMouseEventTimer, int mouseRefreshRate, int mouseHistorySize,
+                                QList<JoyButton::mouseCursorInfo> *cursorXSpeeds,
                                 QList<JoyButton::mouseCursorInfo> *cursorYSpeeds, double &cursorRemainderX,
                                 double &cursorRemainderY, double weightModifier, int idleMouseRefrRate,
                                 QList<JoyButton *> *pendingMouseButtons)
@@ -3653,6 +3702,8 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QLi
         int queueLength = cursorXSpeeds->length();
         double finalx = 0.0;
         double finaly = 0.0;
+        bool perDeviceOutput = OutputSink::isPerDeviceOutput();
+        QVector<OutputShare> shares;
 
         for (int i = 0; i < queueLength; i++)
         {
@@ -3662,6 +3713,16 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QLi
             distanceForMovingAx(finalx, infoX);
             distanceForMovingAx(finaly, infoY);
 
+            if (perDeviceOutput)
+            {
+                addOutputShare(shares, qobject_cast<JoyButton *>(infoX.slot->parent()), infoX.code, 0.0);
+                addOutputShare(shares, qobject_cast<JoyButton *>(infoY.slot->parent()), 0.0, infoY.code);
+            }
+            countSlotOutput(infoX.slot);
+
+            if (infoY.slot != infoX.slot)
+                countSlotOutput(infoY.slot);
+
             infoX.slot->getMouseInterval()->restart();
             infoY.slot->getMouseInterval()->restart();
         }
@@ -3699,7 +3760,12 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QLi
         // This check is more of a precaution than anything. No need to cause
         // a sync to happen when not needed.
         if (!qFuzzyIsNull(adjustedX) || !qFuzzyIsNull(adjustedY))
-            sendevent(adjustedX, adjustedY);
+        {
+            if (perDeviceOutput)
+                sendOutputShares(shares, adjustedX, adjustedY, sendevent);
+            else
+                sendevent(adjustedX, adjustedY);
+        }
 
         movedX = adjustedX;
         movedY = adjustedY;
@@ -3710,7 +3776,7 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QLi
     }
 
     // Check if mouse event timer should use idle time.
-    if (pendingMouseButtons->length() == 0)
+    if ((pendingMouseButtons->length() == 0) && pendingWheelButtons.isEmpty())
     {
         if (staticMouseEventTimer->interval() != idleMouseRefrRate)
         {
@@ -3740,6 +3806,96 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QLi
     cursorYSpeeds->clear();
 }
 
+/**
+ * @brief Count output event generated for slot in counters of the button
+ *     owning it.
+ */
+void JoyButton::countSlotOutput(JoyButtonSlot *slot)
+{
+    JoyButton *button = qobject_cast<JoyButton *>(slot->parent());
+
+    if (button != nullptr)
+        button->counters.addOutput();
+}
+
+/**
+ * @brief SDL instance ID of controller owning the button. -1 when unknown.
+ */
+int JoyButton::getOutputDeviceId()
+{
+    if (!m_parentSet.isNull() && (m_parentSet->getInputDevice() != nullptr))
+        return m_parentSet->getInputDevice()->getSDLJoystickID();
+
+    return -1;
+}
+
+/**
+ * @brief Add movement of button to share of its controller. Only size of
+ *     movement counts, so movements in opposite directions do not cancel.
+ */
+void JoyButton::addOutputShare(QVector<OutputShare> &shares, JoyButton *button, double first, double second)
+{
+    int deviceId = (button != nullptr) ? button->getOutputDeviceId() : -1;
+
+    for (OutputShare &share : shares)
+    {
+        if (share.deviceId == deviceId)
+        {
+            share.first += fabs(first);
+            share.second += fabs(second);
+            return;
+        }
+    }
+
+    shares.append({deviceId, fabs(first), fabs(second)});
+}
+
+/**
+ * @brief Split combined movement between controllers by their shares and
+ *     send every part to output devices of its controller. Last controller
+ *     gets what is left after rounding, so total movement stays the same.
+ */
+void JoyButton::sendOutputShares(const QVector<OutputShare> &shares, int first, int second,
+                                 void (*send)(int, int, int))
+{
+    if (shares.isEmpty())
+    {
+        send(first, second, -1);
+        return;
+    }
+
+    double totalFirst = 0.0;
+    double totalSecond = 0.0;
+
+    for (const OutputShare &share : shares)
+    {
+        totalFirst += share.first;
+        totalSecond += share.second;
+    }
+
+    int remainingFirst = first;
+    int remainingSecond = second;
+
+    for (int i = 0; i < shares.size(); i++)
+    {
+        const OutputShare &share = shares.at(i);
+        int partFirst = remainingFirst;
+        int partSecond = remainingSecond;
+
+        if (i < (shares.size() - 1))
+        {
+            partFirst = (totalFirst > 0.0) ? qRound(first * share.first / totalFirst) : 0;
+            partSecond = (totalSecond > 0.0) ? qRound(second * share.second / totalSecond) : 0;
+        }
+
+        remainingFirst -= partFirst;
+        remainingSecond -= partSecond;
+
+        if ((partFirst != 0) || (partSecond != 0))
+            send(partFirst, partSecond, share.deviceId);
+    }
+}
+
 /**
  * @brief Combines mouse movement distances from multiple mouse mappings.
  * @param[in,out] finalAx Combined mouse distance from previous iteration. Updated by this function.
@@ -3786,7 +3942,7 @@ void JoyButton::adjustAxForCursor(QList<double> *mouseHistoryList, double &adjus
 void JoyButton::moveSpringMouse(int &movedX, int &movedY, bool &hasMoved, int springModeScreen,
                                 QList<PadderCommon::springModeInfo> *springXSpeeds,
                                 QList<PadderCommon::springModeInfo> *springYSpeeds, QList<JoyButton *> *pendingMouseButtons,
-                                int mouseRefreshRate, int idleMouseRefrRate, QTimer *staticMouseEventTimer)
+                                int mouseRefreshRate, int idleMouseRefrRate, EngineTimer *staticMouseEventTimer)
 {
     PadderCommon::springModeInfo fullSpring = {-2.0, -2.0, 0, 0, false, springModeScreen, 0.0, 0.0};
 
@@ -3902,9 +4058,10 @@ void JoyButton::moveSpringMouse(int &movedX, int &movedY, bool &hasMoved, int sp
     }
 
     // Check if mouse event timer should use idle time.
-    if (pendingMouseButtons->length() == 0)
+    if ((pendingMouseButtons->length() == 0) && pendingWheelButtons.isEmpty())
     {
-        staticMouseEventTimer->start(idleMouseRefrRate);
+        if (staticMouseEventTimer->interval() != idleMouseRefrRate)
+            staticMouseEventTimer->start(idleMouseRefrRate);
     } else
     {
         if (staticMouseEventTimer->interval() != mouseRefreshRate)
@@ -3918,6 +4075,8 @@ void JoyButton::moveSpringMouse(int &movedX, int &movedY, bool &hasMoved, int sp
 
 void JoyButton::keyPressEvent()
 {
+    ElementCounters::Scope scope(counters);
+
     if (keyPressTimer.isActive() && (keyPressHold.elapsed() >= getPreferredKeyPressTime()))
     {
         currentKeyPress = nullptr;
@@ -4055,7 +4214,8 @@ void JoyButton::establishMouseTimerConnections()
         staticMouseEventTimer.setTimerType(Qt::PreciseTimer);
 
     // Only one connection will be made for each.
-    connect(&staticMouseEventTimer, &QTimer::timeout, &mouseHelper, &JoyButtonMouseHelper::mouseEvent, Qt::UniqueConnection);
+    connect(&staticMouseEventTimer, &EngineTimer::timeout, &mouseHelper, &JoyButtonMouseHelper::mouseEvent,
+            Qt::UniqueConnection);
 
     if (staticMouseEventTimer.interval() != GlobalVariables::JoyButton::IDLEMOUSEREFRESHRATE)
         staticMouseEventTimer.setInterval(GlobalVariables::JoyButton::IDLEMOUSEREFRESHRATE);
@@ -4085,6 +4245,7 @@ void JoyButton::copyAssignments(JoyButton *destButton)
     destButton->eventReset();
     destButton->assignmentsLock.lockForWrite();
     destButton->getAssignmentsLocal().clear();
+    destButton->slotProgram.compile(destButton->assignments);
     destButton->assignmentsLock.unlock();
 
     assignmentsLock.lockForWrite();
@@ -4198,6 +4359,8 @@ JoyButtonMouseHelper *JoyButton::getMouseHelper() { return &mouseHelper; }
  */
 QList<JoyButton *> *JoyButton::getPendingMouseButtons() { return &pendingMouseButtons; }
 
+QList<JoyButton *> *JoyButton::getPendingWheelButtons() { return &pendingWheelButtons; }
+
 QList<JoyButton::mouseCursorInfo> *JoyButton::getCursorXSpeeds() { return &cursorXSpeeds; }
 
 QList<JoyButton::mouseCursorInfo> *JoyButton::getCursorYSpeeds() { return &cursorYSpeeds; }
@@ -4206,9 +4369,9 @@ QList<PadderCommon::springModeInfo> *JoyButton::getSpringXSpeeds() { return &spr
 
 QList<PadderCommon::springModeInfo> *JoyButton::getSpringYSpeeds() { return &springYSpeeds; }
 
-QTimer *JoyButton::getStaticMouseEventTimer() { return &staticMouseEventTimer; }
+EngineTimer *JoyButton::getStaticMouseEventTimer() { return &staticMouseEventTimer; }
 
-QElapsedTimer *JoyButton::getTestOldMouseTime() { return &testOldMouseTime; }
+EngineElapsedTimer *JoyButton::getTestOldMouseTime() { return &testOldMouseTime; }
 
 bool JoyButton::hasCursorEvents(QList<JoyButton::mouseCursorInfo> *cursorXSpeedsList,
                                 QList<JoyButton::mouseCursorInfo> *cursorYSpeedsList)
@@ -4255,8 +4418,8 @@ void JoyButton::setMouseHistorySize(int size, int maxMouseHistSize, int &mouseHi
  */
 void JoyButton::setMouseRefreshRate(int refresh, int &mouseRefreshRate, int idleMouseRefrRate,
                                     JoyButtonMouseHelper *mouseHelper, QList<double> *mouseHistoryX,
-                                    QList<double> *mouseHistoryY, QElapsedTimer *testOldMouseTime,
-                                    QTimer *staticMouseEventTimer)
+                                    QList<double> *mouseHistoryY, EngineElapsedTimer *testOldMouseTime,
+                                    EngineTimer *staticMouseEventTimer)
 {
     if ((refresh >= 1) && (refresh <= 16))
     {
@@ -4371,7 +4534,6 @@ void JoyButton::resetAllProperties()
     restartAccelParams(false, false, true);
     lastWheelVerticalDistance = 0.0;
     lastWheelHorizontalDistance = 0.0;
-    tempTurboInterval = 0;
     currentTurboMode = DEFAULTTURBOMODE;
     m_easingDuration = GlobalVariables::JoyButton::DEFAULTEASINGDURATION;
     springDeadCircleMultiplier = GlobalVariables::JoyButton::DEFAULTSPRINGRELEASERADIUS;
@@ -4500,6 +4662,8 @@ void JoyButton::setSpringModeScreen(int screen, int &springModeScreen)
         springModeScreen = screen;
 }
 
+void JoyButton::setHiResScroll(bool enabled, bool &hiResScroll) { hiResScroll = enabled; }
+
 void JoyButton::setAccelExtraDuration(double value)
 {
     if ((value >= 0.0) && (value <= 5.0))
@@ -4543,10 +4707,11 @@ int JoyButton::getSpringDeadCircleMultiplier() { return springDeadCircleMultipli
 
 double JoyButton::getCurrentSpringDeadCircle() { return (springDeadCircleMultiplier * 0.01); }
 
-void JoyButton::restartLastMouseTime(QElapsedTimer *testOldMouseTime) { testOldMouseTime->restart(); }
+void JoyButton::restartLastMouseTime(EngineElapsedTimer *testOldMouseTime) { testOldMouseTime->restart(); }
 
-void JoyButton::setStaticMouseThread(QThread *thread, QTimer *staticMouseEventTimer, QElapsedTimer *testOldMouseTime,
-                                     int idleMouseRefrRate, JoyButtonMouseHelper *mouseHelper)
+void JoyButton::setStaticMouseThread(QThread *thread, EngineTimer *staticMouseEventTimer,
+                                     EngineElapsedTimer *testOldMouseTime, int idleMouseRefrRate,
+                                     JoyButtonMouseHelper *mouseHelper)
 {
     int oldInterval = staticMouseEventTimer->interval();
 
@@ -4561,14 +4726,15 @@ void JoyButton::setStaticMouseThread(QThread *thread, QTimer *staticMouseEventTi
     testOldMouseTime->start();
 }
 
-void JoyButton::indirectStaticMouseThread(QThread *thread, QTimer *staticMouseEventTimer, JoyButtonMouseHelper *mouseHelper)
+void JoyButton::indirectStaticMouseThread(QThread *thread, EngineTimer *staticMouseEventTimer,
+                                          JoyButtonMouseHelper *mouseHelper)
 {
     QMetaObject::invokeMethod(staticMouseEventTimer, "stop");
     QMetaObject::invokeMethod(mouseHelper, "changeThread", Q_ARG(QThread *, thread));
 }
 
-bool JoyButton::shouldInvokeMouseEvents(QList<JoyButton *> *pendingMouseButtons, QTimer *staticMouseEventTimer,
-                                        QElapsedTimer *testOldMouseTime)
+bool JoyButton::shouldInvokeMouseEvents(QList<JoyButton *> *pendingMouseButtons, EngineTimer *staticMouseEventTimer,
+                                        EngineElapsedTimer *testOldMouseTime)
 {
     bool result = false;
 
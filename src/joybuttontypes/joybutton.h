@@ -19,24 +19,26 @@
 #ifndef JOYBUTTON_H
 #define JOYBUTTON_H
 
+#include "elementcounters.h"
+#include "engineclock.h"
+#include "enginetimer.h"
 #include "globalvariables.h"
 #include "joybuttonmousehelper.h"
 #include "joybuttonslot.h"
+#include "joybuttonslotprogram.h"
 #include "springmousemoveinfo.h"
 
 #include <QDeadlineTimer>
 #include <QQueue>
 #include <QReadWriteLock>
-#include <QRunnable>
 #include <QThread>
-#include <QTimer>
+#include <QVector>
 
 class VDPad;
 class SetJoystick;
 class QXmlStreamReader;
 class QXmlStreamWriter;
 // class QThread;
-class QThreadPool;
 
 /**
  * @brief Represents a single joystick button being part of a SetJoystick
@@ -123,6 +125,7 @@ class JoyButton : public QObject
     void activateMiniSlots(JoyButtonSlot *slot, JoyButtonSlot *mix);
 
     bool hasPendingEvent(); // JoyButtonEvents class
+    ElementCounters &getCounters();
     bool getToggleState();
     bool isUsingTurbo();
     bool getButtonState();
@@ -212,48 +215,56 @@ class JoyButton : public QObject
     TurboMode getTurboMode();
 
     static int calculateFinalMouseSpeed(JoyMouseCurve curve, int value, const float joyspeed);
+    static void countSlotOutput(JoyButtonSlot *slot);
 
     static bool hasCursorEvents(QList<JoyButton::mouseCursorInfo> *cursorXSpeedsList,
                                 QList<JoyButton::mouseCursorInfo> *cursorYSpeedsList); // JoyButtonEvents class
     static bool hasSpringEvents(QList<PadderCommon::springModeInfo> *springXSpeedsList,
                                 QList<PadderCommon::springModeInfo> *springYSpeedsList); // JoyButtonEvents class
-    static bool shouldInvokeMouseEvents(QList<JoyButton *> *pendingMouseButtons, QTimer *staticMouseEventTimer,
-                                        QElapsedTimer *testOldMouseTime);
+    static bool shouldInvokeMouseEvents(QList<JoyButton *> *pendingMouseButtons, EngineTimer *staticMouseEventTimer,
+                                        EngineElapsedTimer *testOldMouseTime);
 
     static void setWeightModifier(double modifier, double maxWeightModifier, double &weightModifier);
     static void moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QList<double> *mouseHistoryX,
-                                QList<double> *mouseHistoryY, QElapsedTimer *testOldMouseTime, QTimer *staticMouseEventTimer,
-                                int mouseRefreshRate, int mouseHistorySize, QList<JoyButton::mouseCursorInfo> *cursorXSpeeds,
+                                QList<double> *mouseHistoryY, EngineElapsedTimer *testOldMouseTime,
+                                EngineTimer *staticMouseEventTimer, int mouseRefreshRate, int mouseHistorySize,
+                                QList<JoyButton::mouseCursorInfo> *cursorXSpeeds,
                                 QList<JoyButton::mouseCursorInfo> *cursorYSpeeds, double &cursorRemainderX,
                                 double &cursorRemainderY, double weightModifier, int idleMouseRefrRate,
                                 QList<JoyButton *> *pendingMouseButtonse);
     static void moveSpringMouse(int &movedX, int &movedY, bool &hasMoved, int springModeScreen,
                                 QList<PadderCommon::springModeInfo> *springXSpeeds,
                                 QList<PadderCommon::springModeInfo> *springYSpeeds, QList<JoyButton *> *pendingMouseButtons,
-                                int mouseRefreshRate, int idleMouseRefrRate, QTimer *staticMouseEventTimer);
+                                int mouseRefreshRate, int idleMouseRefrRate, EngineTimer *staticMouseEventTimer);
     static void setMouseHistorySize(int size, int maxMouseHistSize, int &mouseHistSize, QList<double> *mouseHistoryX,
                                     QList<double> *mouseHistoryY);
     static void setMouseRefreshRate(int refresh, int &mouseRefreshRate, int idleMouseRefrRate,
                                     JoyButtonMouseHelper *mouseHelper, QList<double> *mouseHistoryX,
-                                    QList<double> *mouseHistoryY, QElapsedTimer *testOldMouseTime,
-                                    QTimer *staticMouseEventTimer);
+                                    QList<double> *mouseHistoryY, EngineElapsedTimer *testOldMouseTime,
+                                    EngineTimer *staticMouseEventTimer);
     static void setSpringModeScreen(int screen, int &springModeScreen);
+    static void setHiResScroll(bool enabled, bool &hiResScroll);
+    static void moveMouseWheel(int elapsed, QList<JoyButton *> *pendingWheelButtons, double &wheelRemainderX,
+                               double &wheelRemainderY);
     static void resetActiveButtonMouseDistances(JoyButtonMouseHelper *mouseHelper);
     static void setGamepadRefreshRate(int refresh, int &gamepadRefreshRate, JoyButtonMouseHelper *mouseHelper);
-    static void restartLastMouseTime(QElapsedTimer *testOldMouseTime);
-    static void setStaticMouseThread(QThread *thread, QTimer *staticMouseEventTimer, QElapsedTimer *testOldMouseTime,
-                                     int idleMouseRefrRate, JoyButtonMouseHelper *mouseHelper);
-    static void indirectStaticMouseThread(QThread *thread, QTimer *staticMouseEventTimer, JoyButtonMouseHelper *mouseHelper);
+    static void restartLastMouseTime(EngineElapsedTimer *testOldMouseTime);
+    static void setStaticMouseThread(QThread *thread, EngineTimer *staticMouseEventTimer,
+                                     EngineElapsedTimer *testOldMouseTime, int idleMouseRefrRate,
+                                     JoyButtonMouseHelper *mouseHelper);
+    static void indirectStaticMouseThread(QThread *thread, EngineTimer *staticMouseEventTimer,
+                                          JoyButtonMouseHelper *mouseHelper);
     static void invokeMouseEvents(JoyButtonMouseHelper *mouseHelper); // JoyButtonEvents class
 
     static JoyButtonMouseHelper *getMouseHelper();
     static QList<JoyButton *> *getPendingMouseButtons();
+    static QList<JoyButton *> *getPendingWheelButtons();
     static QList<JoyButton::mouseCursorInfo> *getCursorXSpeeds();
     static QList<JoyButton::mouseCursorInfo> *getCursorYSpeeds();
     static QList<PadderCommon::springModeInfo> *getSpringXSpeeds();
     static QList<PadderCommon::springModeInfo> *getSpringYSpeeds();
-    static QTimer *getStaticMouseEventTimer(); // JoyButtonEvents class
-    static QElapsedTimer *getTestOldMouseTime();
+    static EngineTimer *getStaticMouseEventTimer(); // JoyButtonEvents class
+    static EngineElapsedTimer *getTestOldMouseTime();
 
     JoyExtraAccelerationCurve getExtraAccelerationCurve();
 
@@ -282,21 +293,24 @@ class JoyButton : public QObject
     void localBuildActiveZoneSummaryString();
 
     static bool hasFutureSpringEvents(QList<JoyButton *> *pendingMouseButtons);
-    static int timeBetweenMiniSlots;
-    static int allSlotTimeBetweenSlots;
 
     virtual double getCurrentSpringDeadCircle();
+    virtual void turboDistanceEvent(); // JoyButtonEvents class
 
     TurboMode currentTurboMode;
 
     QString buildActiveZoneSummary(QList<JoyButtonSlot *> &tempList);
 
+    void startHiResWheelEvent();
+    void hiResWheelEvent(int elapsed, double &finalVertical, double &finalHorizontal); // JoyButtonEvents class
+
     static QList<JoyButtonSlot *> mouseSpeedModList; // JoyButtonSlots class
     static QList<mouseCursorInfo> cursorXSpeeds;
     static QList<mouseCursorInfo> cursorYSpeeds;
     static QList<PadderCommon::springModeInfo> springXSpeeds;
     static QList<PadderCommon::springModeInfo> springYSpeeds;
     static QList<JoyButton *> pendingMouseButtons;
+    static QList<JoyButton *> pendingWheelButtons;
     static JoyButtonSlot *lastActiveKey; // JoyButtonSlots class
     static JoyButtonMouseHelper mouseHelper;
 
@@ -305,7 +319,6 @@ class JoyButton : public QObject
     int wheelSpeedX;
     int wheelSpeedY;
     int setSelection;
-    int tempTurboInterval;
     int springDeadCircleMultiplier;
 
     bool isButtonPressed; // Used to denote whether the actual joypad button is pressed
@@ -315,13 +328,13 @@ class JoyButton : public QObject
     double lastWheelVerticalDistance;
     double lastWheelHorizontalDistance;
 
-    QTimer turboTimer;
-    QTimer mouseWheelVerticalEventTimer;
-    QTimer mouseWheelHorizontalEventTimer;
+    EngineTimer turboTimer;
+    EngineTimer mouseWheelVerticalEventTimer;
+    EngineTimer mouseWheelHorizontalEventTimer;
 
-    QElapsedTimer wheelVerticalTime;
-    QElapsedTimer wheelHorizontalTime;
-    QElapsedTimer turboHold;
+    EngineElapsedTimer wheelVerticalTime;
+    EngineElapsedTimer wheelHorizontalTime;
+    EngineElapsedTimer turboHold;
 
     QPointer<SetJoystick> m_parentSet;
     SetChangeCondition setSelectionCondition;
@@ -525,7 +538,9 @@ class JoyButton : public QObject
     void resetAllProperties();
     void resetPrivVars();
     void restartAllForSetChange();
-    void startTimerOverrun(int slotCode, QElapsedTimer *currSlotTime, QTimer *currSlotTimer, bool releasedDeskTimer = false);
+    void startKeyRepeat(JoyButtonSlot *slot);
+    void startTimerOverrun(int slotCode, EngineElapsedTimer *currSlotTime, EngineTimer *currSlotTimer,
+                           bool releasedDeskTimer = false);
     void findJoySlotsEnd(QListIterator<JoyButtonSlot *> *slotiter);
     void changeStatesQueue(bool currentReleased);
     void countActiveSlots(int tempcode, int &references, JoyButtonSlot *slot, QHash<int, int> &activeSlotsHash,
@@ -534,6 +549,22 @@ class JoyButton : public QObject
                           QList<int> &indexesToRemove); // JoyButtonSlots class
     void setSpringDeadCircle(double &springDeadCircle, int mouseDirection);
     void checkSpringDeadCircle(int tempcode, double &springDeadCircle, int mouseSlot1, int mouseSlot2);
+    /**
+     * @brief Part of combined relative movement caused by buttons of one
+     *     controller. Used to split movement between output devices of
+     *     controllers.
+     */
+    struct OutputShare
+    {
+        int deviceId;
+        double first;
+        double second;
+    };
+
+    int getOutputDeviceId();
+    static void addOutputShare(QVector<OutputShare> &shares, JoyButton *button, double first, double second);
+    static void sendOutputShares(const QVector<OutputShare> &shares, int first, int second,
+                                 void (*send)(int, int, int));
     static void distanceForMovingAx(double &finalAx, mouseCursorInfo infoAx);
     static void adjustAxForCursor(QList<double> *mouseHistoryList, double &adjustedAx, double &cursorRemainder,
                                   double weightModifier);
@@ -600,22 +631,23 @@ class JoyButton : public QObject
     double m_easingDuration;
     double extraAccelerationMultiplier;
 
-    QTimer pauseTimer;
-    QTimer holdTimer;
-    QTimer pauseWaitTimer;
-    QTimer createDeskTimer;
-    QTimer releaseDeskTimer;
-    QTimer setChangeTimer;
-    QTimer keyPressTimer;
-    QTimer delayTimer;
-    QTimer slotSetChangeTimer;
-    static QTimer staticMouseEventTimer; // JoyButtonEvents class
+    EngineTimer pauseTimer;
+    EngineTimer holdTimer;
+    EngineTimer pauseWaitTimer;
+    EngineTimer createDeskTimer;
+    EngineTimer releaseDeskTimer;
+    EngineTimer setChangeTimer;
+    EngineTimer keyPressTimer;
+    EngineTimer delayTimer;
+    EngineTimer slotSetChangeTimer;
+    static EngineTimer staticMouseEventTimer; // JoyButtonEvents class
 
     QString customName;
     QString actionName;
     QString activeZoneString;
 
     QList<JoyButtonSlot *> assignments;
+    JoyButtonSlotProgram slotProgram; // Compiled layout of assignments
     QList<JoyButtonSlot *> activeSlots;
     QListIterator<JoyButtonSlot *> *slotiter;
     QQueue<JoyButtonSlot *> mouseEventQueue; // JoyButtonEvents class
@@ -630,15 +662,15 @@ class JoyButton : public QObject
     JoyButtonSlot *currentDelay;
     JoyButtonSlot *currentSetChangeSlot;
 
-    QElapsedTimer buttonHold;
-    QElapsedTimer pauseHold;
-    QElapsedTimer inpauseHold;
-    QElapsedTimer buttonHeldRelease;
-    QElapsedTimer keyPressHold;
-    QElapsedTimer buttonDelay;
-    QElapsedTimer accelExtraDurationTime;
-    QElapsedTimer cycleResetHold;
-    static QElapsedTimer testOldMouseTime;
+    EngineElapsedTimer buttonHold;
+    EngineElapsedTimer pauseHold;
+    EngineElapsedTimer inpauseHold;
+    EngineElapsedTimer buttonHeldRelease;
+    EngineElapsedTimer keyPressHold;
+    EngineElapsedTimer buttonDelay;
+    EngineElapsedTimer accelExtraDurationTime;
+    EngineElapsedTimer cycleResetHold;
+    static EngineElapsedTimer testOldMouseTime;
 
     VDPad *m_vdpad;
     JoyMouseMovementMode mouseMode;
@@ -648,38 +680,11 @@ class JoyButton : public QObject
     QReadWriteLock activeZoneLock;
     QReadWriteLock assignmentsLock;
     QReadWriteLock activeZoneStringLock;
-    QThreadPool *threadPool;
+
+    ElementCounters counters;
 
     void addEachSlotToActives(JoyButtonSlot *slot, int &i, bool &delaySequence, bool &exit,
                               QListIterator<JoyButtonSlot *> *slotiter);
 };
 
-class MiniSlotRun : public QRunnable, public QObject
-{
-  public:
-    MiniSlotRun(JoyButtonSlot *slot, JoyButtonSlot *slotmini, JoyButton *btn, int milisec)
-        : QObject(btn)
-        , m_slot(slot)
-        , m_slotmini(slotmini)
-        , m_btn(btn)
-        , m_miliseconds(milisec)
-    {
-    }
-
-    ~MiniSlotRun() {}
-
-    void run()
-    {
-        this->thread()->wait(m_miliseconds);
-
-        m_btn->activateMiniSlots(m_slotmini, m_slot);
-    }
-
-  private:
-    JoyButtonSlot *m_slot;
-    JoyButtonSlot *m_slotmini;
-    JoyButton *m_btn;
-    int m_miliseconds;
-};
-
 #endif // JOYBUTTON_H
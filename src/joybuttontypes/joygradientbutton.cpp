@@ -31,190 +31,97 @@ JoyGradientButton::JoyGradientButton(int sdl_button_index, int originset, SetJoy
 }
 
 /**
- * @brief Activate a turbo event on a button.
+ * @brief Activate a turbo event on a button. Gradient and pulse turbo
+ *     change key state once per phase and arm turboTimer for the end of
+ *     the next phase, whose length depends on current distance.
  */
 void JoyGradientButton::turboEvent()
 {
-    int m_turboInterval = containsJoyMixSlot() && allSlotTimeBetweenSlots > 0 ? allSlotTimeBetweenSlots : turboInterval;
-
     if (getTurboMode() == NormalTurbo)
     {
         JoyButton::turboEvent();
-    } else if ((getTurboMode() == GradientTurbo) || (getTurboMode() == PulseTurbo))
-    {
-        double diff = fabs(getMouseDistanceFromDeadZone() - lastDistance);
-
-        qDebug() << "DIFF: " << QString::number(diff);
-
-        bool changeState = false;
+        return;
+    }
 
-        if (!turboTimer.isActive() && !isButtonPressed)
-        {
-            changeState = true;
-        } else if ((getTurboMode() == GradientTurbo) && (diff > 0) && (getMouseDistanceFromDeadZone() >= 1.0))
-        {
-            if (isKeyPressed)
-            {
-                changeState = false;
+    // Gradient turbo keeps key pressed at full distance
+    bool holdPress = isKeyPressed && isButtonPressed && turboTimer.isActive() && (getTurboMode() == GradientTurbo) &&
+                     (getMouseDistanceFromDeadZone() >= 1.0);
 
-                if (!turboTimer.isActive() || (turboTimer.interval() != 5))
-                {
-                    turboTimer.start(5);
-                }
+    if (!holdPress)
+        changeTurboState();
 
-                turboHold.restart();
-                lastDistance = 1.0;
-            } else
-            {
-                changeState = true;
-            }
-        }
+    if (turboTimer.isActive())
+    {
+        turboHold.restart();
+        turboTimer.start(getTurboPhaseInterval());
+    }
 
-        else if (lastDistance == 0.0 || (turboHold.elapsed() > tempTurboInterval))
-        {
-            changeState = true;
-        } else if (diff >= 0.1)
-        {
-            int tempInterval2 = 0;
+    lastDistance = getMouseDistanceFromDeadZone();
+}
 
-            if (isKeyPressed)
-            {
-                if (getTurboMode() == GradientTurbo)
-                {
-                    tempInterval2 = floor((getMouseDistanceFromDeadZone() * m_turboInterval) + 0.5);
-                } else
-                {
-                    tempInterval2 = floor((m_turboInterval * 0.5) + 0.5);
-                }
-            } else
-            {
-                if (getTurboMode() == GradientTurbo)
-                {
-                    tempInterval2 = floor(((1 - getMouseDistanceFromDeadZone()) * m_turboInterval) + 0.5);
-                } else
-                {
-                    double distance = getMouseDistanceFromDeadZone();
-
-                    if (distance > 0.0)
-                    {
-                        tempInterval2 = floor(((m_turboInterval / getMouseDistanceFromDeadZone()) * 0.5) + 0.5);
-                    } else
-                    {
-                        tempInterval2 = 0;
-                    }
-                }
-            }
+/**
+ * @brief Move end of current turbo phase after distance changed instead
+ *     of checking distance periodically.
+ */
+void JoyGradientButton::turboDistanceEvent()
+{
+    if ((getTurboMode() == NormalTurbo) || !turboTimer.isActive())
+        return;
 
-            if (turboHold.elapsed() < tempInterval2)
-            {
-                // Still some valid time left. Continue current action with
-                // remaining time left.
-                tempTurboInterval = tempInterval2 - turboHold.elapsed();
-                int timerInterval = qMin(tempTurboInterval, 5);
+    int remaining = getTurboPhaseInterval() - static_cast<int>(turboHold.elapsed());
 
-                if (!turboTimer.isActive() || (turboTimer.interval() != timerInterval))
-                {
-                    turboTimer.start(timerInterval);
-                }
+    if (remaining <= 0)
+        turboEvent();
+    else if (turboTimer.remainingTime() != remaining)
+        turboTimer.start(remaining);
+}
 
-                turboHold.restart();
-                changeState = false;
-                lastDistance = getMouseDistanceFromDeadZone();
+/**
+ * @brief Length of current turbo phase in ms. Gradient turbo keeps key
+ *     pressed for a fraction of turbo interval equal to distance. Pulse
+ *     turbo has fixed press length and release shorter with distance.
+ */
+int JoyGradientButton::getTurboPhaseInterval()
+{
+    int interval = turboInterval;
+    double distance = qBound(0.0, getMouseDistanceFromDeadZone(), 1.0);
+    double fraction = 0.0;
+
+    if (getTurboMode() == GradientTurbo)
+        fraction = isKeyPressed ? distance : (1.0 - distance);
+    else if (isKeyPressed)
+        fraction = 0.5;
+    else if (distance > 0.0)
+        fraction = 0.5 / distance;
+
+    return static_cast<int>(floor((interval * fraction) + 0.5));
+}
 
-                qDebug() << "diff tmpTurbo press: " << QString::number(tempTurboInterval);
-                qDebug() << "diff timer press: " << QString::number(timerInterval);
-            } else
-            {
-                changeState = true;
+void JoyGradientButton::changeTurboState()
+{
+    if (!isKeyPressed)
+    {
+        if (!isButtonPressedQueue.isEmpty())
+        {
+            ignoreSetQueue.clear();
+            isButtonPressedQueue.clear();
 
-                qDebug() << "YOU GOT CHANGE";
-            }
+            ignoreSetQueue.enqueue(false);
+            isButtonPressedQueue.enqueue(isButtonPressed);
         }
 
-        if (changeState)
+        createDeskEvent();
+        isKeyPressed = true;
+    } else
+    {
+        if (!isButtonPressedQueue.isEmpty())
         {
-            if (!isKeyPressed)
-            {
-                if (!isButtonPressedQueue.isEmpty())
-                {
-                    ignoreSetQueue.clear();
-                    isButtonPressedQueue.clear();
-
-                    ignoreSetQueue.enqueue(false);
-                    isButtonPressedQueue.enqueue(isButtonPressed);
-                }
-
-                createDeskEvent();
-
-                isKeyPressed = true;
-                if (turboTimer.isActive())
-                {
-                    if (getTurboMode() == GradientTurbo)
-                    {
-                        tempTurboInterval = floor((getMouseDistanceFromDeadZone() * m_turboInterval) + 0.5);
-                    } else
-                    {
-                        tempTurboInterval = floor((m_turboInterval * 0.5) + 0.5);
-                    }
-
-                    int timerInterval = qMin(tempTurboInterval, 5);
-
-                    qDebug() << "tmpTurbo press: " << QString::number(tempTurboInterval);
-                    qDebug() << "timer press: " << QString::number(timerInterval);
-
-                    if (turboTimer.interval() != timerInterval)
-                    {
-                        turboTimer.start(timerInterval);
-                    }
-
-                    turboHold.restart();
-                }
-            } else
-            {
-                if (!isButtonPressedQueue.isEmpty())
-                {
-                    ignoreSetQueue.enqueue(false);
-                    isButtonPressedQueue.enqueue(!isButtonPressed);
-                }
-
-                releaseDeskEvent();
-
-                isKeyPressed = false;
-
-                if (turboTimer.isActive())
-                {
-                    if (getTurboMode() == GradientTurbo)
-                    {
-                        tempTurboInterval = floor(((1 - getMouseDistanceFromDeadZone()) * m_turboInterval) + 0.5);
-                    } else
-                    {
-                        double distance = getMouseDistanceFromDeadZone();
-
-                        if (distance > 0.0)
-                        {
-                            tempTurboInterval = floor(((m_turboInterval / getMouseDistanceFromDeadZone()) * 0.5) + 0.5);
-                        } else
-                        {
-                            tempTurboInterval = 0;
-                        }
-                    }
-
-                    int timerInterval = qMin(tempTurboInterval, 5);
-
-                    qDebug() << "tmpTurbo release: " << QString::number(tempTurboInterval);
-                    qDebug() << "timer release: " << QString::number(timerInterval);
-
-                    if (turboTimer.interval() != timerInterval)
-                    {
-                        turboTimer.start(timerInterval);
-                    }
-
-                    turboHold.restart();
-                }
-            }
-
-            lastDistance = getMouseDistanceFromDeadZone();
+            ignoreSetQueue.enqueue(false);
+            isButtonPressedQueue.enqueue(!isButtonPressed);
         }
+
+        releaseDeskEvent();
+        isKeyPressed = false;
     }
 }
 
@@ -33,10 +33,17 @@ class JoyGradientButton : public JoyButton
     using JoyButton::getPartialName;
     using JoyButton::setChangeSetCondition;
 
+  protected:
+    virtual void turboDistanceEvent();
+
   protected slots:
     virtual void turboEvent();
     virtual void wheelEventVertical();
     virtual void wheelEventHorizontal();
+
+  private:
+    int getTurboPhaseInterval();
+    void changeTurboState();
 };
 
 #endif // JOYGRADIENTBUTTON_H
@@ -53,7 +53,7 @@ JoyControlStick::JoyControlStick(JoyAxis *axis1, JoyAxis *axis2, int index, int
     populateStickBtns();
     directionDelayTimer.setSingleShot(true);
 
-    connect(&directionDelayTimer, &QTimer::timeout, this, &JoyControlStick::stickDirectionChangeEvent);
+    connect(&directionDelayTimer, &EngineTimer::timeout, this, &JoyControlStick::stickDirectionChangeEvent);
 }
 
 JoyControlStick::~JoyControlStick()
@@ -71,6 +71,7 @@ JoyControlStick::~JoyControlStick()
  */
 void JoyControlStick::joyEvent(bool ignoresets)
 {
+    ElementCounters::Scope scope(counters);
     safezone = !inDeadZone();
 
     if (safezone && !isActive)
@@ -206,6 +207,7 @@ int JoyControlStick::getDiagonalRange() { return diagonalRange; }
  */
 void JoyControlStick::createDeskEvent(bool ignoresets)
 {
+    ElementCounters::Scope scope(counters);
     JoyControlStickButton *eventbutton1 = nullptr;
     JoyControlStickButton *eventbutton2 = nullptr;
     JoyControlStickButton *eventbutton3 = nullptr;
@@ -2824,11 +2826,20 @@ void JoyControlStick::queueJoyEvent(bool ignoresets)
 {
     Q_UNUSED(ignoresets)
 
+    counters.addReceived();
+
+    if (pendingStickEvent)
+        counters.addCoalesced();
+    else if (getParentSet() != nullptr)
+        getParentSet()->queueDirtyStick(this);
+
     pendingStickEvent = true;
 }
 
 bool JoyControlStick::hasPendingEvent() { return pendingStickEvent; }
 
+ElementCounters &JoyControlStick::getCounters() { return counters; }
+
 void JoyControlStick::activatePendingEvent()
 {
     if (pendingStickEvent)
@@ -65,6 +65,7 @@ class JoyControlStick : public QObject, public JoyStickDirectionsType
     bool hasSlotsAssigned();
     bool isRelativeSpring();
     bool hasPendingEvent(); // JoyControlStickEvent class
+    ElementCounters &getCounters();
 
     bool isCalibrated() const;
     void resetCalibration();
@@ -303,11 +304,13 @@ class JoyControlStick : public QObject, public JoyStickDirectionsType
     QString stickName;
     QString defaultStickName;
 
-    QTimer directionDelayTimer;
+    EngineTimer directionDelayTimer;
 
     QHash<JoyStickDirections, JoyControlStickButton *> buttons;
     JoyControlStickModifierButton *modifierButton;
 
+    ElementCounters counters;
+
     void populateStickBtns();
 };
 
@@ -44,7 +44,7 @@ JoyDPad::JoyDPad(int index, int originset, SetJoystick *parentSet, QObject *pare
     pendingIgnoreSets = false;
 
     directionDelayTimer.setSingleShot(true);
-    connect(&directionDelayTimer, &QTimer::timeout, this, &JoyDPad::dpadDirectionChangeEvent);
+    connect(&directionDelayTimer, &EngineTimer::timeout, this, &JoyDPad::dpadDirectionChangeEvent);
 }
 
 JoyDPadButton *JoyDPad::getJoyButton(int index_local) { return buttons.value(index_local); }
@@ -114,6 +114,13 @@ QString JoyDPad::getXmlName() { return GlobalVariables::JoyDPad::xmlName; }
 
 void JoyDPad::queuePendingEvent(int value, bool ignoresets)
 {
+    counters.addReceived();
+
+    if (pendingEvent)
+        counters.addCoalesced();
+    else if (m_parentSet != nullptr)
+        m_parentSet->queueDirtyDPad(this);
+
     pendingEvent = true;
     pendingEventDirection = value;
     pendingIgnoreSets = ignoresets;
@@ -133,6 +140,8 @@ void JoyDPad::activatePendingEvent()
 
 bool JoyDPad::hasPendingEvent() { return pendingEvent; }
 
+ElementCounters &JoyDPad::getCounters() { return counters; }
+
 void JoyDPad::clearPendingEvent()
 {
     pendingEvent = false;
@@ -142,6 +151,12 @@ void JoyDPad::clearPendingEvent()
 
 void JoyDPad::joyEvent(int value, bool ignoresets)
 {
+    ElementCounters::Scope scope(counters);
+
+    // Queued events were counted by queuePendingEvent
+    if (!pendingEvent)
+        counters.addReceived();
+
     if (value != static_cast<int>(pendingDirection))
     {
         if (value != static_cast<int>(JoyDPadButton::DpadCentered))
@@ -642,6 +657,7 @@ void JoyDPad::copyAssignments(JoyDPad *destDPad)
 
 void JoyDPad::createDeskEvent(bool ignoresets)
 {
+    ElementCounters::Scope scope(counters);
     JoyDPadButton *curButton = nullptr;
     JoyDPadButton *prevButton = nullptr;
     JoyDPadButton::JoyDPadDirections value = pendingDirection;
@@ -19,6 +19,7 @@
 #ifndef JOYDPAD_H
 #define JOYDPAD_H
 
+#include "elementcounters.h"
 #include "joybuttontypes/joydpadbutton.h"
 
 class JoyDPad : public QObject
@@ -50,6 +51,7 @@ class JoyDPad : public QObject
     void activatePendingEvent();                                // JoyDPadEvent class
     bool hasPendingEvent();                                     // JoyDPadEvent class
     void clearPendingEvent();                                   // JoyDPadEvent class
+    ElementCounters &getCounters();
 
     void setJoyMode(JoyMode mode);
     JoyMode getJoyMode();
@@ -145,7 +147,7 @@ class JoyDPad : public QObject
     QString defaultDPadName;
 
     SetJoystick *m_parentSet;
-    QTimer directionDelayTimer;
+    EngineTimer directionDelayTimer;
     JoyMode currentMode;
 
     int m_index;
@@ -155,6 +157,8 @@ class JoyDPad : public QObject
 
     bool pendingEvent;
     bool pendingIgnoreSets;
+
+    ElementCounters counters;
 };
 
 #endif // JOYDPAD_H
@@ -16,59 +16,115 @@
  */
 
 #include "joykeyrepeathelper.h"
+
 #include "event.h"
+#include "eventhandlerfactory.h"
 #include "joybuttonslot.h"
+#include "joybuttontypes/joybutton.h"
 
 JoyKeyRepeatHelper::JoyKeyRepeatHelper(QObject *parent)
     : QObject(parent)
 {
-    lastActiveKey = 0;
     keyRepeatTimer.setParent(this);
-    connect(&keyRepeatTimer, SIGNAL(timeout()), this, SLOT(repeatKeysEvent()));
+    keyRepeatTimer.setSingleShot(true);
+    keyRepeatTimer.setTimerType(Qt::PreciseTimer);
+    connect(&keyRepeatTimer, &EngineTimer::timeout, this, &JoyKeyRepeatHelper::repeatKeysEvent);
+    clock.start();
 }
 
-QTimer *JoyKeyRepeatHelper::getRepeatTimer() { return &keyRepeatTimer; }
+/**
+ * @brief Start repeating key of slot after repeatDelay ms, then every
+ *     repeatRate ms. Pressing key again restarts delay.
+ */
+void JoyKeyRepeatHelper::keyPressed(JoyButton *button, JoyButtonSlot *slot, int repeatDelay, int repeatRate)
+{
+    removeKey(slot);
+    keys.append({button, slot, clock.elapsed() + repeatDelay, qMax(1, repeatRate)});
+    scheduleNextRepeat();
+}
 
-void JoyKeyRepeatHelper::repeatKeysEvent()
+void JoyKeyRepeatHelper::clear()
 {
-    if (lastActiveKey)
-    {
-        JoyButtonSlot *slot = lastActiveKey;
+    keys.clear();
+    keyRepeatTimer.stop();
+}
 
-        // Send another key press to fake a key repeat
-        sendevent(slot);
+/**
+ * @brief Send repeat of every key whose deadline has passed. Called by
+ *     own timer and while input events of the device are processed, so
+ *     repeats that are due go out in the same output batch. Repeats
+ *     missed because of a stall are dropped instead of sent in a burst.
+ */
+void JoyKeyRepeatHelper::sendDueRepeats()
+{
+    if (keys.isEmpty())
+        return;
+
+    qint64 now = clock.elapsed();
+    bool sent = false;
 
-        keyRepeatTimer.start(keyRepeatRate);
-    } else
+    for (int i = keys.size() - 1; i >= 0; i--)
     {
-        keyRepeatTimer.stop();
-    }
-}
+        RepeatKey &key = keys[i];
 
-void JoyKeyRepeatHelper::setLastActiveKey(JoyButtonSlot *slot) { lastActiveKey = slot; }
+        if (key.deadline > now)
+            continue;
 
-JoyButtonSlot *JoyKeyRepeatHelper::getLastActiveKey() { return lastActiveKey; }
+        // Key was released in the meantime
+        if (key.button.isNull() || !key.button->getActiveSlots().contains(key.slot))
+        {
+            keys.remove(i);
+            sent = true;
+            continue;
+        }
 
-/*void JoyKeyRepeatHelper::setKeyRepeatDelay(unsigned int repeatDelay)
-{
-    if (repeatDelay > 0)
-    {
-        keyRepeatDelay = repeatDelay;
+        sendKeyRepeatEvent(key.slot);
+        key.deadline += key.rate;
+
+        if (key.deadline <= now)
+            key.deadline += (((now - key.deadline) / key.rate) + 1) * key.rate;
+
+        sent = true;
     }
+
+    if (keys.isEmpty())
+        keyRepeatTimer.stop();
+    else if (sent)
+        scheduleNextRepeat();
 }
 
-unsigned int JoyKeyRepeatHelper::getKeyRepeatDelay()
+void JoyKeyRepeatHelper::repeatKeysEvent()
 {
-    return keyRepeatDelay;
+    BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+    handler->beginOutputBatch();
+    sendDueRepeats();
+    handler->flushOutputBatch();
+
+    // Timer could fire slightly before deadline
+    scheduleNextRepeat();
 }
-*/
 
-void JoyKeyRepeatHelper::setKeyRepeatRate(int repeatRate)
+void JoyKeyRepeatHelper::removeKey(JoyButtonSlot *slot)
 {
-    if (repeatRate > 0)
+    for (int i = 0; i < keys.size(); i++)
     {
-        keyRepeatRate = repeatRate;
+        if (keys.at(i).slot == slot)
+        {
+            keys.remove(i);
+            break;
+        }
     }
 }
 
-int JoyKeyRepeatHelper::getKeyRepeatRate() { return keyRepeatRate; }
+void JoyKeyRepeatHelper::scheduleNextRepeat()
+{
+    if (keys.isEmpty())
+        return;
+
+    qint64 deadline = keys.first().deadline;
+
+    for (const RepeatKey &key : keys)
+        deadline = qMin(deadline, key.deadline);
+
+    keyRepeatTimer.start(static_cast<int>(qMax<qint64>(0, deadline - clock.elapsed())));
+}
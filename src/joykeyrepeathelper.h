@@ -19,33 +19,58 @@
 #ifndef JOYKEYREPEATHELPER_H
 #define JOYKEYREPEATHELPER_H
 
+#include "engineclock.h"
+#include "enginetimer.h"
+
 #include <QObject>
-#include <QTimer>
+#include <QPointer>
+#include <QVector>
 
+class JoyButton;
 class JoyButtonSlot;
 
+/**
+ * @brief Emulates key repeat for keyboard slots held down on a device.
+ *     Every held key has its own absolute deadline and the next one is
+ *     derived from the previous deadline, not from the moment a repeat
+ *     was sent, so cadence does not drift with event loop load. One
+ *     timer is armed for the earliest deadline of all keys. A key stops
+ *     repeating once its slot is no longer active in the button.
+ *
+ * Only used with event handlers whose host does not repeat held keys
+ * itself, which is Windows SendInput. X server and Wayland clients repeat
+ * keys generated through uinput or XTest.
+ */
 class JoyKeyRepeatHelper : public QObject
 {
     Q_OBJECT
 
   public:
     explicit JoyKeyRepeatHelper(QObject *parent = nullptr);
-    QTimer *getRepeatTimer();
 
-    void setLastActiveKey(JoyButtonSlot *slot);
-    JoyButtonSlot *getLastActiveKey();
+    void keyPressed(JoyButton *button, JoyButtonSlot *slot, int repeatDelay, int repeatRate);
+    void clear();
 
-    void setKeyRepeatRate(int repeatRate);
-    int getKeyRepeatRate();
+    void sendDueRepeats();
 
   private slots:
     void repeatKeysEvent();
 
-  protected:
-    QTimer keyRepeatTimer;
-    JoyButtonSlot *lastActiveKey;
-    int keyRepeatDelay;
-    int keyRepeatRate;
+  private:
+    struct RepeatKey
+    {
+        QPointer<JoyButton> button;
+        JoyButtonSlot *slot;
+        qint64 deadline;
+        int rate;
+    };
+
+    void removeKey(JoyButtonSlot *slot);
+    void scheduleNextRepeat();
+
+    EngineTimer keyRepeatTimer;
+    EngineElapsedTimer clock;
+    QVector<RepeatKey> keys;
 };
 
 #endif // JOYKEYREPEATHELPER_H
@@ -37,7 +37,7 @@ JoySensor::JoySensor(JoySensorType type, int originset, SetJoystick *parent_set,
     reset();
 
     m_delay_timer.setSingleShot(true);
-    connect(&m_delay_timer, &QTimer::timeout, this, &JoySensor::delayTimerExpired);
+    connect(&m_delay_timer, &EngineTimer::timeout, this, &JoySensor::delayTimerExpired);
 }
 
 JoySensor::~JoySensor() {}
@@ -52,6 +52,8 @@ JoySensor::~JoySensor() {}
  */
 void JoySensor::joyEvent(float *values, bool ignoresets)
 {
+    ElementCounters::Scope scope(m_counters);
+
     m_current_value[0] = values[0];
     m_current_value[1] = values[1];
     m_current_value[2] = values[2];
@@ -127,6 +129,13 @@ void JoySensor::queuePendingEvent(float *values, bool ignoresets)
     if (m_calibrated)
         applyCalibration();
 
+    m_counters.addReceived();
+
+    if (m_pending_event)
+        m_counters.addCoalesced();
+    else if (m_parent_set != nullptr)
+        m_parent_set->queueDirtySensor(this);
+
     m_pending_event = true;
     m_pending_ignore_sets = ignoresets;
 }
@@ -151,6 +160,8 @@ void JoySensor::activatePendingEvent()
  */
 bool JoySensor::hasPendingEvent() const { return m_pending_event; }
 
+ElementCounters &JoySensor::getCounters() { return m_counters; }
+
 /**
  * @brief Clears a previously queued event
  */
@@ -824,6 +835,7 @@ void JoySensor::determineSensorEvent(JoySensorButton **eventbutton) const
  */
 void JoySensor::createDeskEvent(JoySensorDirection direction, bool ignoresets)
 {
+    ElementCounters::Scope scope(m_counters);
     m_current_direction = direction;
     JoySensorButton *eventbutton[ACTIVE_BUTTON_COUNT] = {nullptr};
     determineSensorEvent(eventbutton);
@@ -19,8 +19,9 @@
 
 #include <QHash>
 #include <QObject>
-#include <QTimer>
 
+#include "elementcounters.h"
+#include "enginetimer.h"
 #include "joysensordirection.h"
 #include "joysensortype.h"
 #include "pt1filter.h"
@@ -49,6 +50,7 @@ class JoySensor : public QObject
     void activatePendingEvent();
     bool hasPendingEvent() const;
     void clearPendingEvent();
+    ElementCounters &getCounters();
 
     void copyAssignments(JoySensor *dest_sensor);
     bool hasSlotsAssigned() const;
@@ -151,9 +153,10 @@ class JoySensor : public QObject
 
     int m_originset;
     QString m_sensor_name;
-    QTimer m_delay_timer;
+    EngineTimer m_delay_timer;
 
     JoySensorDirection m_current_direction;
     SetJoystick *m_parent_set;
     QHash<JoySensorDirection, JoySensorButton *> m_buttons;
+    ElementCounters m_counters;
 };
@@ -44,6 +44,19 @@ Joystick::Joystick(SDL_Joystick *joyhandle, int deviceIndex, AntiMicroSettings *
     INFO() << "Created new Joystick:\n" << getDescription();
 }
 
+/**
+ * @brief Constructor for devices without SDL handle. Sets are not created
+ *     here, because element counts come from the subclass.
+ */
+Joystick::Joystick(SDL_JoystickID instanceID, int deviceIndex, AntiMicroSettings *settings, QObject *parent)
+    : InputDevice(nullptr, deviceIndex, settings, parent)
+    , m_joyhandle(nullptr)
+    , controller(nullptr)
+    , joystickID(instanceID)
+    , counterUniques(0)
+{
+}
+
 QString Joystick::getXmlName() const { return GlobalVariables::Joystick::xmlName; }
 
 QString Joystick::getName() { return QString(tr("Joystick")).append(" ").append(QString::number(getRealJoyNumber())); }
@@ -61,6 +61,9 @@ class Joystick : public InputDevice
     SDL_Joystick *getJoyhandle() const;
     virtual QString getXmlName() const override;
 
+  protected:
+    explicit Joystick(SDL_JoystickID instanceID, int deviceIndex, AntiMicroSettings *settings, QObject *parent);
+
   private:
     SDL_Joystick *m_joyhandle;
     SDL_GameController *controller;
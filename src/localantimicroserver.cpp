@@ -19,15 +19,24 @@
 #include "localantimicroserver.h"
 
 #include "common.h"
+#include "localcontrolprotocol.h"
 
 #include <QDebug>
 #include <QLocalServer>
 #include <QLocalSocket>
 
+// Longest accepted request line in bytes
+static const qint64 MAX_MESSAGE_SIZE = 65536;
+
 LocalAntiMicroServer::LocalAntiMicroServer(QObject *parent)
     : QObject(parent)
 {
     localServer = new QLocalServer(this);
+    protocol = new LocalControlProtocol(this);
+
+    connect(protocol, &LocalControlProtocol::loadProfileRequested, this, &LocalAntiMicroServer::loadProfileRequested);
+    connect(protocol, &LocalControlProtocol::unloadProfileRequested, this, &LocalAntiMicroServer::unloadProfileRequested);
+    connect(protocol, &LocalControlProtocol::showRequested, this, &LocalAntiMicroServer::showHiddenWindow);
 }
 
 void LocalAntiMicroServer::startLocalServer()
@@ -71,9 +80,10 @@ void LocalAntiMicroServer::handleOutsideConnection()
         if (socket != nullptr)
         {
             qDebug() << "There is next pending connection: " << socket->socketDescriptor();
+            connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { readMessages(socket); });
             connect(socket, &QLocalSocket::disconnected, this, &LocalAntiMicroServer::handleSocketDisconnect);
             connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
-            checkForMessages(socket);
+            readMessages(socket);
         } else
         {
             qDebug() << "There isn't next pending connection: ";
@@ -84,26 +94,70 @@ void LocalAntiMicroServer::handleOutsideConnection()
     }
 }
 
-void LocalAntiMicroServer::handleSocketDisconnect() { emit clientdisconnect(); }
+/**
+ * @brief Other instances change settings before they disconnect, so they
+ *     are reloaded. Protocol clients make changes through requests instead.
+ */
+void LocalAntiMicroServer::handleSocketDisconnect()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+
+    if (socket == nullptr)
+    {
+        emit clientdisconnect();
+        return;
+    }
+
+    readMessages(socket);
+
+    bool controlClient = socket->property("controlClient").toBool();
+    protocol->removeClient(socket);
+
+    if (!controlClient)
+        emit clientdisconnect();
+}
 
 void LocalAntiMicroServer::close() { localServer->close(); }
 
-void LocalAntiMicroServer::checkForMessages(QLocalSocket *socket)
+void LocalAntiMicroServer::readMessages(QLocalSocket *socket)
 {
-    DEBUG() << "Waiting for message";
-    socket->waitForConnected(50);
-    bool result = socket->waitForReadyRead(200);
-    DEBUG() << "Waiting for message ended with result: " << (result ? "true" : "false");
-    if (result)
+    while (socket->canReadLine())
     {
-        QString msg = QString(socket->readLine(30));
-        DEBUG() << "Received external message:" << msg;
-        if (msg == PadderCommon::unhideCommand)
+        QByteArray line = socket->readLine().trimmed();
+
+        if (line.startsWith('{'))
+        {
+            socket->setProperty("controlClient", true);
+            protocol->handleMessage(socket, line);
+        } else if (line == PadderCommon::unhideCommand.toUtf8())
         {
             DEBUG() << "Showing hidden window because of external request";
             emit showHiddenWindow();
+        } else if (!line.isEmpty())
+        {
+            DEBUG() << "Received unknown external message:" << QString::fromUtf8(line);
         }
     }
+
+    // Other instances send unhide command without line end
+    if (socket->peek(PadderCommon::unhideCommand.size() + 1) == PadderCommon::unhideCommand.toUtf8())
+    {
+        socket->readAll();
+        DEBUG() << "Showing hidden window because of external request";
+        emit showHiddenWindow();
+    } else if (socket->bytesAvailable() > MAX_MESSAGE_SIZE)
+    {
+        qWarning() << "Message on local socket is too long, closing connection";
+        socket->abort();
+    }
 }
 
 QLocalServer *LocalAntiMicroServer::getLocalServer() const { return localServer; }
+
+void LocalAntiMicroServer::setDevices(QMap<SDL_JoystickID, InputDevice *> *joysticks) { protocol->setDevices(joysticks); }
+
+void LocalAntiMicroServer::addDevice(InputDevice *device) { protocol->addDevice(device); }
+
+void LocalAntiMicroServer::removeDevice(SDL_JoystickID deviceID) { protocol->removeDevice(deviceID); }
+
+void LocalAntiMicroServer::updateDevice(int index, InputDevice *device) { protocol->updateDevice(index, device); }
@@ -20,12 +20,19 @@
 #define LOCALANTIMICROSERVER_H
 
 #include <QLocalSocket>
+#include <QMap>
 #include <QObject>
 
+#include <SDL2/SDL_joystick.h>
+
+class InputDevice;
+class LocalControlProtocol;
 class QLocalServer;
 
 /**
  * @brief Class used for checking presence of other AntiMicroX instances and communicating with them.
+ *
+ * Lines starting with '{' are requests of LocalControlProtocol, other instances only send unhide command.
  */
 class LocalAntiMicroServer : public QObject
 {
@@ -39,17 +46,24 @@ class LocalAntiMicroServer : public QObject
   signals:
     void clientdisconnect();
     void showHiddenWindow();
+    void loadProfileRequested(InputDevice *device, QString fileLocation);
+    void unloadProfileRequested(InputDevice *device);
 
   public slots:
     void startLocalServer();
     void handleOutsideConnection();
     void handleSocketDisconnect();
     void close();
+    void setDevices(QMap<SDL_JoystickID, InputDevice *> *joysticks);
+    void addDevice(InputDevice *device);
+    void removeDevice(SDL_JoystickID deviceID);
+    void updateDevice(int index, InputDevice *device);
 
   private:
-    void checkForMessages(QLocalSocket *socket);
+    void readMessages(QLocalSocket *socket);
 
     QLocalServer *localServer;
+    LocalControlProtocol *protocol;
 };
 
 #endif // LOCALANTIMICROSERVER_H
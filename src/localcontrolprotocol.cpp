@@ -0,0 +1,495 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "localcontrolprotocol.h"
+
+#include "common.h"
+#include "globalvariables.h"
+#include "inputdevice.h"
+#include "joyaxis.h"
+#include "joybuttontypes/joybutton.h"
+#include "joydpad.h"
+#include "setjoystick.h"
+
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLocalSocket>
+#include <QMutexLocker>
+
+#include <ctime>
+
+// Limits for interval of state streams in ms. Every sample holds
+// inputDaemonMutex, so keep input thread from waiting too often.
+static const int DEFAULT_SAMPLE_INTERVAL = 50;
+static const int MIN_SAMPLE_INTERVAL = 20;
+static const int MAX_SAMPLE_INTERVAL = 10000;
+
+static QJsonObject errorResponse(const QString &error)
+{
+    QJsonObject response;
+    response.insert("ok", false);
+    response.insert("error", error);
+    return response;
+}
+
+static QJsonObject counterValues(const ElementCounters::Values &values)
+{
+    QJsonObject result;
+    result.insert("received", static_cast<qint64>(values.received));
+    result.insert("coalesced", static_cast<qint64>(values.coalesced));
+    result.insert("output", static_cast<qint64>(values.output));
+    result.insert("processingUs", static_cast<qint64>(values.processingNs / 1000));
+    return result;
+}
+
+LocalControlProtocol::Client::Client()
+    : subscribedAll(false)
+    , interval(DEFAULT_SAMPLE_INTERVAL)
+    , lastSample(0)
+{
+}
+
+LocalControlProtocol::LocalControlProtocol(QObject *parent)
+    : QObject(parent)
+    , bytesSent(0)
+{
+    flushTimer.setSingleShot(true);
+    flushTimer.setInterval(0);
+    connect(&flushTimer, &QTimer::timeout, this, &LocalControlProtocol::flushPending);
+    connect(&sampleTimer, &QTimer::timeout, this, &LocalControlProtocol::sampleSubscriptions);
+
+    uptime.start();
+}
+
+/**
+ * @brief Take over all devices. Called before input thread runs or once
+ *     InputDaemon reports a full refresh.
+ */
+void LocalControlProtocol::setDevices(QMap<SDL_JoystickID, InputDevice *> *joysticks) { m_devices = *joysticks; }
+
+void LocalControlProtocol::addDevice(InputDevice *device) { m_devices.insert(device->getSDLJoystickID(), device); }
+
+void LocalControlProtocol::removeDevice(SDL_JoystickID deviceID) { m_devices.remove(deviceID); }
+
+/**
+ * @brief Device at SDL index was reopened as game controller under new
+ *     instance id, drop the old one like MainWindow drops its tab.
+ */
+void LocalControlProtocol::updateDevice(int index, InputDevice *device)
+{
+    for (auto iter = m_devices.begin(); iter != m_devices.end();)
+    {
+        if (iter.value()->getJoyNumber() == index)
+            iter = m_devices.erase(iter);
+        else
+            ++iter;
+    }
+
+    addDevice(device);
+}
+
+/**
+ * @brief Handle one request line. Response is queued, not written.
+ */
+void LocalControlProtocol::handleMessage(QLocalSocket *socket, const QByteArray &line)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    Client &client = clients[socket];
+    QJsonParseError parseError;
+    QJsonDocument document = QJsonDocument::fromJson(line, &parseError);
+    QJsonObject response;
+
+    if (!document.isObject())
+    {
+        response = errorResponse(QString("Invalid message: %1").arg(parseError.errorString()));
+    } else
+    {
+        QJsonObject request = document.object();
+        response = runCommand(client, request.value("cmd").toString(), request);
+
+        if (request.contains("id"))
+            response.insert("id", request.value("id"));
+    }
+
+    queueMessage(socket, response);
+    requestTime.process(timer.nsecsElapsed() / 1000.0);
+}
+
+void LocalControlProtocol::removeClient(QLocalSocket *socket)
+{
+    clients.remove(socket);
+    updateSampleTimer();
+}
+
+void LocalControlProtocol::flushPending()
+{
+    for (auto iter = clients.begin(); iter != clients.end(); ++iter)
+    {
+        Client &client = iter.value();
+
+        if (client.pending.isEmpty())
+            continue;
+
+        if (iter.key()->state() == QLocalSocket::ConnectedState)
+        {
+            iter.key()->write(client.pending);
+            bytesSent += client.pending.size();
+        }
+
+        client.pending.clear();
+    }
+}
+
+/**
+ * @brief Send state of subscribed devices which changed since last sample.
+ *     Changes in between are coalesced, client only sees latest state.
+ */
+void LocalControlProtocol::sampleSubscriptions()
+{
+    // Devices and their elements are changed by the input thread
+    QMutexLocker locker(&PadderCommon::inputDaemonMutex);
+    qint64 now = uptime.elapsed();
+
+    for (auto iter = clients.begin(); iter != clients.end(); ++iter)
+    {
+        Client &client = iter.value();
+
+        if ((client.subscriptions.isEmpty() && !client.subscribedAll) || (now - client.lastSample < client.interval))
+            continue;
+
+        client.lastSample = now;
+
+        if (client.subscribedAll)
+        {
+            for (auto device = m_devices.constBegin(); device != m_devices.constEnd(); ++device)
+            {
+                if (!client.subscriptions.contains(device.key()))
+                    client.subscriptions.insert(device.key(), QJsonObject());
+            }
+        }
+
+        for (auto sub = client.subscriptions.begin(); sub != client.subscriptions.end();)
+        {
+            InputDevice *device = m_devices.value(sub.key(), nullptr);
+
+            if (device == nullptr)
+            {
+                QJsonObject event;
+                event.insert("event", "removed");
+                event.insert("instanceId", sub.key());
+                queueMessage(iter.key(), event);
+                sub = client.subscriptions.erase(sub);
+                continue;
+            }
+
+            QJsonObject state = deviceState(device);
+
+            if (state != sub.value())
+            {
+                sub.value() = state;
+                state.insert("event", "state");
+                queueMessage(iter.key(), state);
+            }
+
+            ++sub;
+        }
+    }
+}
+
+QJsonObject LocalControlProtocol::runCommand(Client &client, const QString &cmd, const QJsonObject &request)
+{
+    QJsonObject response;
+    response.insert("ok", true);
+
+    if (cmd == "hello")
+    {
+        response.insert("version", PROTOCOL_VERSION);
+        response.insert("program", PadderCommon::programVersion);
+        return response;
+    } else if (cmd == "show")
+    {
+        emit showRequested();
+        return response;
+    }
+
+    bool found = false;
+    QList<InputDevice *> devices;
+
+    {
+        // Devices and their elements are changed by the input thread. Lock
+        // is released before signals are emitted, their slots may wait for
+        // the input thread.
+        QMutexLocker locker(&PadderCommon::inputDaemonMutex);
+        devices = selectDevices(request, found);
+
+        if (!found)
+            return errorResponse("Unknown device");
+
+        if (cmd == "devices")
+        {
+            QJsonArray list;
+
+            for (InputDevice *device : devices)
+                list.append(deviceInfo(device));
+
+            response.insert("devices", list);
+            return response;
+        } else if (cmd == "state")
+        {
+            QJsonArray list;
+
+            for (InputDevice *device : devices)
+                list.append(deviceState(device));
+
+            response.insert("states", list);
+            return response;
+        } else if (cmd == "counters")
+        {
+            QJsonArray list;
+
+            for (InputDevice *device : devices)
+                list.append(deviceCounters(device));
+
+            response.insert("counters", counters());
+            response.insert("devices", list);
+            return response;
+        }
+    }
+
+    if (cmd == "loadProfile")
+    {
+        QString fileLocation = request.value("file").toString();
+
+        if (!QFileInfo::exists(fileLocation))
+            return errorResponse("Profile does not exist");
+
+        for (InputDevice *device : devices)
+            emit loadProfileRequested(device, fileLocation);
+    } else if (cmd == "unloadProfile")
+    {
+        for (InputDevice *device : devices)
+            emit unloadProfileRequested(device);
+    } else if (cmd == "setSet")
+    {
+        int setNumber = request.value("set").toInt();
+
+        if ((setNumber < 1) || (setNumber > GlobalVariables::InputDevice::NUMBER_JOYSETS))
+            return errorResponse("Invalid set number");
+
+        for (InputDevice *device : devices)
+            QMetaObject::invokeMethod(device, "setActiveSetNumber", Q_ARG(int, setNumber - 1));
+    } else if (cmd == "subscribe")
+    {
+        client.interval =
+            qBound(MIN_SAMPLE_INTERVAL, request.value("interval").toInt(DEFAULT_SAMPLE_INTERVAL), MAX_SAMPLE_INTERVAL);
+
+        if (!request.contains("device"))
+            client.subscribedAll = true;
+
+        for (InputDevice *device : devices)
+        {
+            if (!client.subscriptions.contains(device->getSDLJoystickID()))
+                client.subscriptions.insert(device->getSDLJoystickID(), QJsonObject());
+        }
+
+        updateSampleTimer();
+    } else if (cmd == "unsubscribe")
+    {
+        if (!request.contains("device"))
+            client.subscribedAll = false;
+
+        for (InputDevice *device : devices)
+            client.subscriptions.remove(device->getSDLJoystickID());
+
+        updateSampleTimer();
+    } else
+    {
+        return errorResponse(QString("Unknown command: %1").arg(cmd));
+    }
+
+    return response;
+}
+
+/**
+ * @brief Devices selected by "device" member of request. Number is
+ *     controller number, string is compared with name and identifiers.
+ */
+QList<InputDevice *> LocalControlProtocol::selectDevices(const QJsonObject &request, bool &found)
+{
+    QList<InputDevice *> result;
+    QJsonValue selector = request.value("device");
+
+    for (InputDevice *device : m_devices)
+    {
+        if (selector.isUndefined())
+        {
+            result.append(device);
+        } else if (selector.isDouble())
+        {
+            if (device->getRealJoyNumber() == selector.toInt())
+                result.append(device);
+        } else
+        {
+            QString text = selector.toString();
+
+            if ((text == device->getSDLName()) || (text == device->getStringIdentifier()) ||
+                (text == device->getGUIDString()) || (text == device->getUniqueIDString()))
+                result.append(device);
+        }
+    }
+
+    found = selector.isUndefined() || !result.isEmpty();
+    return result;
+}
+
+QJsonObject LocalControlProtocol::deviceInfo(InputDevice *device)
+{
+    QJsonObject info;
+    info.insert("device", device->getRealJoyNumber());
+    info.insert("instanceId", device->getSDLJoystickID());
+    info.insert("name", device->getSDLName());
+    info.insert("type", device->getXmlName());
+    info.insert("guid", device->getGUIDString());
+    info.insert("uniqueId", device->getUniqueIDString());
+    info.insert("profileName", device->getProfileName());
+    info.insert("set", device->getActiveSetNumber() + 1);
+    info.insert("buttons", device->getNumberButtons());
+    info.insert("axes", device->getNumberAxes());
+    info.insert("hats", device->getNumberHats());
+    return info;
+}
+
+/**
+ * @brief Values of elements in active set. Read from the thread of the
+ *     server while holding inputDaemonMutex, so the input thread does not
+ *     change the device during sampling.
+ */
+QJsonObject LocalControlProtocol::deviceState(InputDevice *device)
+{
+    SetJoystick *set = device->getActiveSetJoystick();
+    QJsonArray axes;
+    QJsonArray pressedButtons;
+    QJsonArray hats;
+
+    for (int i = 0; i < device->getNumberAxes(); i++)
+    {
+        JoyAxis *axis = set->getJoyAxis(i);
+        axes.append((axis != nullptr) ? axis->getCurrentRawValue() : 0);
+    }
+
+    for (int i = 0; i < device->getNumberButtons(); i++)
+    {
+        JoyButton *button = set->getJoyButton(i);
+
+        if ((button != nullptr) && button->getButtonState())
+            pressedButtons.append(i);
+    }
+
+    for (int i = 0; i < device->getNumberHats(); i++)
+    {
+        JoyDPad *dpad = set->getJoyDPad(i);
+        hats.append((dpad != nullptr) ? dpad->getCurrentDirection() : 0);
+    }
+
+    QJsonObject state;
+    state.insert("device", device->getRealJoyNumber());
+    state.insert("instanceId", device->getSDLJoystickID());
+    state.insert("set", device->getActiveSetNumber() + 1);
+    state.insert("axes", axes);
+    state.insert("pressedButtons", pressedButtons);
+    state.insert("hats", hats);
+    return state;
+}
+
+/**
+ * @brief Activity counters of device and its elements since device was
+ *     opened. Elements without any activity are left out.
+ */
+QJsonObject LocalControlProtocol::deviceCounters(InputDevice *device)
+{
+    QList<ElementCountersEntry> entries = device->collectElementCounters();
+    QJsonObject result = counterValues(device->getCounterTotals(entries));
+    QJsonArray elements;
+
+    for (const ElementCountersEntry &entry : entries)
+    {
+        if ((entry.values.received == 0) && (entry.values.output == 0) && (entry.values.processingNs == 0))
+            continue;
+
+        QJsonObject element = counterValues(entry.values);
+        element.insert("element", entry.element);
+        elements.append(element);
+    }
+
+    result.insert("device", device->getRealJoyNumber());
+    result.insert("instanceId", device->getSDLJoystickID());
+    result.insert("elements", elements);
+    return result;
+}
+
+QJsonObject LocalControlProtocol::counters()
+{
+    QJsonObject result;
+    result.insert("uptimeMs", uptime.elapsed());
+    // Processor time used by program. MSVC runtime returns wall time instead
+    result.insert("cpuTimeMs", static_cast<qint64>(std::clock() * 1000.0 / CLOCKS_PER_SEC));
+    result.insert("clients", clients.size());
+    result.insert("requests", static_cast<qint64>(requestTime.getCount()));
+    result.insert("requestTimeUs", requestTime.getMean());
+    result.insert("bytesSent", static_cast<qint64>(bytesSent));
+    result.insert("gamepadPollMs", GlobalVariables::JoyButton::gamepadRefreshRate);
+    result.insert("mouseRefreshMs", GlobalVariables::JoyButton::mouseRefreshRate);
+    return result;
+}
+
+void LocalControlProtocol::queueMessage(QLocalSocket *socket, const QJsonObject &message)
+{
+    auto iter = clients.find(socket);
+
+    if (iter == clients.end())
+        return;
+
+    iter.value().pending.append(QJsonDocument(message).toJson(QJsonDocument::Compact)).append('\n');
+
+    if (!flushTimer.isActive())
+        flushTimer.start();
+}
+
+/**
+ * @brief Sample as often as the most demanding subscriber asks for.
+ */
+void LocalControlProtocol::updateSampleTimer()
+{
+    int interval = 0;
+
+    for (const Client &client : clients)
+    {
+        if (!client.subscriptions.isEmpty() || client.subscribedAll)
+            interval = (interval == 0) ? client.interval : qMin(interval, client.interval);
+    }
+
+    if (interval == 0)
+    {
+        sampleTimer.stop();
+    } else if (!sampleTimer.isActive() || (sampleTimer.interval() != interval))
+    {
+        sampleTimer.start(interval);
+    }
+}
@@ -0,0 +1,104 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOCALCONTROLPROTOCOL_H
+#define LOCALCONTROLPROTOCOL_H
+
+#include "statisticsestimator.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QMap>
+#include <QObject>
+#include <QTimer>
+
+#include <SDL2/SDL_joystick.h>
+
+class InputDevice;
+class QLocalSocket;
+
+/**
+ * @brief Line delimited JSON protocol spoken on the local socket. Every
+ *     request is one JSON object with "cmd" and optional "id" on its own
+ *     line, every response repeats the "id". Responses and state events
+ *     are collected per client and written once control returns to the
+ *     event loop, so a client never blocks the server.
+ *
+ *     Commands: hello, devices, state, loadProfile, unloadProfile, setSet,
+ *     subscribe, unsubscribe, counters, show. Devices are selected with
+ *     "device" holding controller number (starting from 1), name, GUID or
+ *     unique ID. Without "device" a command applies to all devices.
+ */
+class LocalControlProtocol : public QObject
+{
+    Q_OBJECT
+
+  public:
+    static const int PROTOCOL_VERSION = 1;
+
+    explicit LocalControlProtocol(QObject *parent = nullptr);
+
+    void setDevices(QMap<SDL_JoystickID, InputDevice *> *joysticks);
+    void addDevice(InputDevice *device);
+    void removeDevice(SDL_JoystickID deviceID);
+    void updateDevice(int index, InputDevice *device);
+    void handleMessage(QLocalSocket *socket, const QByteArray &line);
+    void removeClient(QLocalSocket *socket);
+
+  signals:
+    void loadProfileRequested(InputDevice *device, QString fileLocation);
+    void unloadProfileRequested(InputDevice *device);
+    void showRequested();
+
+  private slots:
+    void flushPending();
+    void sampleSubscriptions();
+
+  private:
+    struct Client
+    {
+        Client();
+
+        QByteArray pending;
+        QHash<SDL_JoystickID, QJsonObject> subscriptions;
+        bool subscribedAll;
+        int interval;
+        qint64 lastSample;
+    };
+
+    QJsonObject runCommand(Client &client, const QString &cmd, const QJsonObject &request);
+    QList<InputDevice *> selectDevices(const QJsonObject &request, bool &found);
+    QJsonObject deviceInfo(InputDevice *device);
+    QJsonObject deviceState(InputDevice *device);
+    QJsonObject deviceCounters(InputDevice *device);
+    QJsonObject counters();
+    void queueMessage(QLocalSocket *socket, const QJsonObject &message);
+    void updateSampleTimer();
+
+    // Copy of device map of InputDaemon kept in thread of the server.
+    // The input thread changes its own map without locking.
+    QMap<SDL_JoystickID, InputDevice *> m_devices;
+    QHash<QLocalSocket *, Client> clients;
+    QTimer flushTimer;
+    QTimer sampleTimer;
+    QElapsedTimer uptime;
+    StatisticsEstimator requestTime;
+    quint64 bytesSent;
+};
+
+#endif // LOCALCONTROLPROTOCOL_H
@@ -22,8 +22,10 @@
 #include "autoprofileinfo.h"
 #include "commandlineutility.h"
 #include "common.h"
+#include "headlessdaemon.h"
 #include "inputdaemon.h"
 #include "inputdevice.h"
+#include "inputtracereplayer.h"
 #include "joybuttonslot.h"
 #include "joysensordirection.h"
 #include "joysensortype.h"
@@ -31,14 +33,17 @@
 #include "mainwindow.h"
 #include "setjoystick.h"
 #include "simplekeygrabberbutton.h"
+#include "startuptrace.h"
 
 #include "eventhandlerfactory.h"
+#include "eventhandlers/outputsink.h"
 #include "logger.h"
 
 #include <QApplication>
 #include <QDebug>
 #include <QDir>
 #include <QException>
+#include <QInputMethod>
 #include <QLibraryInfo>
 #include <QLocalSocket>
 #include <QMainWindow>
@@ -46,6 +51,7 @@
 #include <QMapIterator>
 #include <QMessageBox>
 #include <QPointer>
+#include <QScopedPointer>
 #include <QSettings>
 #include <QStandardPaths>
 #include <QTextStream>
@@ -227,9 +233,16 @@ void importLegacySettingsIfExist()
 
 int main(int argc, char *argv[])
 {
+    StartupTrace::start();
     qInstallMessageHandler(Logger::loggerMessageHandler);
 
-    QApplication antimicrox(argc, argv);
+    // Headless service does not create any widget. QGuiApplication is still
+    // needed for screen geometry and cursor position used by mouse emulation.
+    const bool headless = CommandLineUtility::hasHeadlessArgument(argc, argv);
+    QScopedPointer<QGuiApplication> application(headless ? new QGuiApplication(argc, argv)
+                                                         : new QApplication(argc, argv));
+    QGuiApplication &antimicrox = *application;
+    StartupTrace::mark("application created");
     QCoreApplication::setApplicationName("antimicrox");
     QCoreApplication::setApplicationVersion(PadderCommon::programVersion);
 
@@ -269,6 +282,8 @@ int main(int argc, char *argv[])
     }
     settings.importFromCommandLine(cmdutility);
     settings.applySettingsToLogger(cmdutility, appLogger);
+    StartupTrace::setEnabled(cmdutility.isStartupTraceRequested());
+    StartupTrace::mark("settings loaded");
 
     Q_INIT_RESOURCE(resources);
 
@@ -322,6 +337,16 @@ int main(int argc, char *argv[])
         // An instance of this program is already running.
         // Save app config and exit.
         PRINT_STDOUT() << "AntiMicroX is already running.\n";
+
+        if (headless)
+        {
+            PRINT_STDERR() << "Use running instance without --headless to change its profiles.\n";
+            delete joysticks;
+            joysticks = nullptr;
+            delete appLogger;
+            return EXIT_FAILURE;
+        }
+
         QPointer<InputDaemon> joypad_worker = new InputDaemon(joysticks, &settings, false);
         MainWindow mainWindow(joysticks, &cmdutility, &settings, false);
         mainWindow.fillButtons();
@@ -380,7 +405,8 @@ int main(int argc, char *argv[])
     localServer->startLocalServer();
 
 #if defined(Q_OS_WIN)
-    qApp->setStyle("fusion");
+    if (!headless)
+        QApplication::setStyle("fusion");
 #endif
 
     antimicrox.setQuitOnLastWindowClosed(false);
@@ -479,6 +505,7 @@ int main(int argc, char *argv[])
     bool status = true;
     QString eventGeneratorIdentifier = QString();
     AntKeyMapper *keyMapper = nullptr;
+    RecordEventHandler::setOutputFileName(cmdutility.getOutputRecordFile());
     EventHandlerFactory *factory = EventHandlerFactory::getInstance(cmdutility.getEventGenerator());
 
     if (!factory)
@@ -495,7 +522,9 @@ int main(int argc, char *argv[])
 #if defined(WITH_UINPUT) && defined(WITH_XTEST)
 
     // Use fallback event handler.
-    if (!status && cmdutility.getEventGenerator() != EventHandlerFactory::fallBackIdentifier())
+    // Recording run must not fall back to sending events to the system.
+    if (!status && (cmdutility.getEventGenerator() != EventHandlerFactory::fallBackIdentifier()) &&
+        (cmdutility.getEventGenerator() != "record"))
     {
         QString eventDisplayName = EventHandlerFactory::handlerDisplayName(EventHandlerFactory::fallBackIdentifier());
         qInfo() << QObject::tr("Attempting to use fallback option %1 for event generation.").arg(eventDisplayName);
@@ -551,54 +580,148 @@ int main(int argc, char *argv[])
         return EXIT_FAILURE;
     }
     qInfo() << QObject::tr("Using %1 as the event generator.").arg(factory->handler()->getName());
+    StartupTrace::mark("event generator initialized");
+
+    if (cmdutility.isPerControllerOutputRequested() && !OutputSink::setPerDeviceOutput(true))
+    {
+        qWarning() << QObject::tr("Event generator %1 does not support separate output devices for controllers.")
+                          .arg(factory->handler()->getName());
+    }
+
+    if (cmdutility.isVirtualGamepadRequested() && !factory->handler()->setVirtualGamepadOutput(true))
+    {
+        qWarning() << QObject::tr("Event generator %1 does not support virtual gamepads.")
+                          .arg(factory->handler()->getName());
+    }
+
+    // Key codes stored in slots depend on keyboard layout.
+    QObject::connect(QGuiApplication::inputMethod(), &QInputMethod::localeChanged,
+                     []() { BaseEventHandler::invalidateResolvedSlots(); });
 #ifdef Q_OS_WIN
     PadderCommon::log_system_config(); // workaround for missing windows logs
 #endif
 
     QPointer<InputDaemon> joypad_worker = new InputDaemon(joysticks, &settings);
+    StartupTrace::mark("input devices opened");
+
+    // Input thread is not running yet, server copies devices and follows
+    // later changes through signals
+    localServer->setDevices(joysticks);
+    QObject::connect(joypad_worker.data(), &InputDaemon::joysticksRefreshed, localServer,
+                     &LocalAntiMicroServer::setDevices);
+    QObject::connect(joypad_worker.data(), &InputDaemon::deviceAdded, localServer, &LocalAntiMicroServer::addDevice);
+    QObject::connect(joypad_worker.data(), &InputDaemon::deviceRemoved, localServer, &LocalAntiMicroServer::removeDevice);
+    QObject::connect(joypad_worker.data(), &InputDaemon::deviceUpdated, localServer, &LocalAntiMicroServer::updateDevice);
+
+    joypad_worker->setKeepAxisPeaks(cmdutility.isKeepAxisPeaksRequested());
+    joypad_worker->setAdaptivePolling(cmdutility.isAdaptivePollingRequested());
+
+    if (!cmdutility.getInputRecordFile().isEmpty())
+        joypad_worker->startInputRecording(cmdutility.getInputRecordFile());
+
+    // Start processing input before GUI is built. Last profiles are loaded
+    // right after, so controllers work while the main window is created.
     inputEventThread = new QThread();
     inputEventThread->setObjectName("inputEventThread");
 
-    MainWindow *mainWindow = new MainWindow(joysticks, &cmdutility, &settings);
+    AppLaunchHelper mainAppHelper(&settings, true);
+    mainAppHelper.initRunMethods();
+    mainAppHelper.changeMouseThread(inputEventThread);
 
-    mainWindow->setAppTranslator(&qtTranslator);
-    mainWindow->setTranslator(&myappTranslator);
+    joypad_worker->startWorker();
 
-    AppLaunchHelper mainAppHelper(&settings, mainWindow->getGraphicalStatus());
+    joypad_worker->moveToThread(inputEventThread);
+    PadderCommon::mouseHelperObj.trackScreens();
+    PadderCommon::mouseHelperObj.moveToThread(inputEventThread);
+    inputEventThread->start(QThread::HighPriority);
+    StartupTrace::mark("input thread started");
 
-    QObject::connect(mainWindow, &MainWindow::joystickRefreshRequested, joypad_worker.data(), &InputDaemon::refresh);
-    QObject::connect(joypad_worker.data(), &InputDaemon::joystickRefreshed, mainWindow, &MainWindow::fillButtonsID);
-    QObject::connect(joypad_worker.data(), &InputDaemon::joysticksRefreshed, mainWindow, &MainWindow::fillButtonsMap);
+    MainWindow *mainWindow = nullptr;
+    HeadlessDaemon *headlessDaemon = nullptr;
 
-    QObject::connect(&antimicrox, &QApplication::aboutToQuit, localServer, &LocalAntiMicroServer::close);
-    QObject::connect(&antimicrox, &QApplication::aboutToQuit, mainWindow, &MainWindow::saveAppConfig);
-    QObject::connect(&antimicrox, &QApplication::aboutToQuit, mainWindow, &MainWindow::removeJoyTabs);
-    QObject::connect(&antimicrox, &QApplication::aboutToQuit, &mainAppHelper, &AppLaunchHelper::revertMouseThread);
-    QObject::connect(&antimicrox, &QApplication::aboutToQuit, joypad_worker.data(), &InputDaemon::quit);
-    QObject::connect(&antimicrox, &QApplication::aboutToQuit, joypad_worker.data(), &InputDaemon::deleteLater);
+    if (headless)
+    {
+        headlessDaemon = new HeadlessDaemon(joysticks, &cmdutility, &settings);
 
-    QObject::connect(localServer, &LocalAntiMicroServer::showHiddenWindow, mainWindow, &MainWindow::show);
-    QObject::connect(localServer, &LocalAntiMicroServer::clientdisconnect, mainWindow,
-                     &MainWindow::handleInstanceDisconnect);
-    QObject::connect(mainWindow, &MainWindow::mappingUpdated, joypad_worker.data(), &InputDaemon::refreshMapping);
-    QObject::connect(joypad_worker.data(), &InputDaemon::deviceUpdated, mainWindow, &MainWindow::testMappingUpdateNow);
+        QObject::connect(&antimicrox, &QApplication::aboutToQuit, localServer, &LocalAntiMicroServer::close);
+        QObject::connect(&antimicrox, &QApplication::aboutToQuit, headlessDaemon, &HeadlessDaemon::removeDevices);
+        QObject::connect(&antimicrox, &QApplication::aboutToQuit, &mainAppHelper, &AppLaunchHelper::revertMouseThread);
+        QObject::connect(&antimicrox, &QApplication::aboutToQuit, joypad_worker.data(), &InputDaemon::quit);
+        QObject::connect(&antimicrox, &QApplication::aboutToQuit, joypad_worker.data(), &InputDaemon::deleteLater);
+
+        QObject::connect(localServer, &LocalAntiMicroServer::clientdisconnect, headlessDaemon,
+                         &HeadlessDaemon::handleInstanceDisconnect);
+        QObject::connect(localServer, &LocalAntiMicroServer::loadProfileRequested, headlessDaemon,
+                         &HeadlessDaemon::loadDeviceProfile);
+        QObject::connect(localServer, &LocalAntiMicroServer::unloadProfileRequested, headlessDaemon,
+                         &HeadlessDaemon::unloadDeviceProfile);
+        QObject::connect(joypad_worker.data(), &InputDaemon::deviceRemoved, headlessDaemon, &HeadlessDaemon::removeDevice);
+        QObject::connect(joypad_worker.data(), &InputDaemon::deviceAdded, headlessDaemon, &HeadlessDaemon::addDevice);
+
+        QTimer::singleShot(0, headlessDaemon, &HeadlessDaemon::loadDeviceProfiles);
+        QTimer::singleShot(0, []() {
+            StartupTrace::mark("profiles loaded");
+            StartupTrace::dump();
+        });
+    } else
+    {
+        QHash<SDL_JoystickID, QString> preloadedProfiles = HeadlessDaemon::preloadLastProfiles(joysticks, &settings);
+        StartupTrace::mark("profiles loaded");
 
-    QObject::connect(joypad_worker.data(), &InputDaemon::deviceRemoved, mainWindow, &MainWindow::removeJoyTab);
-    QObject::connect(joypad_worker.data(), &InputDaemon::deviceAdded, mainWindow, &MainWindow::addJoyTab);
+        mainWindow = new MainWindow(joysticks, &cmdutility, &settings);
+        mainWindow->setPreloadedProfiles(preloadedProfiles);
+        StartupTrace::mark("main window created");
 
-    mainAppHelper.initRunMethods();
+        mainWindow->setAppTranslator(&qtTranslator);
+        mainWindow->setTranslator(&myappTranslator);
 
-    QTimer::singleShot(0, mainWindow, SLOT(fillButtons()));
-    QTimer::singleShot(0, mainWindow, SLOT(alterConfigFromSettings()));
-    QTimer::singleShot(0, mainWindow, SLOT(changeWindowStatus()));
+        QObject::connect(mainWindow, &MainWindow::joystickRefreshRequested, joypad_worker.data(), &InputDaemon::refresh);
+        QObject::connect(joypad_worker.data(), &InputDaemon::joystickRefreshed, mainWindow, &MainWindow::fillButtonsID);
+        QObject::connect(joypad_worker.data(), &InputDaemon::joysticksRefreshed, mainWindow, &MainWindow::fillButtonsMap);
 
-    mainAppHelper.changeMouseThread(inputEventThread);
+        QObject::connect(&antimicrox, &QApplication::aboutToQuit, localServer, &LocalAntiMicroServer::close);
+        QObject::connect(&antimicrox, &QApplication::aboutToQuit, mainWindow, &MainWindow::saveAppConfig);
+        QObject::connect(&antimicrox, &QApplication::aboutToQuit, mainWindow, &MainWindow::removeJoyTabs);
+        QObject::connect(&antimicrox, &QApplication::aboutToQuit, &mainAppHelper, &AppLaunchHelper::revertMouseThread);
+        QObject::connect(&antimicrox, &QApplication::aboutToQuit, joypad_worker.data(), &InputDaemon::quit);
+        QObject::connect(&antimicrox, &QApplication::aboutToQuit, joypad_worker.data(), &InputDaemon::deleteLater);
+
+        QObject::connect(localServer, &LocalAntiMicroServer::showHiddenWindow, mainWindow, &MainWindow::show);
+        QObject::connect(localServer, &LocalAntiMicroServer::clientdisconnect, mainWindow,
+                         &MainWindow::handleInstanceDisconnect);
+        QObject::connect(localServer, &LocalAntiMicroServer::loadProfileRequested, mainWindow,
+                         &MainWindow::loadDeviceConfigFile);
+        QObject::connect(localServer, &LocalAntiMicroServer::unloadProfileRequested, mainWindow,
+                         &MainWindow::unloadDeviceConfig);
+        QObject::connect(mainWindow, &MainWindow::mappingUpdated, joypad_worker.data(), &InputDaemon::refreshMapping);
+        QObject::connect(joypad_worker.data(), &InputDaemon::deviceUpdated, mainWindow, &MainWindow::testMappingUpdateNow);
+
+        QObject::connect(joypad_worker.data(), &InputDaemon::deviceRemoved, mainWindow, &MainWindow::removeJoyTab);
+        QObject::connect(joypad_worker.data(), &InputDaemon::deviceAdded, mainWindow, &MainWindow::addJoyTab);
+
+        QTimer::singleShot(0, mainWindow, SLOT(fillButtons()));
+        QTimer::singleShot(0, []() { StartupTrace::mark("device tabs filled"); });
+        QTimer::singleShot(0, mainWindow, SLOT(alterConfigFromSettings()));
+        QTimer::singleShot(0, mainWindow, SLOT(changeWindowStatus()));
+        QTimer::singleShot(0, []() {
+            StartupTrace::mark("main window ready");
+            StartupTrace::dump();
+        });
+    }
 
-    joypad_worker->startWorker();
+    if (!cmdutility.getInputReplayFile().isEmpty())
+    {
+        InputTraceReplayer *traceReplayer = new InputTraceReplayer(joypad_worker.data(), joysticks, &antimicrox);
 
-    joypad_worker->moveToThread(inputEventThread);
-    PadderCommon::mouseHelperObj.moveToThread(inputEventThread);
-    inputEventThread->start(QThread::HighPriority);
+        if (traceReplayer->open(cmdutility.getInputReplayFile()))
+        {
+            traceReplayer->setSpeed(cmdutility.getReplaySpeed());
+            QObject::connect(&antimicrox, &QApplication::aboutToQuit, traceReplayer, &InputTraceReplayer::stop);
+
+            // Start after profiles queued above are applied
+            QTimer::singleShot(0, traceReplayer, &InputTraceReplayer::start);
+        }
+    }
 
     int app_result = antimicrox.exec();
 
@@ -638,6 +761,9 @@ int main(int argc, char *argv[])
     delete mainWindow;
     mainWindow = nullptr;
 
+    delete headlessDaemon;
+    headlessDaemon = nullptr;
+
     delete appLogger;
     return app_result;
 }
@@ -18,7 +18,16 @@
 
 #include "mousehelper.h"
 
+#include <QCursor>
 #include <QDebug>
+#include <QGuiApplication>
+#include <QMutexLocker>
+#include <QScreen>
+#include <QThread>
+
+#if defined(WITH_X11)
+    #include "x11extras.h"
+#endif
 
 MouseHelper::MouseHelper(QObject *parent)
     : QObject(parent)
@@ -28,9 +37,169 @@ MouseHelper::MouseHelper(QObject *parent)
     previousCursorLocation[1] = 0;
     pivotPoint[0] = -1;
     pivotPoint[1] = -1;
+    screensValid = false;
+    screensTracked = false;
+    cursorValid = false;
     mouseTimer.setParent(this);
     mouseTimer.setSingleShot(true);
     QObject::connect(&mouseTimer, &QTimer::timeout, this, &MouseHelper::resetSpringMouseMoving);
 }
 
 void MouseHelper::resetSpringMouseMoving() { springMouseMoving = false; }
+
+/**
+ * @brief Copy geometry of all screens now and again whenever a screen is
+ *     added, removed or changes geometry. Has to be called from the GUI
+ *     thread, where QScreen objects live. Helper itself is moved to the
+ *     input thread, so updates are connected with the application or the
+ *     screen as context and run in the GUI thread.
+ */
+void MouseHelper::trackScreens()
+{
+    if (screensTracked.exchange(true))
+        return;
+
+    connect(qGuiApp, &QGuiApplication::screenAdded, qGuiApp, [this](QScreen *screen) {
+        watchScreen(screen);
+        updateScreens();
+    });
+    connect(qGuiApp, &QGuiApplication::screenRemoved, qGuiApp, [this]() { updateScreens(); });
+    connect(qGuiApp, &QGuiApplication::primaryScreenChanged, qGuiApp, [this]() { updateScreens(); });
+
+    for (QScreen *screen : QGuiApplication::screens())
+        watchScreen(screen);
+
+    updateScreens();
+}
+
+/**
+ * @brief Start tracking screens when it was not done at startup. The input
+ *     thread queues it to the GUI thread and uses the previous copy until
+ *     then.
+ */
+void MouseHelper::requestScreens()
+{
+    if (qGuiApp == nullptr)
+        return;
+
+    if (QThread::currentThread() == qGuiApp->thread())
+        trackScreens();
+    else if (!screensTracked.load())
+        QMetaObject::invokeMethod(qGuiApp, [this]() { trackScreens(); }, Qt::QueuedConnection);
+}
+
+void MouseHelper::watchScreen(QScreen *screen)
+{
+    connect(screen, &QScreen::geometryChanged, screen, [this]() { updateScreens(); });
+}
+
+void MouseHelper::updateScreens()
+{
+    QList<QRect> geometries;
+    QRect desktop;
+
+    for (QScreen *screen : QGuiApplication::screens())
+    {
+        geometries.append(screen->geometry());
+        desktop = desktop.united(screen->geometry());
+    }
+
+    QScreen *primary = QGuiApplication::primaryScreen();
+
+    QMutexLocker locker(&screenMutex);
+    screenGeometries = geometries;
+    primaryGeometry = (primary != nullptr) ? primary->geometry() : QRect();
+    desktopGeometry = desktop;
+    screensValid.store(true);
+}
+
+int MouseHelper::getScreenCount()
+{
+    if (!screensValid.load())
+        requestScreens();
+
+    QMutexLocker locker(&screenMutex);
+    return screenGeometries.count();
+}
+
+/**
+ * @brief Cached geometry of screen. -1 or an invalid index returns
+ *     geometry of primary screen.
+ */
+QRect MouseHelper::getScreenGeometry(int screen)
+{
+    if (!screensValid.load())
+        requestScreens();
+
+    QMutexLocker locker(&screenMutex);
+
+    if ((screen < 0) || (screen >= screenGeometries.count()))
+        return primaryGeometry;
+
+    return screenGeometries.at(screen);
+}
+
+/**
+ * @brief Cursor position tracked from events sent by the program. The
+ *     real position is queried only when tracking is not established or
+ *     CURSOR_RESYNC_INTERVAL has passed since the last query.
+ */
+QPoint MouseHelper::getCursorPos()
+{
+    if (cursorValid && !cursorSyncTimer.hasExpired(CURSOR_RESYNC_INTERVAL))
+        return cursorPos;
+
+    if (QGuiApplication::platformName() == QStringLiteral("xcb"))
+    {
+#if defined(WITH_X11)
+        cursorPos = X11Extras::getInstance()->getPos();
+#else
+        qCritical() << "Platform name returned 'xcb', but X11 support is disabled";
+#endif
+    } else
+    {
+        cursorPos = QCursor::pos();
+    }
+
+    cursorValid = true;
+    cursorSyncTimer.start();
+    return cursorPos;
+}
+
+void MouseHelper::setCursorPos(int x, int y)
+{
+    if (!cursorValid)
+        return;
+
+    cursorPos.setX(x);
+    cursorPos.setY(y);
+    clampCursorPos();
+}
+
+void MouseHelper::moveCursorPos(int xDis, int yDis)
+{
+    if (!cursorValid)
+        return;
+
+    cursorPos += QPoint(xDis, yDis);
+    clampCursorPos();
+}
+
+/**
+ * @brief Keep tracked position on the desktop like the windowing system
+ *     keeps the real cursor, so movement pushing against an edge does
+ *     not move tracked position away from it.
+ */
+void MouseHelper::clampCursorPos()
+{
+    if (!screensValid.load())
+        requestScreens();
+
+    QMutexLocker locker(&screenMutex);
+
+    if (desktopGeometry.isValid())
+    {
+        cursorPos.setX(qBound(desktopGeometry.left(), cursorPos.x(), desktopGeometry.right()));
+        cursorPos.setY(qBound(desktopGeometry.top(), cursorPos.y(), desktopGeometry.bottom()));
+    }
+}
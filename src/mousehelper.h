@@ -19,15 +19,32 @@
 #ifndef MOUSEHELPER_H
 #define MOUSEHELPER_H
 
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
 #include <QObject>
+#include <QPoint>
+#include <QRect>
 #include <QTimer>
 
+#include <atomic>
+
+class QScreen;
+
 class MouseHelper : public QObject
 {
     Q_OBJECT
 
   public:
     explicit MouseHelper(QObject *parent = nullptr);
+
+    void trackScreens();
+    int getScreenCount();
+    QRect getScreenGeometry(int screen);
+    QPoint getCursorPos();
+    void setCursorPos(int x, int y);
+    void moveCursorPos(int xDis, int yDis);
+
     bool springMouseMoving;
     int previousCursorLocation[2];
     int pivotPoint[2];
@@ -35,6 +52,28 @@ class MouseHelper : public QObject
 
   private slots:
     void resetSpringMouseMoving();
+
+  private:
+    void requestScreens();
+    void watchScreen(QScreen *screen);
+    void updateScreens();
+    void clampCursorPos();
+
+    // Interval in ms after which tracked cursor position is read back
+    // from the windowing system. Catches moves not made by us.
+    static const int CURSOR_RESYNC_INTERVAL = 250;
+
+    // Screen geometry is copied in the GUI thread and read in the input thread
+    QMutex screenMutex;
+    std::atomic<bool> screensValid;
+    std::atomic<bool> screensTracked;
+    QList<QRect> screenGeometries;
+    QRect primaryGeometry;
+    QRect desktopGeometry;
+
+    bool cursorValid;
+    QPoint cursorPos;
+    QElapsedTimer cursorSyncTimer;
 };
 
 #endif // MOUSEHELPER_H
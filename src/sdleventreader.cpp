@@ -20,6 +20,7 @@
 
 #include "antimicrosettings.h"
 #include "common.h"
+#include "gamecontroller/gamecontrollermappingstore.h"
 #include "globalvariables.h"
 #include "inputdevice.h"
 //#include "logger.h"
@@ -31,8 +32,15 @@
 #include <QSettings>
 #include <QVariant>
 
+// Time without events and active inputs before adaptive polling backs off
+static const qint64 ADAPTIVE_IDLE_DELAY = 1000;
+// Longest interval adaptive polling backs off to
+static const int ADAPTIVE_MAX_POLL_INTERVAL = 64;
+
 SDLEventReader::SDLEventReader(QMap<SDL_JoystickID, InputDevice *> *joysticks, AntiMicroSettings *settings, QObject *parent)
     : QObject(parent)
+    , adaptivePolling(false)
+    , inputsActive(false)
 {
     this->joysticks = joysticks;
     this->settings = settings;
@@ -73,27 +81,10 @@ void SDLEventReader::initSDL()
 
     sdlIsOpen = true;
     loadSdlMappingsFromDatabase();
-    settings->getLock()->lock();
-    settings->beginGroup("Mappings");
-    QStringList mappings = settings->allKeys();
-
-    for (auto &&tempstring : mappings)
-    {
-        QString mappingSetting = settings->value(tempstring, QString()).toString();
-
-        if (!mappingSetting.isEmpty())
-        {
-            QByteArray temparray = mappingSetting.toUtf8();
-            char *mapping = temparray.data();
-            SDL_GameControllerAddMapping(mapping); // Let SDL take care of validation
-        }
-    }
-
-    settings->endGroup();
-    settings->getLock()->unlock();
 
     pollRateTimer.stop();
     pollRateTimer.setInterval(pollRate);
+    idleTime.start();
 
     emit sdlStarted();
 }
@@ -184,12 +175,16 @@ int SDLEventReader::eventStatus()
         break;
     }
     case 0: {
-        if (!pollRateTimer.isActive())
-            pollRateTimer.start();
+        int interval = adaptivePolling ? nextPollInterval() : pollRate;
+
+        if (!pollRateTimer.isActive() || (pollRateTimer.interval() != interval))
+            pollRateTimer.start(interval);
 
         break;
     }
     default: {
+        idleTime.restart();
+        pollRateTimer.setInterval(pollRate);
         result = 1;
         break;
     }
@@ -250,27 +245,51 @@ void SDLEventReader::haltServices()
 }
 
 /**
- * @brief Loading additional gamepad mappings from database
- *
+ * @brief Index additional gamepad mappings from database and settings.
+ *  Only mappings of present devices are passed to SDL, others are
+ *  registered when their device is plugged in.
  */
 void SDLEventReader::loadSdlMappingsFromDatabase()
 {
     QString database_file;
     database_file = QApplication::applicationDirPath().append("/../share/antimicrox/gamecontrollerdb.txt");
-    if (QFile::exists(database_file))
-    {
-        int result = SDL_GameControllerAddMappingsFromFile(database_file.toStdString().c_str());
-        if (result == -1)
-            qWarning() << "Loading game controller mappings from database: " << database_file << " failed";
-        else
-            DEBUG() << "Loaded " << result << " game controller mappings from database";
-    }
 #ifndef QT_DEBUG
-    else
+    if (!QFile::exists(database_file))
     {
         qWarning() << "File with game controller mappings " << database_file << " does not exist";
     }
 #endif
+
+    GameControllerMappingStore::load(database_file, settings);
+    GameControllerMappingStore::registerPresentDevices();
+}
+
+/**
+ * @brief Poll at the configured rate only while inputs are in use and back
+ *     off exponentially up to ADAPTIVE_MAX_POLL_INTERVAL once all devices
+ *     have been idle for a while. The first event found restores the
+ *     configured rate.
+ */
+void SDLEventReader::setAdaptivePolling(bool enabled) { adaptivePolling = enabled; }
+
+bool SDLEventReader::isAdaptivePolling() const { return adaptivePolling; }
+
+/**
+ * @brief Tell adaptive polling whether inputs are held or mouse output is
+ *     running, which keeps polling at the configured rate. Can be called
+ *     from any thread.
+ */
+void SDLEventReader::setInputsActive(bool active) { inputsActive.store(active, std::memory_order_relaxed); }
+
+int SDLEventReader::nextPollInterval()
+{
+    if (inputsActive.load(std::memory_order_relaxed))
+        idleTime.restart();
+
+    if (!idleTime.hasExpired(ADAPTIVE_IDLE_DELAY))
+        return pollRate;
+
+    return qMin(qMax(pollRateTimer.interval(), pollRate) * 2, qMax(ADAPTIVE_MAX_POLL_INTERVAL, pollRate));
 }
 
 QMap<SDL_JoystickID, InputDevice *> *SDLEventReader::getJoysticks() const { return joysticks; }
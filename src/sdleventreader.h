@@ -21,6 +21,10 @@
 
 #include "joystick.h"
 
+#include <QElapsedTimer>
+
+#include <atomic>
+
 class InputDevice;
 class AntiMicroSettings;
 
@@ -39,6 +43,10 @@ class SDLEventReader : public QObject
     AntiMicroSettings *getSettings() const;
     QTimer const &getPollRateTimer();
 
+    void setAdaptivePolling(bool enabled);
+    bool isAdaptivePolling() const;
+    void setInputsActive(bool active);
+
   protected:
     void initSDL();
     void closeSDL();
@@ -70,8 +78,12 @@ class SDLEventReader : public QObject
     AntiMicroSettings *settings;
     int pollRate;
     QTimer pollRateTimer;
+    bool adaptivePolling;
+    std::atomic<bool> inputsActive;
+    QElapsedTimer idleTime;
 
     void loadSdlMappingsFromDatabase();
+    int nextPollInterval();
 };
 
 #endif // SDLEVENTREADER_H
@@ -54,21 +54,37 @@ SetJoystick::SetJoystick(InputDevice *device, int index, bool runreset, QObject
 
 SetJoystick::~SetJoystick() { removeAllBtnFromQueue(); }
 
-JoyButton *SetJoystick::getJoyButton(int index) const { return getButtons().value(index); }
+template <typename T> static inline T *denseElement(const QVector<T *> &dense, int index)
+{
+    return ((index >= 0) && (index < dense.size())) ? dense.at(index) : nullptr;
+}
+
+template <typename T> static void setDenseElement(QVector<T *> &dense, int index, T *element)
+{
+    if (index < 0)
+        return;
+
+    if (index >= dense.size())
+        dense.resize(index + 1);
+
+    dense[index] = element;
+}
+
+JoyButton *SetJoystick::getJoyButton(int index) const { return denseElement(buttonArray, index); }
 
 JoyAxis *SetJoystick::getJoyAxis(int index) const
 {
     Q_ASSERT(!axes.isEmpty());
-    return axes.value(index);
+    return denseElement(axisArray, index);
 }
 
-JoyDPad *SetJoystick::getJoyDPad(int index) const { return getHats().value(index); }
+JoyDPad *SetJoystick::getJoyDPad(int index) const { return denseElement(hatArray, index); }
 
-VDPad *SetJoystick::getVDPad(int index) const { return getVdpads().value(index); }
+VDPad *SetJoystick::getVDPad(int index) const { return denseElement(vdpadArray, index); }
 
-JoyControlStick *SetJoystick::getJoyStick(int index) const { return getSticks().value(index); }
+JoyControlStick *SetJoystick::getJoyStick(int index) const { return denseElement(stickArray, index); }
 
-JoySensor *SetJoystick::getSensor(JoySensorType type) const { return m_sensors.value(type); }
+JoySensor *SetJoystick::getSensor(JoySensorType type) const { return denseElement(sensorArray, static_cast<int>(type)); }
 
 void SetJoystick::refreshButtons()
 {
@@ -78,6 +94,7 @@ void SetJoystick::refreshButtons()
     {
         JoyButton *button = new JoyButton(i, m_index, this, this);
         m_buttons.insert(i, button);
+        setDenseElement(buttonArray, i, button);
         enableButtonConnections(button);
     }
 }
@@ -90,7 +107,7 @@ void SetJoystick::refreshAxes()
     for (int i = 0; i < device->getNumberRawAxes(); i++)
     {
         JoyAxis *axis = new JoyAxis(i, m_index, this, this);
-        axes.insert(i, axis);
+        insertAxis(i, axis);
 
         if (device->hasCalibrationThrottle(i))
         {
@@ -110,6 +127,7 @@ void SetJoystick::refreshHats()
     {
         JoyDPad *dpad = new JoyDPad(i, m_index, this, this);
         hats.insert(i, dpad);
+        setDenseElement(hatArray, i, dpad);
         enableHatConnections(dpad);
     }
 }
@@ -130,6 +148,7 @@ void SetJoystick::refreshSensors()
 
         JoySensor *sensor = JoySensorFactory::build(type, getInputDevice()->getRawSensorRate(type), m_index, this, this);
         m_sensors.insert(type, sensor);
+        setDenseElement(sensorArray, static_cast<int>(type), sensor);
         enableSensorConnections(sensor);
     }
 }
@@ -150,6 +169,8 @@ void SetJoystick::deleteButtons()
     }
 
     m_buttons.clear();
+    buttonArray.clear();
+    dirtyButtons.clear();
 }
 
 void SetJoystick::deleteAxes()
@@ -168,6 +189,8 @@ void SetJoystick::deleteAxes()
     }
 
     axes.clear();
+    axisArray.clear();
+    dirtyAxes.clear();
 }
 
 void SetJoystick::deleteSticks()
@@ -186,6 +209,8 @@ void SetJoystick::deleteSticks()
     }
 
     sticks.clear();
+    stickArray.clear();
+    dirtySticks.clear();
 }
 
 void SetJoystick::deleteVDpads()
@@ -204,6 +229,8 @@ void SetJoystick::deleteVDpads()
     }
 
     vdpads.clear();
+    vdpadArray.clear();
+    dirtyVDPads.clear();
 }
 
 void SetJoystick::deleteHats()
@@ -222,6 +249,8 @@ void SetJoystick::deleteHats()
     }
 
     hats.clear();
+    hatArray.clear();
+    dirtyDPads.clear();
 }
 
 /**
@@ -236,6 +265,8 @@ void SetJoystick::deleteSensors()
     }
 
     m_sensors.clear();
+    sensorArray.clear();
+    dirtySensors.clear();
 }
 
 int SetJoystick::getNumberButtons() const { return getButtons().count(); }
@@ -436,6 +467,7 @@ void SetJoystick::propogateSetAxisThrottleSetting(int index)
 void SetJoystick::addControlStick(int index, JoyControlStick *stick)
 {
     sticks.insert(index, stick);
+    setDenseElement(stickArray, index, stick);
     connect(stick, &JoyControlStick::stickNameChanged, this, &SetJoystick::propogateSetStickNameChange);
 
     QHashIterator<JoyStickDirectionsType::JoyStickDirections, JoyControlStickButton *> iter(*stick->getButtons());
@@ -465,6 +497,8 @@ void SetJoystick::removeControlStick(int index)
     {
         JoyControlStick *stick = getSticks().value(index);
         sticks.remove(index);
+        setDenseElement(stickArray, index, static_cast<JoyControlStick *>(nullptr));
+        dirtySticks.removeAll(stick);
         stick->deleteLater();
         stick = nullptr;
     }
@@ -473,6 +507,7 @@ void SetJoystick::removeControlStick(int index)
 void SetJoystick::addVDPad(int index, VDPad *vdpad)
 {
     vdpads.insert(index, vdpad);
+    setDenseElement(vdpadArray, index, vdpad);
     connect(vdpad, &VDPad::dpadNameChanged, this, &SetJoystick::propogateSetVDPadNameChange);
 
     QHashIterator<int, JoyDPadButton *> iter(*vdpad->getButtons());
@@ -499,6 +534,8 @@ void SetJoystick::removeVDPad(int index)
     {
         VDPad *vdpad = vdpads.value(index);
         vdpads.remove(index);
+        setDenseElement(vdpadArray, index, static_cast<VDPad *>(nullptr));
+        dirtyVDPads.removeAll(vdpad);
         vdpad->deleteLater();
         vdpad = nullptr;
     }
@@ -506,6 +543,36 @@ void SetJoystick::removeVDPad(int index)
 
 int SetJoystick::getIndex() const { return m_index; }
 
+void SetJoystick::insertAxis(int index, JoyAxis *axis)
+{
+    axes.insert(index, axis);
+    setDenseElement(axisArray, index, axis);
+}
+
+void SetJoystick::queueDirtyButton(JoyButton *button) { dirtyButtons.append(button); }
+
+void SetJoystick::queueDirtyAxis(JoyAxis *axis) { dirtyAxes.append(axis); }
+
+void SetJoystick::queueDirtyDPad(JoyDPad *dpad) { dirtyDPads.append(dpad); }
+
+void SetJoystick::queueDirtyStick(JoyControlStick *stick) { dirtySticks.append(stick); }
+
+void SetJoystick::queueDirtySensor(JoySensor *sensor) { dirtySensors.append(sensor); }
+
+void SetJoystick::queueDirtyVDPad(VDPad *vdpad) { dirtyVDPads.append(vdpad); }
+
+QVector<JoyButton *> &SetJoystick::getDirtyButtons() { return dirtyButtons; }
+
+QVector<JoyAxis *> &SetJoystick::getDirtyAxes() { return dirtyAxes; }
+
+QVector<JoyDPad *> &SetJoystick::getDirtyDPads() { return dirtyDPads; }
+
+QVector<JoyControlStick *> &SetJoystick::getDirtySticks() { return dirtySticks; }
+
+QVector<JoySensor *> &SetJoystick::getDirtySensors() { return dirtySensors; }
+
+QVector<VDPad *> &SetJoystick::getDirtyVDPads() { return dirtyVDPads; }
+
 int SetJoystick::getRealIndex() const { return m_index + 1; }
 
 void SetJoystick::propogateSetButtonClick(int button)
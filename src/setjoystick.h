@@ -24,6 +24,8 @@
 #include "joysensortype.h"
 #include "xml/setjoystickxml.h"
 
+#include <QVector>
+
 class InputDevice;
 class JoyButton;
 class JoyDPad;
@@ -94,7 +96,25 @@ class SetJoystick : public SetJoystickXml
     int getCountBtnInList(QString partialName);
     bool isSetEmpty();
 
+    /**
+     * @brief Elements add themselves when their first event is queued, so
+     *     InputDevice activates only elements with pending events.
+     */
+    void queueDirtyButton(JoyButton *button);
+    void queueDirtyAxis(JoyAxis *axis);
+    void queueDirtyDPad(JoyDPad *dpad);
+    void queueDirtyStick(JoyControlStick *stick);
+    void queueDirtySensor(JoySensor *sensor);
+    void queueDirtyVDPad(VDPad *vdpad);
+    QVector<JoyButton *> &getDirtyButtons();
+    QVector<JoyAxis *> &getDirtyAxes();
+    QVector<JoyDPad *> &getDirtyDPads();
+    QVector<JoyControlStick *> &getDirtySticks();
+    QVector<JoySensor *> &getDirtySensors();
+    QVector<VDPad *> &getDirtyVDPads();
+
   protected:
+    void insertAxis(int index, JoyAxis *axis); // SetAxis class
     void deleteButtons(); // SetButton class
     void deleteAxes();    // SetAxis class
     void deleteHats();    // SetHat class
@@ -194,8 +214,24 @@ class SetJoystick : public SetJoystickXml
     QHash<JoySensorType, JoySensor *> m_sensors;
     QHash<int, VDPad *> vdpads;
 
+    // Index addressed views of the hashes above. Used for lookups on
+    // the event path, hashes are kept for iteration by the GUI.
+    QVector<JoyButton *> buttonArray;
+    QVector<JoyAxis *> axisArray;
+    QVector<JoyDPad *> hatArray;
+    QVector<JoyControlStick *> stickArray;
+    QVector<JoySensor *> sensorArray;
+    QVector<VDPad *> vdpadArray;
+
     QList<JoyButton *> lastClickedButtons;
 
+    QVector<JoyButton *> dirtyButtons;
+    QVector<JoyAxis *> dirtyAxes;
+    QVector<JoyDPad *> dirtyDPads;
+    QVector<JoyControlStick *> dirtySticks;
+    QVector<JoySensor *> dirtySensors;
+    QVector<VDPad *> dirtyVDPads;
+
     int m_index;
     InputDevice *m_device;
     QString m_name;
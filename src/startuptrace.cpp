@@ -0,0 +1,90 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "startuptrace.h"
+
+#include "logger.h"
+
+#include <QMutexLocker>
+
+QMutex StartupTrace::mutex;
+QElapsedTimer StartupTrace::timer;
+QVector<StartupTrace::Phase> StartupTrace::phases;
+bool StartupTrace::enabled = false;
+bool StartupTrace::dumped = false;
+
+/**
+ * @brief Start the clock. Should be the first call in main().
+ */
+void StartupTrace::start()
+{
+    QMutexLocker locker(&mutex);
+
+    timer.start();
+    phases.clear();
+    dumped = false;
+}
+
+void StartupTrace::mark(const QString &phase)
+{
+    QMutexLocker locker(&mutex);
+
+    if (!timer.isValid())
+        return;
+
+    qint64 previousNsecs = phases.isEmpty() ? 0 : phases.last().nsecs;
+    phases.append({phase, timer.nsecsElapsed()});
+
+    if (enabled && dumped)
+        print(phases.last(), previousNsecs);
+}
+
+/**
+ * @brief Print phases recorded so far.
+ */
+void StartupTrace::dump()
+{
+    QMutexLocker locker(&mutex);
+
+    if (!enabled || dumped)
+        return;
+
+    qint64 previousNsecs = 0;
+
+    for (const Phase &phase : phases)
+    {
+        print(phase, previousNsecs);
+        previousNsecs = phase.nsecs;
+    }
+
+    dumped = true;
+}
+
+void StartupTrace::setEnabled(bool enabled)
+{
+    QMutexLocker locker(&mutex);
+
+    StartupTrace::enabled = enabled;
+}
+
+void StartupTrace::print(const Phase &phase, qint64 previousNsecs)
+{
+    PRINT_STDOUT() << QString("[startup] %1 ms (+%2 ms) %3\n")
+                          .arg(phase.nsecs / 1000000.0, 0, 'f', 2)
+                          .arg((phase.nsecs - previousNsecs) / 1000000.0, 0, 'f', 2)
+                          .arg(phase.name);
+}
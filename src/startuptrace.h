@@ -0,0 +1,56 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief Records named startup phases with monotonic timestamps. Phases
+ *     are always recorded, they are printed only when trace was enabled
+ *     with --startup-trace. Phases marked after dump() are printed as
+ *     they happen. Can be used from any thread.
+ */
+class StartupTrace
+{
+  public:
+    static void start();
+    static void mark(const QString &phase);
+    static void dump();
+    static void setEnabled(bool enabled);
+
+  private:
+    struct Phase
+    {
+        QString name;
+        qint64 nsecs;
+    };
+
+    static void print(const Phase &phase, qint64 previousNsecs);
+
+    static QMutex mutex;
+    static QElapsedTimer timer;
+    static QVector<Phase> phases;
+    static bool enabled;
+    static bool dumped;
+};
+
+#endif // STARTUPTRACE_H
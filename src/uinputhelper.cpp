@@ -28,7 +28,7 @@ UInputHelper::UInputHelper(QObject *parent)
     : QObject(parent)
 {
     populateKnownAliases();
-    connect(qApp, &QApplication::aboutToQuit, this, &UInputHelper::deleteLater);
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &UInputHelper::deleteLater);
 }
 
 UInputHelper::~UInputHelper() { _instance = nullptr; }
@@ -19,6 +19,7 @@
 #include "vdpad.h"
 
 #include "globalvariables.h"
+#include "setjoystick.h"
 
 #include <QDebug>
 
@@ -265,6 +266,9 @@ void VDPad::queueJoyEvent(bool ignoresets)
 {
     Q_UNUSED(ignoresets)
 
+    if (!pendingVDPadEvent && (getParentSet() != nullptr))
+        getParentSet()->queueDirtyVDPad(this);
+
     pendingVDPadEvent = true;
 }
 
@@ -0,0 +1,65 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "virtualjoystick.h"
+
+#include "globalvariables.h"
+#include "logger.h"
+#include "setjoystick.h"
+
+VirtualJoystick::VirtualJoystick(SDL_JoystickID instanceID, int deviceIndex, const QString &name, const QString &guid,
+                                 const QString &uniqueID, int buttons, int axes, int hats, AntiMicroSettings *settings,
+                                 QObject *parent)
+    : Joystick(instanceID, deviceIndex, settings, parent)
+    , m_name(name)
+    , m_guid(guid)
+    , m_uniqueID(uniqueID)
+    , m_buttons(qMax(0, buttons))
+    , m_axes(qMax(0, axes))
+    , m_hats(qMax(0, hats))
+{
+    for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
+    {
+        SetJoystick *setstick = new SetJoystick(this, i, this);
+        getJoystick_sets().insert(i, setstick);
+        enableSetConnections(setstick);
+    }
+
+    INFO() << "Created new virtual Joystick:\n" << getDescription();
+}
+
+QString VirtualJoystick::getSDLName() { return m_name; }
+
+QString VirtualJoystick::getGUIDString() const { return m_guid; }
+
+QString VirtualJoystick::getUniqueIDString() const { return m_uniqueID; }
+
+QString VirtualJoystick::getVendorString() const { return QString(); }
+
+QString VirtualJoystick::getProductIDString() const { return QString(); }
+
+QString VirtualJoystick::getSerialString() const { return QString(); }
+
+QString VirtualJoystick::getProductVersion() const { return QString(); }
+
+void VirtualJoystick::closeSDLDevice() {}
+
+int VirtualJoystick::getNumberRawButtons() { return m_buttons; }
+
+int VirtualJoystick::getNumberRawAxes() { return m_axes; }
+
+int VirtualJoystick::getNumberRawHats() { return m_hats; }
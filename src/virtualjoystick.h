@@ -0,0 +1,61 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VIRTUALJOYSTICK_H
+#define VIRTUALJOYSTICK_H
+
+#include "joystick.h"
+
+/**
+ * @brief Joystick without SDL device behind it. Its events are pushed
+ *     into the SDL event queue with its instance id, so it goes through
+ *     the same processing as hardware. Used to replay input traces when
+ *     the recorded device is not connected.
+ */
+class VirtualJoystick : public Joystick
+{
+    Q_OBJECT
+
+  public:
+    explicit VirtualJoystick(SDL_JoystickID instanceID, int deviceIndex, const QString &name, const QString &guid,
+                             const QString &uniqueID, int buttons, int axes, int hats, AntiMicroSettings *settings,
+                             QObject *parent);
+
+    virtual QString getSDLName() override;
+    virtual QString getGUIDString() const override;
+    virtual QString getUniqueIDString() const override;
+    virtual QString getVendorString() const override;
+    virtual QString getProductIDString() const override;
+    virtual QString getSerialString() const override;
+    virtual QString getProductVersion() const override;
+
+    virtual void closeSDLDevice() override;
+
+    virtual int getNumberRawButtons() override;
+    virtual int getNumberRawAxes() override;
+    virtual int getNumberRawHats() override;
+
+  private:
+    QString m_name;
+    QString m_guid;
+    QString m_uniqueID;
+    int m_buttons;
+    int m_axes;
+    int m_hats;
+};
+
+#endif // VIRTUALJOYSTICK_H
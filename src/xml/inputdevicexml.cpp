@@ -357,6 +357,18 @@ void InputDeviceXml::readConfig(QXmlStreamReader *xml)
                 {
                     m_inputDevice->setDeviceKeyPressTime(tempchoice);
                 }
+            } else if ((xml->name().toString() == "keyRepeat") && xml->isStartElement())
+            {
+                // Ignored by event handlers of hosts that repeat held keys themselves
+                m_inputDevice->setKeyRepeatStatus(true);
+
+                if (xml->attributes().hasAttribute("delay"))
+                    m_inputDevice->setKeyRepeatDelay(xml->attributes().value("delay").toString().toInt());
+
+                if (xml->attributes().hasAttribute("rate"))
+                    m_inputDevice->setKeyRepeatRate(xml->attributes().value("rate").toString().toInt());
+
+                xml->skipCurrentElement();
             } else if ((xml->name().toString() == "profilename") && xml->isStartElement())
             {
                 m_inputDevice->setProfileName(xml->readElementText());
@@ -712,6 +724,14 @@ void InputDeviceXml::writeConfig(QXmlStreamWriter *xml)
         (m_inputDevice->getDeviceKeyPressTime() != GlobalVariables::InputDevice::DEFAULTKEYPRESSTIME))
         xml->writeTextElement("keyPressTime", QString::number(m_inputDevice->getDeviceKeyPressTime()));
 
+    if (m_inputDevice->isKeyRepeatEnabled())
+    {
+        xml->writeStartElement("keyRepeat");
+        xml->writeAttribute("delay", QString::number(m_inputDevice->getKeyRepeatDelay()));
+        xml->writeAttribute("rate", QString::number(m_inputDevice->getKeyRepeatRate()));
+        xml->writeEndElement();
+    }
+
     m_inputDevice->getCalibrationBackend()->writeConfig(xml);
 
     xml->writeStartElement("sets");
@@ -17,6 +17,7 @@
 
 #include "joybuttonslotxml.h"
 #include "antkeymapper.h"
+#include "eventhandlers/outputsink.h"
 #include "globalvariables.h"
 #include "joybuttonslot.h"
 
@@ -227,6 +228,9 @@ void JoyButtonSlotXml::readEachSlot(QXmlStreamReader *xml, JoyButtonSlot *joyBtn
             } else if (temptext == "mix")
             {
                 joyBtnSlot->setSlotMode(JoyButtonSlot::JoyMix);
+            } else if (temptext == "gamepadbutton")
+            {
+                joyBtnSlot->setSlotMode(JoyButtonSlot::JoyGamepadButton);
             }
         } else
         {
@@ -288,6 +292,10 @@ void JoyButtonSlotXml::setSlotData(JoyButtonSlot *joyBtnSlot, QString profile, Q
                 joyBtnSlot->setExtraData(QVariant(extraStringData));
         }
     }
+
+    // Prepare native key codes now, so they are not looked up when slot is activated.
+    if (OutputSink::handler() != nullptr)
+        OutputSink::handler()->resolveSlot(joyBtnSlot);
 }
 
 void JoyButtonSlotXml::writeConfig(QXmlStreamWriter *xml)
@@ -455,6 +463,10 @@ void JoyButtonSlotXml::writeEachSlot(QXmlStreamWriter *xml, JoyButtonSlot *joyBt
     case JoyButtonSlot::JoyMix:
         xml->writeCharacters("mix");
         break;
+
+    case JoyButtonSlot::JoyGamepadButton:
+        xml->writeCharacters("gamepadbutton");
+        break;
     }
 
     xml->writeEndElement();
@@ -0,0 +1,202 @@
+/* antimicrox Gamepad to KB+M event mapper
+ * Copyright (C) 2026 AntiMicroX contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "antimicrosettings.h"
+#include "engineclock.h"
+#include "eventhandlerfactory.h"
+#include "eventhandlers/recordeventhandler.h"
+#include "joybuttontypes/joybutton.h"
+#include "joybuttonslot.h"
+#include "setjoystick.h"
+#include "virtualjoystick.h"
+
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+/**
+ * @brief Runs button presses through the engine on the virtual
+ *     EngineClock and checks the exact times of recorded output.
+ */
+class TestSlotTiming : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestSlotTiming(QObject *parent = 0);
+
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void keyPressRelease();
+    void holdSlot();
+    void delaySlot();
+    void turbo();
+
+  private:
+    struct Expected
+    {
+        qint64 time;
+        int code;
+        int pressed;
+    };
+
+    void compareEvents(const QVector<Expected> &expected);
+
+    QTemporaryDir settingsDir;
+    AntiMicroSettings *settings;
+    RecordEventHandler *recorder;
+    VirtualJoystick *joystick;
+    JoyButton *button;
+    qint64 start;
+};
+
+static const int KEY_A = 30;
+static const int KEY_B = 48;
+
+TestSlotTiming::TestSlotTiming(QObject *parent)
+    : QObject(parent)
+    , settings(nullptr)
+    , recorder(nullptr)
+    , joystick(nullptr)
+    , button(nullptr)
+    , start(0)
+{
+}
+
+void TestSlotTiming::initTestCase()
+{
+    QVERIFY(settingsDir.isValid());
+    settings = new AntiMicroSettings(settingsDir.filePath("antimicrox_settings.ini"), QSettings::IniFormat, this);
+
+    EventHandlerFactory *factory = EventHandlerFactory::getInstance("record");
+    QVERIFY(factory != nullptr);
+    recorder = qobject_cast<RecordEventHandler *>(factory->handler());
+    QVERIFY(recorder != nullptr);
+    QVERIFY(recorder->init());
+
+    EngineClock::setVirtual(true);
+}
+
+void TestSlotTiming::cleanupTestCase()
+{
+    EngineClock::setVirtual(false);
+    EventHandlerFactory::getInstance()->deleteInstance();
+    recorder = nullptr;
+}
+
+void TestSlotTiming::init()
+{
+    joystick = new VirtualJoystick(0, 0, "Virtual", "00000000000000000000000000000000", "", 1, 0, 0, settings, this);
+    button = joystick->getActiveSetJoystick()->getJoyButton(0);
+    QVERIFY(button != nullptr);
+
+    recorder->takeEvents();
+    start = EngineClock::now();
+}
+
+void TestSlotTiming::cleanup()
+{
+    delete joystick;
+    joystick = nullptr;
+    button = nullptr;
+}
+
+void TestSlotTiming::compareEvents(const QVector<Expected> &expected)
+{
+    QVector<RecordEventHandler::RecordedEvent> events = recorder->takeEvents();
+    QCOMPARE(events.size(), expected.size());
+
+    for (int i = 0; i < events.size(); i++)
+    {
+        const RecordEventHandler::RecordedEvent &event = events.at(i);
+        QCOMPARE(static_cast<int>(event.kind), static_cast<int>(RecordEventHandler::KeyEvent));
+        QCOMPARE(event.time - start, expected.at(i).time);
+        QCOMPARE(event.values[0], expected.at(i).code);
+        QCOMPARE(event.values[2], expected.at(i).pressed);
+    }
+}
+
+void TestSlotTiming::keyPressRelease()
+{
+    QVERIFY(button->setAssignedSlot(KEY_A, Qt::Key_A, JoyButtonSlot::JoyKeyboard));
+
+    button->joyEvent(true);
+    EngineClock::advance(250);
+    button->joyEvent(false);
+    EngineClock::advance(100);
+
+    compareEvents({{0, KEY_A, 1}, {250, KEY_A, 0}});
+}
+
+// Slots after a hold slot replace the ones before it once the button was
+// held longer than the hold time.
+void TestSlotTiming::holdSlot()
+{
+    QVERIFY(button->setAssignedSlot(KEY_A, Qt::Key_A, JoyButtonSlot::JoyKeyboard));
+    QVERIFY(button->setAssignedSlot(500, JoyButtonSlot::JoyHold));
+    QVERIFY(button->setAssignedSlot(KEY_B, Qt::Key_B, JoyButtonSlot::JoyKeyboard));
+
+    button->joyEvent(true);
+    EngineClock::advance(600);
+    button->joyEvent(false);
+    EngineClock::advance(100);
+
+    compareEvents({{0, KEY_A, 1}, {501, KEY_A, 0}, {501, KEY_B, 1}, {600, KEY_B, 0}});
+}
+
+// Slots after a delay slot are pressed in addition to the ones before it.
+void TestSlotTiming::delaySlot()
+{
+    QVERIFY(button->setAssignedSlot(KEY_A, Qt::Key_A, JoyButtonSlot::JoyKeyboard));
+    QVERIFY(button->setAssignedSlot(300, JoyButtonSlot::JoyDelay));
+    QVERIFY(button->setAssignedSlot(KEY_B, Qt::Key_B, JoyButtonSlot::JoyKeyboard));
+
+    button->joyEvent(true);
+    EngineClock::advance(400);
+    button->joyEvent(false);
+    EngineClock::advance(100);
+
+    compareEvents({{0, KEY_A, 1}, {301, KEY_B, 1}, {400, KEY_B, 0}, {400, KEY_A, 0}});
+}
+
+// Turbo toggles the key every half of the turbo interval and releases it
+// together with the button.
+void TestSlotTiming::turbo()
+{
+    QVERIFY(button->setAssignedSlot(KEY_A, Qt::Key_A, JoyButtonSlot::JoyKeyboard));
+    button->setUseTurbo(true);
+    button->setTurboInterval(100);
+    QVERIFY(button->isUsingTurbo());
+
+    button->joyEvent(true);
+    EngineClock::advance(220);
+    button->joyEvent(false);
+    EngineClock::advance(100);
+
+    compareEvents({{0, KEY_A, 1},
+                   {50, KEY_A, 0},
+                   {100, KEY_A, 1},
+                   {150, KEY_A, 0},
+                   {200, KEY_A, 1},
+                   {220, KEY_A, 0}});
+}
+
+QTEST_MAIN(TestSlotTiming)
+#include "testslottiming.moc"